@@ -29,6 +29,13 @@ picoros_publisher_t pub_bs = {
         .type = ROSTYPE_NAME(ros_BatteryState),
         .rihs_hash = ROSTYPE_HASH(ros_BatteryState),
     },
+    // Republish unchanged state only every 5 seconds
+    .on_change = {
+        .enabled = true,
+        .heartbeat_ms = 5000,
+        .skip_offset = PICOROS_STAMP_OFFSET,
+        .skip_len = PICOROS_STAMP_SIZE,
+    },
 };
 
 // Example node
@@ -40,7 +47,12 @@ picoros_node_t node = {
 uint8_t pub_buf[1024];
 
 void publish_batteyState(){
+    z_clock_t clk = z_clock_now();
     ros_BatteryState bat = {
+        .header = {
+            .stamp.nanosec = clk.tv_nsec,
+            .stamp.sec = clk.tv_sec,
+        },
         .present = true,
         .location = "main",
         .serial_number = "ABCD1234",
@@ -53,7 +65,8 @@ void publish_batteyState(){
         .cell_voltage = {.data = (float[]){12.5f, 12.6f}, .n_elements = 2},
         .cell_temperature = {.data = (float[]){31.2f, 32.5f}, .n_elements = 2},
     };
-    printf("Publishing BatteryState...\n");
+    printf("Publishing BatteryState, %lu unchanged samples suppressed\n",
+           (unsigned long)picoros_publisher_suppressed(&pub_bs));
     size_t len = ps_serialize(pub_buf, &bat, 1024);
     if (len > 0){
         picoros_publish(&pub_bs, pub_buf, len);
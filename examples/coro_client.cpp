@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * @file    coro_client.cpp
+ * @brief   Example of C++20 coroutine service calls for picoros
+ * @date    2026-Oct-16
+ *
+ * @details This example declares "add two integers" service server on "services/add2"
+ *          and runs a dozen coroutines calling it concurrently on one picoros::Scheduler.
+ *          Calls are in progress at the same time without extra threads or polling.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#include <cstdio>
+#include <cstdint>
+#include "picoros.hpp"
+
+// Use command line arguments to change default values
+constexpr const char* MODE = "client";
+constexpr const char* LOCATOR = "tcp/192.168.1.16:7447";
+// Number of concurrent calls and their timeout
+constexpr int CALLS = 12;
+constexpr uint32_t TIMEOUT_MS = 2000;
+
+using AddTwoInts = picoros::srv::srv_AddTwoInts;
+
+// Common utils
+extern "C" int picoros_parse_args(int argc, char **argv, picoros_interface_t* ifx);
+
+static picoros::Task add(picoros::ServiceClient<AddTwoInts>& client, int64_t a, int64_t b) {
+    request_srv_AddTwoInts request = {a, b};
+    picoros::Response<reply_srv_AddTwoInts> reply = co_await client.call(request, TIMEOUT_MS);
+    if (!reply) {
+        std::printf("Call %ld + %ld failed: %d\n", (long)a, (long)b, reply.result());
+        co_return;
+    }
+    std::printf("Got reply - %ld + %ld = %ld\n", (long)a, (long)b, (long)reply->sum);
+}
+
+int main(int argc, char **argv) {
+    picoros_interface_t ifx = {
+        .mode = const_cast<char*>(MODE),
+        .locator = const_cast<char*>(LOCATOR),
+    };
+    int ret = picoros_parse_args(argc, argv, &ifx);
+
+    if (ret != 0) {
+        return ret;
+    }
+
+    std::printf("Starting pico-ros interface %s %s\n", ifx.mode, ifx.locator);
+    while (picoros_interface_init(&ifx) == PICOROS_NOT_READY) {
+        std::printf("Waiting RMW init...\n");
+        z_sleep_s(1);
+    }
+
+    picoros::Node node("coro_node");
+    picoros::ServiceServer<AddTwoInts> add2_server(node, "services/add2",
+        [](const request_srv_AddTwoInts& request, reply_srv_AddTwoInts& reply) {
+            reply.sum = request.a + request.b;
+            return true;
+        }, picoros::PoolConfig{CALLS, 0});
+    // one buffer per concurrent call
+    picoros::ServiceClient<AddTwoInts> add2_client("coro_node", "services/add2", nullptr, 0,
+                                                   picoros::PoolConfig{CALLS, 0});
+
+    if (!node || !add2_server || !add2_client) {
+        std::printf("Unable to declare entities\n");
+        return -1;
+    }
+
+    picoros::Scheduler scheduler;
+    while (true) {
+        for (int i = 0; i < CALLS; i++) {
+            scheduler.spawn(add(add2_client, i, 100));
+        }
+        // returns when every call got reply or was dropped
+        scheduler.run();
+        z_sleep_s(1);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * @file    imu_batch_listener.c
+ * @brief   Example batched imu subscriber node for picoros
+ * @date    2025-Oct-16
+ *
+ * @details This example demonstrates a ROS subscriber node that receives
+ *          high-rate imu messages on the "imu" topic in batches and prints
+ *          mean angular velocity of each batch.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "picoros.h"
+#include "picoserdes.h"
+
+// Use command line arguments to change default values
+#define MODE        "client"
+#define LOCATOR     "tcp/192.168.1.16:7447"
+
+// Batch size and maximum batch age
+#define BATCH_SAMPLES   32
+#define BATCH_PERIOD_US 10000
+
+// Common utils
+extern int picoros_parse_args(int argc, char **argv, picoros_interface_t* ifx);
+
+// Subscriber batch callback
+void imu_batch_callback(picoros_sample_t* samples, size_t n_samples);
+
+// Preallocated storage of two batches, one is filled while other is in callback
+picoros_sample_t imu_samples[2 * BATCH_SAMPLES];
+uint8_t imu_buf[2 * BATCH_SAMPLES * 512] __attribute__((aligned(8)));
+
+picoros_sub_batch_t imu_batch = {
+    .samples = imu_samples,
+    .max_samples = BATCH_SAMPLES,
+    .buf = imu_buf,
+    .buf_size = sizeof(imu_buf),
+    .period_us = BATCH_PERIOD_US,
+    .callback = imu_batch_callback,
+};
+
+// Example Subscriber
+picoros_subscriber_t sub_imu = {
+    .topic = {
+        .name = "imu",
+        .type = ROSTYPE_NAME(ros_Imu),
+        .rihs_hash = ROSTYPE_HASH(ros_Imu),
+    },
+    .batch = &imu_batch,
+};
+
+// Example node
+picoros_node_t node = {
+    .name = "picoros",
+};
+
+void imu_batch_callback(picoros_sample_t* samples, size_t n_samples){
+    ros_Vector3 mean = {};
+    size_t n_valid = 0;
+    for (size_t i = 0; i < n_samples; i++){
+        ros_Imu imu = {};
+        if (ps_deserialize(samples[i].data, &imu, samples[i].len)){
+            mean.x += imu.angular_velocity.x;
+            mean.y += imu.angular_velocity.y;
+            mean.z += imu.angular_velocity.z;
+            n_valid++;
+        }
+    }
+    if (n_valid > 0){
+        printf("Imu batch of %zu samples, seq %ld-%ld, mean angular velocity x:%f y:%f z:%f\n",
+            n_valid, (long)samples[0].attachment.sequence_number,
+            (long)samples[n_samples - 1].attachment.sequence_number,
+            mean.x / n_valid, mean.y / n_valid, mean.z / n_valid);
+    }
+}
+
+
+int main(int argc, char **argv){
+    picoros_interface_t ifx = {
+        .mode = MODE,
+        .locator = LOCATOR,
+    };
+    int ret = picoros_parse_args(argc, argv , &ifx);
+
+    if(ret != 0){
+        return ret;
+    }
+
+    printf("Starting pico-ros interface %s %s\n", ifx.mode, ifx.locator );
+    while (picoros_interface_init(&ifx) == PICOROS_NOT_READY){
+        printf("Waiting RMW init...\n");
+        z_sleep_s(1);
+    }
+    printf("Starting Pico-ROS node %s domain:%d\n", node.name, node.domain_id);
+    picoros_node_init(&node);
+
+    printf("Declaring batched subscriber on %s\n", sub_imu.topic.name);
+    picoros_subscriber_declare(&node, &sub_imu);
+
+    while(true){
+#if Z_FEATURE_MULTI_THREAD == 0
+        // deliver partial batches if imu stops publishing, multi thread builds use timer task
+        picoros_subscriber_poll(&sub_imu);
+#endif
+        z_sleep_ms(BATCH_PERIOD_US / 1000);
+    }
+    return 0;
+}
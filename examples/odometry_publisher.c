@@ -4,7 +4,8 @@
  * @date    2025-May-27
  *
  * @details This example demonstrates a ROS publisher node that publishes
- *          simulated odometry messages on the "odom" topic.
+ *          simulated odometry messages on the "odom" topic and a namespaced
+ *          mirror, serializing each message once for both topics.
  *
  * @copyright Copyright (c) 2025 Ubiquity Robotics
  *******************************************************************************/
@@ -30,6 +31,22 @@ picoros_publisher_t pub_odo = {
     },
 };
 
+// Namespaced mirror of odometry
+picoros_publisher_t pub_odo_ns = {
+    .topic = {
+        .name = "mirror/robot/odometry",
+        .type = ROSTYPE_NAME(ros_Odometry),
+        .rihs_hash = ROSTYPE_HASH(ros_Odometry),
+    },
+};
+
+// Both publishers share one serialized message
+picoros_publisher_t* odo_pubs[] = {&pub_odo, &pub_odo_ns};
+picoros_pub_group_t odo_group = {
+    .pubs = odo_pubs,
+    .n_pubs = 2,
+};
+
 // Example node
 picoros_node_t node = {
     .name = "picoros",
@@ -51,7 +68,7 @@ void publish_odometry(){
     printf("Publishing odometery...\n");
     size_t len = ps_serialize(pub_buf, &odom, 1024);
     if (len > 0){
-        picoros_publish(&pub_odo, pub_buf, len);
+        picoros_publish_group(&odo_group, pub_buf, len);
     }
     else{
         printf("Odometry message serialization error.");
@@ -80,6 +97,8 @@ int main(int argc, char **argv){
 
     printf("Declaring publisher on %s\n", pub_odo.topic.name);
     picoros_publisher_declare(&node, &pub_odo);
+    printf("Declaring publisher on %s\n", pub_odo_ns.topic.name);
+    picoros_publisher_declare(&node, &pub_odo_ns);
 
     while(true){
         publish_odometry();
@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * @file    publish_stress.c
+ * @brief   Multithreaded publish stress benchmark for picoros
+ * @date    2025-Oct-16
+ *
+ * @details This example publishes imu messages on the "imu" topic from an
+ *          increasing number of threads sharing a single publisher. For each
+ *          thread count it prints aggregate and per thread throughput and the
+ *          speedup and efficiency relative to a single publishing thread.
+ *          Requires zenoh-pico built with Z_FEATURE_MULTI_THREAD.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "picoros.h"
+#include "picoserdes.h"
+
+// Use command line arguments to change default values
+#define MODE        "client"
+#define LOCATOR     "tcp/192.168.1.16:7447"
+
+// Maximum number of publishing threads and duration of each run
+#define MAX_THREADS     8
+#define RUN_TIME_MS     2000
+
+// Common utils
+extern int picoros_parse_args(int argc, char **argv, picoros_interface_t* ifx);
+
+// Shared Publisher
+picoros_publisher_t pub_imu = {
+    .topic = {
+        .name = "imu",
+        .type = ROSTYPE_NAME(ros_Imu),
+        .rihs_hash = ROSTYPE_HASH(ros_Imu),
+    },
+};
+
+// Example node
+picoros_node_t node = {
+    .name = "picoros",
+};
+
+// Per thread state, each thread serializes into its own buffer
+typedef struct {
+    uint8_t buf[512];
+    uint32_t sent;
+    uint32_t errors;
+} stress_worker_t;
+
+stress_worker_t workers[MAX_THREADS];
+volatile bool running;
+
+#if Z_FEATURE_MULTI_THREAD == 1
+void* stress_worker(void* arg){
+    stress_worker_t* w = (stress_worker_t*)arg;
+    ros_Imu imu = {
+        .header.frame_id = "imu",
+        .orientation.w = 1.0,
+    };
+    while (running){
+        z_clock_t clk = z_clock_now();
+        imu.header.stamp.sec = clk.tv_sec;
+        imu.header.stamp.nanosec = clk.tv_nsec;
+        imu.angular_velocity.z += 0.001;
+        size_t len = ps_serialize(w->buf, &imu, sizeof(w->buf));
+        if (len > 0 && picoros_publish(&pub_imu, w->buf, len) == PICOROS_OK){
+            w->sent++;
+        }
+        else{
+            w->errors++;
+        }
+    }
+    return NULL;
+}
+
+// Returns aggregate rate of run in msg/s
+double stress_run(int n_threads){
+    z_owned_task_t tasks[MAX_THREADS];
+    running = true;
+    z_clock_t start = z_clock_now();
+    for (int i = 0; i < n_threads; i++){
+        workers[i].sent = 0;
+        workers[i].errors = 0;
+        z_task_init(&tasks[i], NULL, stress_worker, &workers[i]);
+    }
+    z_sleep_ms(RUN_TIME_MS);
+    running = false;
+    for (int i = 0; i < n_threads; i++){
+        z_task_join(z_task_move(&tasks[i]));
+    }
+    unsigned long elapsed_ms = z_clock_elapsed_ms(&start);
+
+    uint32_t sent = 0, errors = 0;
+    for (int i = 0; i < n_threads; i++){
+        sent += workers[i].sent;
+        errors += workers[i].errors;
+    }
+    double rate = elapsed_ms ? sent * 1000.0 / elapsed_ms : 0.0;
+    printf("%7d %10lu %7lu %10.0f %10.0f", n_threads, (unsigned long)sent,
+           (unsigned long)errors, rate, rate / n_threads);
+    return rate;
+}
+#endif
+
+int main(int argc, char **argv){
+    picoros_interface_t ifx = {
+        .mode = MODE,
+        .locator = LOCATOR,
+    };
+    int ret = picoros_parse_args(argc, argv , &ifx);
+
+    if(ret != 0){
+        return ret;
+    }
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    printf("Starting pico-ros interface %s %s\n", ifx.mode, ifx.locator );
+    while (picoros_interface_init(&ifx) == PICOROS_NOT_READY){
+        printf("Waiting RMW init...\n");
+        z_sleep_s(1);
+    }
+
+    printf("Starting Pico-ROS node %s domain:%d\n", node.name, node.domain_id);
+    picoros_node_init(&node);
+
+    printf("Declaring publisher on %s\n", pub_imu.topic.name);
+    picoros_publisher_declare(&node, &pub_imu);
+
+    printf("threads       sent  errors      msg/s  msg/s/thr  speedup  efficiency\n");
+    double base_rate = 0.0;
+    for (int n = 1; n <= MAX_THREADS; n *= 2){
+        double rate = stress_run(n);
+        if (n == 1){
+            base_rate = rate;
+        }
+        double speedup = base_rate > 0.0 ? rate / base_rate : 0.0;
+        printf(" %7.2fx %10.0f%%\n", speedup, 100.0 * speedup / n);
+    }
+    printf("Published sequence numbers: %lu\n", (unsigned long)pub_imu._sequence);
+    picoros_publisher_undeclare(&pub_imu);
+#else
+    printf("Stress benchmark requires Z_FEATURE_MULTI_THREAD\n");
+#endif
+    return 0;
+}
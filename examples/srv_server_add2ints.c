@@ -25,7 +25,7 @@ extern int picoros_parse_args(int argc, char **argv,  picoros_interface_t* ifx);
 picoros_service_reply_t add2_srv_cb(picoros_srv_server_t* server, uint8_t* request, size_t size);
 
 // Static buffer for service reply serialization, used from zenoh threads
-uint8_t srv_buf[1024];
+uint8_t srv_buf[PS_MAX_SIZE(reply_srv_AddTwoInts)];
 
 // Example service
 picoros_srv_server_t add2_srv = {
@@ -53,7 +53,7 @@ picoros_service_reply_t add2_srv_cb(picoros_srv_server_t* server, uint8_t* rx_da
     response.sum = request.a + request.b;
     printf("Service add2(a:%ld, b:%ld) called. Sending reply sum:%ld\n", request.a, request.b, response.sum);
     // serialize reply
-    size_t len = ps_serialize(srv_buf, &response , 1024);
+    size_t len = ps_serialize(srv_buf, &response , sizeof(srv_buf));
     // send reply
     picoros_service_reply_t reply = {
         .length = len,
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * @file    typed_node.cpp
+ * @brief   Example of typed C++ API for picoros
+ * @date    2026-Oct-16
+ *
+ * @details This example demonstrates picoros.hpp entities in one node:
+ *          string publisher and subscriber on "picoros/chatter", "add two integers"
+ *          service server on "services/add2" and a client calling it.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#include <cstdio>
+#include <cstdint>
+#include "picoros.hpp"
+
+// Use command line arguments to change default values
+constexpr const char* MODE = "client";
+constexpr const char* LOCATOR = "tcp/192.168.1.16:7447";
+
+// Common utils
+extern "C" int picoros_parse_args(int argc, char **argv, picoros_interface_t* ifx);
+
+int main(int argc, char **argv) {
+    picoros_interface_t ifx = {
+        .mode = const_cast<char*>(MODE),
+        .locator = const_cast<char*>(LOCATOR),
+    };
+    int ret = picoros_parse_args(argc, argv, &ifx);
+
+    if (ret != 0) {
+        return ret;
+    }
+
+    std::printf("Starting pico-ros interface %s %s\n", ifx.mode, ifx.locator);
+    while (picoros_interface_init(&ifx) == PICOROS_NOT_READY) {
+        std::printf("Waiting RMW init...\n");
+        z_sleep_s(1);
+    }
+
+    picoros::Node node("typed_node");
+
+    // ros_String is an alias of rstring, its ROS type is given explicitly
+    picoros::Publisher<ros_String> chatter(node, "picoros/chatter", PICOROS_TYPE(ros_String));
+    picoros::Subscriber<ros_String> listener(node, "picoros/chatter",
+        [](const ros_String& msg) {
+            std::printf("Heard: %s\n", msg);
+        }, PICOROS_TYPE(ros_String));
+
+    picoros::ServiceServer<picoros::srv::srv_AddTwoInts> add2_server(node, "services/add2",
+        [](const request_srv_AddTwoInts& request, reply_srv_AddTwoInts& reply) {
+            reply.sum = request.a + request.b;
+            return true;
+        });
+    picoros::ServiceClient<picoros::srv::srv_AddTwoInts> add2_client("typed_node", "services/add2",
+        [](const reply_srv_AddTwoInts* reply) {
+            if (reply == nullptr) {
+                std::printf("No reply from service\n");
+                return;
+            }
+            std::printf("Got reply - sum: %ld\n", (long)reply->sum);
+        });
+
+    if (!node || !chatter || !listener || !add2_server || !add2_client) {
+        std::printf("Unable to declare entities\n");
+        return -1;
+    }
+
+    int64_t a = 0;
+    while (true) {
+        chatter.publish((ros_String)"Hello from typed Pico-ROS!");
+        request_srv_AddTwoInts request = {a++, 100};
+        add2_client.call(request);
+        z_sleep_s(1);
+    }
+    return 0;
+}
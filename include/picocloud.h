@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * @file    picocloud.h
+ * @brief   Pico-ROS PointCloud2 packing helpers
+ * @date    2026-Oct-16
+ *
+ * @details This module interleaves separate per field arrays (structure of arrays) into
+ *          packed sensor_msgs/PointCloud2 data and de-interleaves received data back, driven
+ *          by ros_PointField layout of the cloud. Runs of consecutive 4 byte fields, e.g.
+ *          x/y/z/intensity, are transposed with AVX2 or SSE when targeted by compiler, other
+ *          fields are copied by scalar loop. pc_serialize() packs points directly into the
+ *          serialization buffer. Requires ros_PointCloud2 and ros_PointField in user types.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#ifndef PICOCLOUD_H_
+#define PICOCLOUD_H_
+
+/* Exported includes ---------------------------------------------------------*/
+#include "picoserdes.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /**
+ * @defgroup picocloud picocloud
+ * @{
+ */
+/** @} */
+
+/* Exported constants --------------------------------------------------------*/
+/** @brief Maximum number of channels packed or unpacked at once
+ * @ingroup picocloud */
+#ifndef PC_MAX_CHANNELS
+#define PC_MAX_CHANNELS 16
+#endif
+
+/** @brief is_bigendian value of data packed on this host
+ * @ingroup picocloud */
+#define PC_HOST_BIGENDIAN (UCDR_MACHINE_ENDIANNESS == UCDR_BIG_ENDIANNESS)
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief ros_PointField datatype values
+ * @ingroup picocloud
+ */
+typedef enum {
+    PC_INT8 = 1,        /**< int8_t */
+    PC_UINT8 = 2,       /**< uint8_t */
+    PC_INT16 = 3,       /**< int16_t */
+    PC_UINT16 = 4,      /**< uint16_t */
+    PC_INT32 = 5,       /**< int32_t */
+    PC_UINT32 = 6,      /**< uint32_t */
+    PC_FLOAT32 = 7,     /**< float */
+    PC_FLOAT64 = 8,     /**< double */
+} pc_datatype_t;
+
+/**
+ * @brief Separate array of one point field
+ * @ingroup picocloud
+ */
+typedef struct {
+    const char*     name;   /**< Name of ros_PointField */
+    void*           data;   /**< count values of field per point in point order, host byte order */
+} pc_channel_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief Size of ros_PointField datatype
+ * @param datatype Datatype, pc_datatype_t
+ * @return Size in bytes, 0 for unknown datatype
+ * @ingroup picocloud
+ */
+uint32_t pc_datatype_size(uint8_t datatype);
+
+/**
+ * @brief Assign consecutive offsets to point fields
+ * @details Each field is aligned to size of its datatype, point step is rounded up to
+ *          largest alignment.
+ * @param fields Fields with name, datatype and count set
+ * @param n Number of fields
+ * @return Point step, 0 if datatype is unknown
+ * @ingroup picocloud
+ */
+uint32_t pc_fields_init(ros_PointField* fields, uint32_t n);
+
+/**
+ * @brief Interleave channels into packed point data
+ * @details Bytes of point not covered by channels are zeroed.
+ * @param msg Cloud with height, width, fields and point_step set
+ * @param channels Channels to pack, each must name field of msg
+ * @param n Number of channels
+ * @param dst Packed data of point_step * width * height bytes
+ * @return false if channel has no field, fields overlap or exceed point_step
+ * @ingroup picocloud
+ */
+bool pc_pack(const ros_PointCloud2* msg, const pc_channel_t* channels, uint32_t n, uint8_t* dst);
+
+/**
+ * @brief De-interleave packed point data into channels
+ * @details Data in foreign byte order, see is_bigendian, is swapped to host order.
+ * @param msg Cloud with data, e.g. deserialized as view into received buffer
+ * @param channels Channels to fill, each must name field of msg
+ * @param n Number of channels
+ * @return false if channel has no field, field exceeds point_step or data is short
+ * @ingroup picocloud
+ */
+bool pc_unpack(const ros_PointCloud2* msg, const pc_channel_t* channels, uint32_t n);
+
+/**
+ * @brief Serialize cloud with channels packed directly into output buffer
+ * @details Sets row_step, is_bigendian and data size of msg, data pointer is not used.
+ * @param buf Output buffer
+ * @param msg Cloud with header, height, width, fields, point_step and is_dense set
+ * @param channels Channels to pack, see pc_pack()
+ * @param n Number of channels
+ * @param max Size of output buffer
+ * @return Size of serialized message including encapsulation header, 0 on error
+ * @ingroup picocloud
+ */
+size_t pc_serialize(uint8_t* buf, ros_PointCloud2* msg, const pc_channel_t* channels, uint32_t n, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PICOCLOUD_H_ */
@@ -0,0 +1,261 @@
+/*******************************************************************************
+ * @file    picodyn.h
+ * @brief   Pico-ROS runtime dynamic types
+ * @date    2026-Oct-16
+ *
+ * @details This module serializes and deserializes ROS messages of types known only at
+ *          runtime. Schema is loaded from ROS type description JSON (output of
+ *          rosidl_generator_type_description, the same files tools/type-gen parses) and
+ *          messages are read into generic value tree or reported as flat field callbacks.
+ *          Output is byte identical to picoserdes generated serializers of the same type.
+ *          All memory comes from caller provided ps_arena_t.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#ifndef PICODYN_H_
+#define PICODYN_H_
+
+/* Exported includes ---------------------------------------------------------*/
+#include "picoserdes.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /**
+ * @defgroup picodyn picodyn
+ * @{
+ */
+/** @} */
+
+/* Exported constants --------------------------------------------------------*/
+/** @brief Maximum length of field path passed to field callbacks, including terminator
+ * @ingroup picodyn */
+#ifndef PD_PATH_MAX
+#define PD_PATH_MAX 256
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @defgroup dyn_schema Dynamic type schema
+ * @ingroup picodyn
+ * @{
+ */
+
+/**
+ * @brief Element type of field, values match rosidl FIELD_TYPE_* identifiers
+ */
+typedef enum {
+    PD_TYPE_NESTED = 1,         /**< Nested message, see pd_field_t.nested */
+    PD_TYPE_INT8 = 2,           /**< int8, value.i */
+    PD_TYPE_UINT8 = 3,          /**< uint8, value.u */
+    PD_TYPE_INT16 = 4,          /**< int16, value.i */
+    PD_TYPE_UINT16 = 5,         /**< uint16, value.u */
+    PD_TYPE_INT32 = 6,          /**< int32, value.i */
+    PD_TYPE_UINT32 = 7,         /**< uint32, value.u */
+    PD_TYPE_INT64 = 8,          /**< int64, value.i */
+    PD_TYPE_UINT64 = 9,         /**< uint64, value.u */
+    PD_TYPE_FLOAT32 = 10,       /**< float32, value.f */
+    PD_TYPE_FLOAT64 = 11,       /**< float64, value.f */
+    PD_TYPE_CHAR = 13,          /**< char, value.u */
+    PD_TYPE_BOOL = 15,          /**< bool, value.b */
+    PD_TYPE_BYTE = 16,          /**< byte, value.u */
+    PD_TYPE_STRING = 17,        /**< string and bounded string, value.s */
+} pd_type_id_t;
+
+/**
+ * @brief Kind of field
+ */
+typedef enum {
+    PD_KIND_FIELD,              /**< Single value */
+    PD_KIND_ARRAY,              /**< Fixed size array */
+    PD_KIND_SEQUENCE,           /**< Bounded or unbounded sequence */
+} pd_kind_t;
+
+struct pd_type_s;
+
+/**
+ * @brief Field of dynamic type
+ */
+typedef struct {
+    const char*                 name;       /**< Field name */
+    const struct pd_type_s*     nested;     /**< Type of PD_TYPE_NESTED elements, NULL otherwise */
+    uint32_t                    capacity;   /**< Array size or sequence bound, 0 for unbounded sequence */
+    uint8_t                     type;       /**< Element type, pd_type_id_t */
+    uint8_t                     kind;       /**< Field kind, pd_kind_t */
+} pd_field_t;
+
+/**
+ * @brief Dynamic type
+ */
+typedef struct pd_type_s {
+    const char*                 name;       /**< ROS type name, e.g. "std_msgs/msg/Header" */
+    const char*                 rmw_name;   /**< RMW type name, e.g. "std_msgs::msg::dds_::Header" */
+    const char*                 hash;       /**< RIHS01 hash without prefix, NULL if not in JSON */
+    const pd_field_t*           fields;     /**< Fields in serialization order */
+    uint16_t                    n_fields;   /**< Number of fields */
+    const struct pd_type_s*     next;       /**< Next type of schema, see pd_load_json() */
+} pd_type_t;
+
+/** @} */
+
+/**
+ * @defgroup dyn_value Dynamic values
+ * @ingroup picodyn
+ * @{
+ */
+
+/**
+ * @brief Value of dynamic type
+ * @details Value tree follows schema: nested value has one item per field of its type,
+ *          arrays and sequences have one item per element. Union member used by scalar
+ *          is given by pd_type_id_t of its field.
+ */
+typedef struct pd_value_s {
+    uint32_t                    n;          /**< Number of items */
+    union {
+        bool                    b;          /**< PD_TYPE_BOOL */
+        int64_t                 i;          /**< Signed integers */
+        uint64_t                u;          /**< Unsigned integers, char and byte */
+        double                  f;          /**< float32 and float64 */
+        char*                   s;          /**< Strings, NULL is serialized as empty */
+        struct pd_value_s*      items;      /**< Members of nested value, elements of array or sequence */
+    };
+} pd_value_t;
+
+/**
+ * @brief Field callback of flat serialization and deserialization
+ * @details Called in serialization order with dot separated field path, e.g. "header.stamp.sec"
+ *          or "values[1].key". Scalars get one call each. Arrays and sequences get one call with
+ *          number of elements in value->n before calls of their elements. Deserialization
+ *          passes read values, serialization expects callback to fill value and sequence size.
+ * @return false to stop processing
+ */
+typedef bool (*pd_field_cb_t)(
+    void*                       ctx,        /**< User context */
+    const char*                 path,       /**< Field path */
+    const pd_field_t*           field,      /**< Field of value */
+    pd_value_t*                 value       /**< Scalar value or number of elements */
+);
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief Load types from ROS type description JSON
+ * @details Accepts rosidl_generator_type_description output ("type_description_msg" and
+ *          "type_hashes") or plain TypeDescription object. Described type and its referenced
+ *          types are linked by pd_type_t.next, described type first. Names are copied, JSON
+ *          text can be freed after load.
+ * @param json JSON text
+ * @param len Length of JSON text
+ * @param arena Storage of loaded types
+ * @return Described type, NULL if JSON is invalid, types are unsupported or arena is full
+ * @ingroup dyn_schema
+ */
+const pd_type_t* pd_load_json(const char* json, size_t len, ps_arena_t* arena);
+
+/**
+ * @brief Find type of loaded schema by ROS type name
+ * @param types First type of schema
+ * @param name ROS type name
+ * @return Type or NULL if not found
+ * @ingroup dyn_schema
+ */
+const pd_type_t* pd_find_type(const pd_type_t* types, const char* name);
+
+/**
+ * @brief Find field of type by name
+ * @param type Type
+ * @param name Field name
+ * @return Field or NULL if not found
+ * @ingroup dyn_schema
+ */
+const pd_field_t* pd_find_field(const pd_type_t* type, const char* name);
+
+/**
+ * @brief Create zero value of type
+ * @details Arrays get all their elements, sequences are empty.
+ * @param type Type of value
+ * @param arena Storage of value
+ * @return Value or NULL if arena is full
+ * @ingroup dyn_value
+ */
+pd_value_t* pd_value_new(const pd_type_t* type, ps_arena_t* arena);
+
+/**
+ * @brief Allocate zero elements of sequence value
+ * @param field Sequence field
+ * @param value Value of field
+ * @param n Number of elements
+ * @param arena Storage of elements
+ * @return false if arena is full or n exceeds sequence bound
+ * @ingroup dyn_value
+ */
+bool pd_value_resize(const pd_field_t* field, pd_value_t* value, uint32_t n, ps_arena_t* arena);
+
+/**
+ * @brief Get member of nested value by field name
+ * @param type Type of value
+ * @param value Nested value
+ * @param name Field name
+ * @return Member value or NULL if type has no such field
+ * @ingroup dyn_value
+ */
+pd_value_t* pd_member(const pd_type_t* type, pd_value_t* value, const char* name);
+
+/**
+ * @brief Serialize value tree
+ * @param buf Output buffer
+ * @param type Type of value
+ * @param value Value from pd_value_new() or pd_deserialize()
+ * @param max Size of output buffer
+ * @return Size of serialized message including encapsulation header, 0 on error
+ * @ingroup dyn_value
+ */
+size_t pd_serialize(uint8_t* buf, const pd_type_t* type, const pd_value_t* value, size_t max);
+
+/**
+ * @brief Deserialize message into value tree
+ * @details Strings point into buf, same as picoserdes rstring members.
+ * @param buf CDR message with encapsulation header
+ * @param type Type of message
+ * @param value Root value, filled on success
+ * @param len Size of message
+ * @param arena Storage of value items
+ * @return true on success
+ * @ingroup dyn_value
+ */
+bool pd_deserialize(uint8_t* buf, const pd_type_t* type, pd_value_t* value, size_t len, ps_arena_t* arena);
+
+/**
+ * @brief Serialize message from field callbacks
+ * @param buf Output buffer
+ * @param type Type of message
+ * @param cb Callback providing values, see pd_field_cb_t
+ * @param ctx Callback context
+ * @param max Size of output buffer
+ * @return Size of serialized message including encapsulation header, 0 on error
+ * @ingroup dyn_value
+ */
+size_t pd_serialize_cb(uint8_t* buf, const pd_type_t* type, pd_field_cb_t cb, void* ctx, size_t max);
+
+/**
+ * @brief Deserialize message to field callbacks without allocation
+ * @param buf CDR message with encapsulation header
+ * @param type Type of message
+ * @param cb Callback receiving values, see pd_field_cb_t
+ * @param ctx Callback context
+ * @param len Size of message
+ * @return true if whole message was read and callback did not stop
+ * @ingroup dyn_value
+ */
+bool pd_deserialize_cb(uint8_t* buf, const pd_type_t* type, pd_field_cb_t cb, void* ctx, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PICODYN_H_ */
@@ -109,6 +109,7 @@ typedef struct picoros_srv_server_s{
     rmw_attachment_t         attachment;     /**< RMW attachment data */
     void*                    user_data;      /**< User data, not used by picoros */
     picoros_srv_server_cb_t  user_callback;  /**< User callback for service handling */
+    z_owned_liveliness_token_t _token;       /**< Private ROS graph liveliness token, declared with topic type */
 } picoros_srv_server_t;
 
 /** @} */
@@ -158,18 +159,219 @@ typedef struct picoros_srv_client_s{
     char*                         _key_buf;              /**< Private buffer for key expresion */
 } picoros_srv_client_t;
 
+/* Forward declaration */
+struct picoros_srv_call_s;
+
+/**
+ * @brief Callback function type for reply handling of asynchronous service call
+ */
+typedef void (*picoros_srv_call_cb_t)(
+    struct picoros_srv_call_s*      call,           /**< Pointer to call context */
+    uint8_t*                        reply_data,     /**< Pointer to received reply data (CDR encoded) */
+    size_t                          reply_size,     /**< Size of received reply */
+    bool                            error           /**< Received error reply */
+);
+
+/**
+ * @brief Callback function type for end of asynchronous service call
+ */
+typedef void (*picoros_srv_call_drop_cb_t)(struct picoros_srv_call_s* call);
+
+/**
+ * @brief Context of one asynchronous service call, see picoros_service_call_async()
+ * @details Owned by caller and must stay valid until drop_callback is called.
+ */
+typedef struct picoros_srv_call_s {
+    picoros_srv_call_cb_t       reply_callback; /**< User callback for reply handling, can be NULL */
+    picoros_srv_call_drop_cb_t  drop_callback;  /**< User callback called once when call ends, also if call fails */
+    uint32_t                    timeout_ms;     /**< Call timeout, 0 to use client options */
+    void*                       user_data;      /**< User data, not used by picoros */
+    int                         _state;         /**< Private call state */
+} picoros_srv_call_t;
+
+/** @} */
+
+/**
+ * @defgroup publish_queue Publish queue
+ * @ingroup picoros
+ * @{
+ */
+
+/** @brief Size of per slot header in publish queue storage */
+#define PICOROS_QUEUE_SLOT_HDR sizeof(size_t)
+
+/** @brief Size of storage needed for publish queue with DEPTH slots of SLOT_SIZE bytes */
+#define PICOROS_QUEUE_BUF_SIZE(DEPTH, SLOT_SIZE) ((DEPTH) * ((SLOT_SIZE) + PICOROS_QUEUE_SLOT_HDR))
+
+/**
+ * @brief Publish queue policy applied when publishing to a full queue
+ */
+typedef enum {
+    PICOROS_QUEUE_BLOCK = 0,        /**< Wait until sender task frees a slot, dropped if publisher is undeclared meanwhile */
+    PICOROS_QUEUE_DROP_NEWEST,      /**< Drop sample being published */
+    PICOROS_QUEUE_CONFLATE,         /**< Keep only latest unsent sample, replaces queued samples on every publish, needs depth >= 2 */
+} picoros_queue_policy_t;
+
+/**
+ * @brief Publish queue statistics
+ */
+typedef struct {
+    size_t   depth;                 /**< Number of samples waiting in queue */
+    uint32_t sent;                  /**< Number of samples sent by sender task */
+    uint32_t dropped;               /**< Number of samples dropped by queue policy */
+    uint32_t errors;                /**< Number of samples sender task failed to put */
+} picoros_queue_stats_t;
+
+/**
+ * @brief Asynchronous publish queue, drained by a per publisher sender task
+ * @details When set on a publisher, picoros_publish() copies sample to queue and returns
+ *          without waiting for network. Requires zenoh-pico with Z_FEATURE_MULTI_THREAD.
+ */
+typedef struct {
+    uint8_t*               buf;         /**< Preallocated storage of PICOROS_QUEUE_BUF_SIZE(depth, slot_size) bytes */
+    size_t                 slot_size;   /**< Maximum size of one queued sample */
+    size_t                 depth;       /**< Number of queue slots */
+    picoros_queue_policy_t policy;      /**< Policy when queue is full */
+    picoros_queue_stats_t  _stats;      /**< Private queue statistics */
+    size_t                 _head;       /**< Private index of oldest queued slot */
+    bool                   _busy;       /**< Private flag, slot before head is being sent */
+    bool                   _running;    /**< Private flag, sender task is running */
+    size_t                 _waiters;    /**< Private number of publishers blocked on full queue */
+#if Z_FEATURE_MULTI_THREAD == 1
+    z_owned_task_t         _task;       /**< Private sender task */
+    z_owned_mutex_t        _mutex;      /**< Private queue lock */
+    z_owned_condvar_t      _cv_data;    /**< Private signal for sender task */
+    z_owned_condvar_t      _cv_space;   /**< Private signal for blocked publishers */
+#endif
+} picoros_pub_queue_t;
+
+/** @} */
+
+/**
+ * @defgroup shaper Traffic shaper
+ * @ingroup picoros
+ * @{
+ */
+
+/**
+ * @brief Token bucket limiting average rate and burst size of published bytes
+ * @details Sample conforms when bucket holds at least min(len, burst) tokens, bucket may go
+ *          into debt so samples larger than burst are still sent at average rate.
+ */
+typedef struct {
+    uint32_t  rate;                 /**< Refill rate in bytes per second, 0 for unlimited */
+    uint32_t  burst;                /**< Bucket capacity in bytes */
+    int64_t   _tokens;              /**< Private number of available tokens */
+    uint32_t  _frac;                /**< Private fraction of token carried to next refill, in bytes per million */
+    z_clock_t _last;                /**< Private time of last refill */
+} picoros_token_bucket_t;
+
+/**
+ * @brief Shaper policy applied to over budget samples
+ */
+typedef enum {
+    PICOROS_SHAPE_DROP = 0,         /**< Drop sample, publish returns PICOROS_DROPPED */
+    PICOROS_SHAPE_DEFER,            /**< Send sample when tokens are available, publisher or sender task waits */
+    PICOROS_SHAPE_CONFLATE,         /**< Send only latest queued sample when tokens are available, needs publish queue, otherwise drops */
+} picoros_shape_policy_t;
+
+/**
+ * @brief Traffic shaper counters, in bytes of payload
+ */
+typedef struct {
+    uint64_t shaped;                /**< Bytes sent through shaper */
+    uint64_t deferred;              /**< Bytes sent after waiting for tokens */
+    uint64_t dropped;               /**< Bytes dropped or conflated by shaper */
+} picoros_shaper_stats_t;
+
+/**
+ * @brief Priority class of traffic shaper
+ */
+typedef struct {
+    picoros_token_bucket_t bucket;  /**< Bucket shared by all publishers in class */
+    picoros_shape_policy_t policy;  /**< Policy for over budget samples of class */
+    picoros_shaper_stats_t _stats;  /**< Private class counters */
+} picoros_shaper_class_t;
+
+/**
+ * @brief Session level traffic shaper shared by publishers
+ * @details Sample of a publisher must conform to bucket of its class and to its own
+ *          publisher bucket. Leave critical classes unlimited to keep headroom for them.
+ */
+typedef struct {
+    picoros_shaper_class_t* classes;   /**< Array of priority classes */
+    size_t                  n_classes; /**< Number of priority classes */
+    uint32_t                _users;    /**< Private number of declared publishers using shaper */
+#if Z_FEATURE_MULTI_THREAD == 1
+    z_owned_mutex_t         _mutex;    /**< Private lock of buckets and counters */
+#endif
+} picoros_shaper_t;
+
+/** @} */
+
+/**
+ * @defgroup on_change Publish on change
+ * @ingroup picoros
+ * @{
+ */
+
+/** @brief Offset of std_msgs/Header stamp in CDR payload, after encapsulation header */
+#define PICOROS_STAMP_OFFSET 4u
+/** @brief Size of builtin_interfaces/Time stamp in CDR payload */
+#define PICOROS_STAMP_SIZE 8u
+
+/**
+ * @brief Publish on change configuration and state
+ * @details Payload hash is compared with last published sample, identical samples are
+ *          skipped until heartbeat period expires. Bytes in skip region are not hashed,
+ *          use PICOROS_STAMP_OFFSET and PICOROS_STAMP_SIZE for messages starting with a Header.
+ */
+typedef struct {
+    bool      enabled;              /**< Skip publishing of unchanged payloads */
+    uint32_t  heartbeat_ms;         /**< Republish unchanged payload after this period, 0 to never republish */
+    size_t    skip_offset;          /**< Offset of payload region excluded from hash */
+    size_t    skip_len;             /**< Size of payload region excluded from hash, 0 to hash whole payload */
+    uint32_t  _hash;                /**< Private hash of last published payload, 0 if none */
+    uint32_t  _last_ms;             /**< Private time of last publish relative to _epoch */
+    uint32_t  _suppressed;          /**< Private number of suppressed samples */
+    z_clock_t _epoch;               /**< Private time of publisher declare */
+} picoros_on_change_t;
+
 /** @} */
 
 /**
  * @brief Publisher structure for Pico-ROS @ingroup picoros
+ * @details picoros_publish() may be called concurrently from multiple threads on one publisher
+ *          when zenoh-pico is built with Z_FEATURE_MULTI_THREAD. Each call gets a unique
+ *          sequence number, puts from different threads may reach network out of sequence order.
+ *          Counter is 32 bit so increment is lock free on 32 bit MCUs without libatomic, it is
+ *          widened to 64 bit attachment sequence number and wraps after 2^32 messages.
+ *          Declare and undeclare must not run concurrently with publish.
  */
 typedef struct {
     z_owned_publisher_t zpub;       /**< Zenoh publisher instance */
-    rmw_attachment_t   attachment;  /**< RMW attachment data */
+    rmw_attachment_t   attachment;  /**< RMW attachment template, read only after declare */
+    uint32_t           _sequence;   /**< Private sequence counter, updated atomically */
     rmw_topic_t        topic;       /**< Topic information */
     z_publisher_options_t opts;     /**< Topic options, if NULL default options are used */
+    picoros_pub_queue_t* queue;     /**< Asynchronous publish queue, if NULL publish is synchronous */
+    picoros_shaper_t*  shaper;      /**< Traffic shaper, if NULL publish is not shaped */
+    uint8_t            shaper_class;/**< Priority class index in shaper */
+    picoros_token_bucket_t bucket;  /**< Publisher bucket used with shaper, rate 0 for class limit only */
+    picoros_on_change_t on_change;  /**< Publish on change mode, disabled by default */
+    z_owned_liveliness_token_t _token; /**< Private ROS graph liveliness token, declared with topic type */
 } picoros_publisher_t;
 
+/**
+ * @brief Set of publishers sharing one serialized payload @ingroup publisher
+ * @details Payload is serialized once and put to every publisher without copying,
+ *          each publisher sends its own attachment sequence number and timestamp.
+ */
+typedef struct {
+    picoros_publisher_t** pubs;     /**< Array of declared publishers */
+    size_t                n_pubs;   /**< Number of publishers in array */
+} picoros_pub_group_t;
+
 /** @} */
 
 
@@ -187,13 +389,83 @@ typedef void (*picoros_sub_cb_t)(
             size_t   data_len   /**< Size of received data in bytes */
             );
 
+/* Forward declaration */
+struct picoros_subscriber_s;
+
 /**
- * @brief Subscriber structure for Pico-ROS
+ * @brief Callback function type for subscriber data handling with subscriber instance
+ */
+typedef void (*picoros_sub_data_cb_t)(
+            struct picoros_subscriber_s* sub,  /**< Pointer to subscriber instance */
+            uint8_t*                     rx_data, /**< Pointer to received data buffer (CDR encoded) */
+            size_t                       data_len /**< Size of received data in bytes */
+            );
+
+/**
+ * @brief View of a single received sample, used for batched delivery
+ */
+typedef struct {
+    uint8_t*         data;          /**< Pointer to sample data (CDR encoded), points into batch storage */
+    size_t           len;           /**< Size of sample data in bytes */
+    rmw_attachment_t attachment;    /**< RMW attachment received with sample, zeroed if missing */
+} picoros_sample_t;
+
+/**
+ * @brief Callback function type for batched subscriber data handling
+ * @note Sample views are valid only until callback returns.
+ */
+typedef void (*picoros_sub_batch_cb_t)(
+            picoros_sample_t* samples,   /**< Array of received samples, oldest first */
+            size_t            n_samples  /**< Number of samples in array */
+            );
+
+/**
+ * @brief Batched delivery configuration and state for high-rate subscribers
+ * @details Received samples are copied into preallocated storage and delivered with one
+ *          callback when max_samples are accumulated, when batch storage is full or when the
+ *          oldest sample in batch is older than period_us.
+ *          With Z_FEATURE_MULTI_THREAD period is run by a timer task of the subscriber, so
+ *          partial batch of a quiet topic is delivered on time. Without it period is checked
+ *          on sample arrival and in picoros_subscriber_poll().
+ *          Storage is double buffered, one batch is filled by zenoh read task while the other
+ *          is delivered, so samples holds 2 * max_samples views and buf two batches of
+ *          buf_size / 2 bytes.
+ *          Callback runs without batch lock held and may call picoros_subscriber_poll() or
+ *          picoros_subscriber_flush(), these deliver nothing while a batch is in callback.
+ *          Samples arriving when filled half is full and other half is still in callback
+ *          are dropped.
  */
 typedef struct {
+    picoros_sample_t*      samples;     /**< Preallocated array of sample views with 2 * max_samples elements */
+    size_t                 max_samples; /**< Number of samples in full batch, at least 1 */
+    uint8_t*               buf;         /**< Preallocated storage for sample data of two batches, 8 byte aligned for zero copy views */
+    size_t                 buf_size;    /**< Size of sample data storage */
+    uint32_t               period_us;   /**< Maximum age of oldest sample in batch, 0 to deliver only full batches */
+    picoros_sub_batch_cb_t callback;    /**< User callback for batch handling */
+    size_t                 _n_samples;  /**< Private number of samples in current batch */
+    size_t                 _buf_used;   /**< Private number of used storage bytes */
+    z_clock_t              _first;      /**< Private arrival time of oldest sample in batch */
+    uint8_t                _fill;       /**< Private index of half being filled */
+    bool                   _delivering; /**< Private flag, other half is in callback */
+    bool                   _running;    /**< Private flag, period timer task is running */
+#if Z_FEATURE_MULTI_THREAD == 1
+    z_owned_mutex_t        _mutex;      /**< Private lock, batch is filled from zenoh read task */
+    z_owned_condvar_t      _cv;         /**< Private signal for period timer task and end of delivery */
+    z_owned_task_t         _timer;      /**< Private period timer task, started if period_us is set */
+#endif
+} picoros_sub_batch_t;
+
+/**
+ * @brief Subscriber structure for Pico-ROS
+ */
+typedef struct picoros_subscriber_s {
     z_owned_subscriber_t zsub;         /**< Zenoh subscriber instance */
     rmw_topic_t         topic;         /**< Topic information */
     picoros_sub_cb_t    user_callback; /**< User callback for data handling */
+    picoros_sub_batch_t* batch;        /**< Batched delivery, if set user_callback is not used */
+    picoros_sub_data_cb_t data_callback; /**< User callback with subscriber instance, if set user_callback is not used */
+    void*               user_data;     /**< User data, not used by picoros */
+    z_owned_liveliness_token_t _token; /**< Private ROS graph liveliness token, declared with topic type */
 } picoros_subscriber_t;
 
 /** @} */
@@ -238,6 +510,7 @@ typedef enum {
     PICOROS_OK = 0,                /**< Operation successful */
     PICOROS_ERROR = -1,            /**< Operation failed */
     PICOROS_NOT_READY = -2,        /**< System not ready */
+    PICOROS_DROPPED = -3,          /**< Sample not published, dropped by publisher policy */
 } picoros_res_t;
 
 /* Exported functions --------------------------------------------------------*/
@@ -273,16 +546,85 @@ picoros_res_t picoros_node_init(picoros_node_t* node);
  */
 picoros_res_t picoros_publisher_declare(picoros_node_t* node, picoros_publisher_t *pub);
 
+/**
+ * @brief Undeclare publisher, stops sender task of publish queue after queued samples are sent
+ * @param pub Pointer to publisher instance
+ * @return PICOROS_OK on success, error code otherwise
+ * @ingroup publisher
+ */
+picoros_res_t picoros_publisher_undeclare(picoros_publisher_t *pub);
+
 /**
  * @brief Publish data on a topic
+ * @details With publish queue, data is copied to queue and sent from sender task.
+ *          With shaper and no queue, PICOROS_SHAPE_DEFER waits in calling thread.
  * @param pub Pointer to publisher instance
  * @param payload Pointer to data to publish
  * @param len Length of data in bytes
- * @return PICOROS_OK on success, error code otherwise
+ * @return PICOROS_OK on success or if suppressed by publish on change,
+ *         PICOROS_DROPPED if dropped by queue or shaper policy, error code otherwise
  * @ingroup publisher
  */
 picoros_res_t picoros_publish(picoros_publisher_t *pub, uint8_t *payload, size_t len);
 
+/**
+ * @brief Get publish queue statistics
+ * @param pub Pointer to publisher instance with publish queue
+ * @param stats Pointer to statistics output
+ * @return PICOROS_OK on success, PICOROS_ERROR if publisher has no queue
+ * @ingroup publish_queue
+ */
+picoros_res_t picoros_publisher_queue_stats(picoros_publisher_t *pub, picoros_queue_stats_t* stats);
+
+/**
+ * @brief Publish one payload to all publishers of a group
+ * @details Payload is shared by puts of all publishers. Publishers with queue, shaper or
+ *          publish on change mode are published with picoros_publish().
+ * @param group Pointer to publisher group
+ * @param payload Pointer to data to publish
+ * @param len Length of data in bytes
+ * @return PICOROS_OK if published to all publishers, otherwise result of last failed publisher
+ * @ingroup publisher
+ */
+picoros_res_t picoros_publish_group(picoros_pub_group_t* group, uint8_t *payload, size_t len);
+
+/**
+ * @brief Get number of samples suppressed by publish on change mode
+ * @param pub Pointer to publisher instance
+ * @return Number of suppressed samples since declare
+ * @ingroup on_change
+ */
+uint32_t picoros_publisher_suppressed(picoros_publisher_t *pub);
+
+/**
+ * @brief Initialize traffic shaper, fills class buckets
+ * @details Call before declaring publishers that use shaper.
+ * @param shaper Pointer to shaper configuration
+ * @return PICOROS_OK on success, error code otherwise
+ * @ingroup shaper
+ */
+picoros_res_t picoros_shaper_init(picoros_shaper_t* shaper);
+
+/**
+ * @brief Release traffic shaper resources
+ * @details Call after undeclaring all publishers that use shaper, picoros_shaper_init()
+ *          is needed before shaper is used again.
+ * @param shaper Pointer to shaper instance
+ * @return PICOROS_OK on success, PICOROS_NOT_READY while publishers using shaper are declared
+ * @ingroup shaper
+ */
+picoros_res_t picoros_shaper_deinit(picoros_shaper_t* shaper);
+
+/**
+ * @brief Get traffic shaper counters of a priority class
+ * @param shaper Pointer to shaper instance
+ * @param class_idx Priority class index
+ * @param stats Pointer to counters output
+ * @return PICOROS_OK on success, PICOROS_ERROR for invalid class
+ * @ingroup shaper
+ */
+picoros_res_t picoros_shaper_stats(picoros_shaper_t* shaper, size_t class_idx, picoros_shaper_stats_t* stats);
+
 /**
  * @brief Declare a subscriber for a node
  * @param node Pointer to node instance
@@ -294,12 +636,32 @@ picoros_res_t picoros_subscriber_declare(picoros_node_t* node, picoros_subscribe
 
 /**
  * @brief Unsubscribe from a topic
+ * @details Batched subscriber waits for a batch still in callback and delivers remaining
+ *          samples before returning, so it must not be called from the batch callback.
  * @param sub Pointer to subscriber instance
  * @return PICOROS_OK on success, error code otherwise
  * @ingroup subscriber
  */
 picoros_res_t picoros_unsubscribe(picoros_subscriber_t *sub);
 
+/**
+ * @brief Deliver batched samples if oldest sample is older than batch period
+ * @details Without Z_FEATURE_MULTI_THREAD call periodically when samples can stop arriving, so
+ *          partial batches are not held back. With it timer task of subscriber does this.
+ * @param sub Pointer to subscriber instance with batched delivery
+ * @return PICOROS_OK on success, PICOROS_ERROR if subscriber is not batched
+ * @ingroup subscriber
+ */
+picoros_res_t picoros_subscriber_poll(picoros_subscriber_t *sub);
+
+/**
+ * @brief Deliver all batched samples immediately
+ * @param sub Pointer to subscriber instance with batched delivery
+ * @return PICOROS_OK on success, PICOROS_ERROR if subscriber is not batched
+ * @ingroup subscriber
+ */
+picoros_res_t picoros_subscriber_flush(picoros_subscriber_t *sub);
+
 /**
  * @brief Declare a service server for a node
  * @param node Pointer to node instance
@@ -309,6 +671,14 @@ picoros_res_t picoros_unsubscribe(picoros_subscriber_t *sub);
  */
 picoros_res_t picoros_service_declare(picoros_node_t* node, picoros_srv_server_t* srv);
 
+/**
+ * @brief Undeclare a service server
+ * @param srv Pointer to service instance
+ * @return PICOROS_OK on success, error code otherwise
+ * @ingroup service_server
+ */
+picoros_res_t picoros_service_undeclare(picoros_srv_server_t* srv);
+
 
 /**
  * @brief Initialize service client with precomputed key expression.
@@ -337,6 +707,29 @@ picoros_res_t picoros_service_call(picoros_srv_client_t* client, uint8_t* payloa
  */
 bool picoros_service_call_in_progress(picoros_srv_client_t* client);
 
+/**
+ * @brief Call service with per call context.
+ * @details Any number of asynchronous calls can be in progress on one client, independent of
+ *          picoros_service_call(). Client options are copied for every call. Reply callback
+ *          and drop callback run in zenoh read task, drop callback is called exactly once for
+ *          every call, after last reply or when call fails.
+ * @param client Pointer to client instance.
+ * @param call Pointer to call context, must stay valid until its drop callback.
+ * @param payload Pointer to data payload
+ * @param len Size of data
+ * @return PICOROS_OK on success, error code otherwise
+ * @ingroup service_client
+ */
+picoros_res_t picoros_service_call_async(picoros_srv_client_t* client, picoros_srv_call_t* call, uint8_t* payload, size_t len);
+
+/**
+ * @brief Release key expression buffer of service client
+ * @param client Pointer to client instance.
+ * @return PICOROS_OK on success, PICOROS_NOT_READY when request is in progress
+ * @ingroup service_client
+ */
+picoros_res_t picoros_service_client_undeclare(picoros_srv_client_t* client);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,860 @@
+/*******************************************************************************
+ * @file    picoros.hpp
+ * @brief   Typed C++ API for Pico-ROS
+ * @date    2026-Oct-16
+ *
+ * @details C++17 wrappers around picoros entities:
+ *          - picoros::Node
+ *          - picoros::Publisher<T> and picoros::Subscriber<T>
+ *          - picoros::ServiceServer<S> and picoros::ServiceClient<S>
+ *          - C++20: picoros::Scheduler and picoros::Task for co_await of service calls
+ *
+ *          Entities are move only and undeclared by destructor. Callbacks are lambdas
+ *          receiving deserialized messages (see picoserdes.hpp). Serialization buffers and
+ *          deserialization arenas come from a per entity BufferPool allocated at construction,
+ *          so publishing and receiving does not allocate.
+ *
+ *          Topic and service types are taken from the message type for MSG_LIST compound types
+ *          and SRV_LIST services (picoros::srv::<name>). Type aliases such as ros_String share
+ *          the C type with other types, pass their type with PICOROS_TYPE().
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#ifndef PICO_ROS_HPP_
+#define PICO_ROS_HPP_
+
+/* Exported includes ---------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <condition_variable>
+#include <coroutine>
+#include <mutex>
+#define PICOROS_CPP_COROUTINES 1
+#endif
+#include "picoros.h"
+#include "picoserdes.hpp"
+
+/* Exported constants --------------------------------------------------------*/
+/** @brief Default buffer size of entities with unbounded message types @ingroup picoros_cpp */
+#ifndef PICOROS_CPP_BUFFER_SIZE
+#define PICOROS_CPP_BUFFER_SIZE 1024u
+#endif
+
+/** @brief ROS type name and hash of message or service TYPE from type lists @ingroup picoros_cpp */
+#define PICOROS_TYPE(TYPE) picoros::TypeInfo{ROSTYPE_NAME(TYPE), ROSTYPE_HASH(TYPE)}
+
+namespace picoros {
+
+/**
+ * @defgroup picoros_cpp C++ API
+ * @ingroup picoros
+ * @{
+ */
+
+/** @brief ROS type of topic or service */
+struct TypeInfo {
+    const char* name;               /**< RMW type name */
+    const char* hash;               /**< RIHS hash */
+};
+
+/**
+ * @brief ROS type of message type T
+ * @details Defined for compound types, type aliases need PICOROS_TYPE().
+ */
+template<class T>
+struct type_of {
+    static_assert(sizeof(T) == 0, "Type of type alias is ambiguous, pass PICOROS_TYPE(<type>)");
+};
+
+#define PICOROS_TYPE_OF(TYPE, ...)                                          \
+    template<>                                                              \
+    struct type_of<TYPE> {                                                  \
+        static TypeInfo get() { return PICOROS_TYPE(TYPE); }                \
+    };
+MSG_LIST(PS_UNUSED, PICOROS_TYPE_OF, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+#undef PICOROS_TYPE_OF
+
+/** @brief Service types generated from SRV_LIST, picoros::srv::<name> */
+namespace srv {
+#define PICOROS_SRV_TYPE(TYPE, ...)                                         \
+    struct TYPE {                                                           \
+        using Request = request_##TYPE;                                     \
+        using Reply = reply_##TYPE;                                         \
+        static TypeInfo get() { return PICOROS_TYPE(TYPE); }                \
+    };
+SRV_LIST(PICOROS_SRV_TYPE, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+#undef PICOROS_SRV_TYPE
+} // namespace srv
+
+/** @brief Buffer pool configuration of an entity */
+struct PoolConfig {
+    size_t count = 1;               /**< Number of buffers, calls needing more buffers at once fail */
+    size_t size = 0;                /**< Size of one buffer, 0 for PS_MAX_SIZE() of bounded types or PICOROS_CPP_BUFFER_SIZE */
+};
+
+/**
+ * @brief Fixed set of preallocated buffers
+ * @details Buffers are taken and returned without locks or allocation. Every buffer is preceded
+ *          by its slot header, so release() needs only buffer pointer and can be used as
+ *          picoros_service_reply_t free callback.
+ */
+class BufferPool {
+public:
+    BufferPool(size_t size, size_t count)
+        : size_(size), count_(count),
+          stride_(sizeof(Slot) + ((size + alignof(Slot) - 1) & ~(alignof(Slot) - 1))),
+          storage_(new (std::nothrow) uint8_t[stride_ * count + alignof(Slot)]) {
+        if (storage_ == nullptr) {
+            count_ = 0;
+        }
+        for (size_t i = 0; i < count_; i++) {
+            new (slot(i)) Slot{{false}};
+        }
+    }
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /** @brief Take free buffer, nullptr if all buffers are in use */
+    uint8_t* acquire() {
+        for (size_t i = 0; i < count_; i++) {
+            Slot* s = slot(i);
+            if (!s->busy.exchange(true, std::memory_order_acquire)) {
+                return (uint8_t*)(s + 1);
+            }
+        }
+        return nullptr;
+    }
+    /** @brief Return buffer taken with acquire() to its pool */
+    static void release(void* buf) {
+        if (buf != nullptr) {
+            ((Slot*)buf - 1)->busy.store(false, std::memory_order_release);
+        }
+    }
+    size_t size() const { return size_; }
+
+private:
+    struct alignas(16) Slot {
+        std::atomic<bool> busy;
+    };
+    Slot* slot(size_t i) {
+        uintptr_t base = ((uintptr_t)storage_.get() + alignof(Slot) - 1) & ~(uintptr_t)(alignof(Slot) - 1);
+        return (Slot*)(base + i * stride_);
+    }
+    size_t size_;
+    size_t count_;
+    size_t stride_;
+    std::unique_ptr<uint8_t[]> storage_;
+};
+
+/** @brief Buffer size used for message type T when pool size is not given */
+template<class T>
+constexpr size_t buffer_size(const PoolConfig& pool) {
+    return (pool.size != 0) ? pool.size
+         : (picoserdes::max_size<T>() > 0) ? (size_t)picoserdes::max_size<T>() : PICOROS_CPP_BUFFER_SIZE;
+}
+
+/**
+ * @brief ROS node
+ * @details Not copyable or movable, entities keep pointer to node given at construction.
+ * @note Node liveliness is not undeclared, same as picoros_node_init().
+ */
+class Node {
+public:
+    explicit Node(const char* name, uint32_t domain_id = 0) : node_() {
+        node_.name = name;
+        node_.domain_id = domain_id;
+        res_ = picoros_node_init(&node_);
+    }
+    Node(Node&&) = delete;
+    Node& operator=(Node&&) = delete;
+    Node(const Node&) = delete;
+    Node& operator=(const Node&) = delete;
+
+    /** @brief Result of node declaration */
+    picoros_res_t result() const { return res_; }
+    explicit operator bool() const { return res_ == PICOROS_OK; }
+    picoros_node_t* native() { return &node_; }
+
+private:
+    picoros_node_t node_;
+    picoros_res_t res_;
+};
+
+/**
+ * @brief Typed publisher, undeclared on destruction
+ * @tparam T Message type
+ */
+template<class T>
+class Publisher {
+public:
+    /**
+     * @brief Declare publisher
+     * @param node Node of publisher
+     * @param topic Topic name
+     * @param type ROS type, required for type aliases
+     * @param pool Serialization buffers, count limits concurrent publish calls
+     * @param config Publisher options (queue, shaper, on change), topic is overwritten.
+     *               Shaper is released by destructor of last publisher using it.
+     */
+    Publisher(Node& node, const char* topic, TypeInfo type = type_of<T>::get(),
+              PoolConfig pool = PoolConfig(), const picoros_publisher_t* config = nullptr)
+        : impl_(new (std::nothrow) Impl(buffer_size<T>(pool), pool.count)) {
+        if (impl_ == nullptr) {
+            return;
+        }
+        if (config != nullptr) {
+            impl_->pub = *config;
+        }
+        impl_->pub.topic = {topic, type.name, type.hash};
+        impl_->res = picoros_publisher_declare(node.native(), &impl_->pub);
+    }
+    ~Publisher() { reset(); }
+    Publisher(Publisher&&) noexcept = default;
+    Publisher& operator=(Publisher&& other) noexcept {
+        if (this != &other) {
+            reset();
+            impl_ = std::move(other.impl_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Serialize and publish message
+     * @return Result of picoros_publish(), PICOROS_NOT_READY if all buffers are in use,
+     *         PICOROS_ERROR if message does not fit into buffer
+     */
+    picoros_res_t publish(const T& msg) {
+        if (!*this) {
+            return PICOROS_ERROR;
+        }
+        uint8_t* buf = impl_->pool.acquire();
+        if (buf == nullptr) {
+            return PICOROS_NOT_READY;
+        }
+        size_t len = picoserdes::serialize(buf, msg, impl_->pool.size());
+        picoros_res_t res = (len > 0) ? picoros_publish(&impl_->pub, buf, len) : PICOROS_ERROR;
+        BufferPool::release(buf);
+        return res;
+    }
+
+    /** @brief Result of declaration */
+    picoros_res_t result() const { return impl_ ? impl_->res : PICOROS_ERROR; }
+    explicit operator bool() const { return result() == PICOROS_OK; }
+    picoros_publisher_t* native() { return impl_ ? &impl_->pub : nullptr; }
+
+private:
+    struct Impl {
+        Impl(size_t size, size_t count) : pub(), pool(size, count) {}
+        picoros_publisher_t pub;
+        BufferPool pool;
+        picoros_res_t res = PICOROS_ERROR;
+    };
+    void reset() {
+        if (impl_ && impl_->res == PICOROS_OK) {
+            picoros_publisher_undeclare(&impl_->pub);
+            if (impl_->pub.shaper != nullptr) {
+                // released only by last publisher using shaper
+                picoros_shaper_deinit(impl_->pub.shaper);
+            }
+        }
+        impl_.reset();
+    }
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Typed subscriber, unsubscribed on destruction
+ * @details Callback receives deserialized message, its strings and sequences point into
+ *          received data or pool arena and are valid only until callback returns.
+ * @tparam T Message type
+ */
+template<class T>
+class Subscriber {
+public:
+    using Callback = std::function<void(const T&)>;
+
+    /**
+     * @brief Declare subscriber
+     * @param node Node of subscriber
+     * @param topic Topic name
+     * @param callback Called for every received message
+     * @param type ROS type, required for type aliases
+     * @param pool Arenas for sequences that can not point into received data,
+     *             count limits concurrent callbacks
+     */
+    Subscriber(Node& node, const char* topic, Callback callback, TypeInfo type = type_of<T>::get(),
+               PoolConfig pool = PoolConfig())
+        : impl_(new (std::nothrow) Impl(buffer_size<T>(pool), pool.count)) {
+        if (impl_ == nullptr) {
+            return;
+        }
+        impl_->callback = std::move(callback);
+        impl_->sub.topic = {topic, type.name, type.hash};
+        impl_->sub.data_callback = on_data;
+        impl_->sub.user_data = impl_.get();
+        impl_->res = picoros_subscriber_declare(node.native(), &impl_->sub);
+    }
+    ~Subscriber() { reset(); }
+    Subscriber(Subscriber&&) noexcept = default;
+    Subscriber& operator=(Subscriber&& other) noexcept {
+        if (this != &other) {
+            reset();
+            impl_ = std::move(other.impl_);
+        }
+        return *this;
+    }
+
+    /** @brief Number of samples not delivered, no free arena or deserialization failed */
+    uint32_t dropped() const { return impl_ ? impl_->dropped.load(std::memory_order_relaxed) : 0; }
+    /** @brief Result of declaration */
+    picoros_res_t result() const { return impl_ ? impl_->res : PICOROS_ERROR; }
+    explicit operator bool() const { return result() == PICOROS_OK; }
+    picoros_subscriber_t* native() { return impl_ ? &impl_->sub : nullptr; }
+
+private:
+    struct Impl {
+        Impl(size_t size, size_t count) : sub(), pool(size, count) {}
+        picoros_subscriber_t sub;
+        BufferPool pool;
+        Callback callback;
+        std::atomic<uint32_t> dropped{0};
+        picoros_res_t res = PICOROS_ERROR;
+    };
+    static void on_data(picoros_subscriber_t* sub, uint8_t* rx_data, size_t data_len) {
+        Impl* impl = (Impl*)sub->user_data;
+        uint8_t* storage = impl->pool.acquire();
+        if (storage == nullptr) {
+            impl->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ps_arena_t arena = {storage, impl->pool.size(), 0};
+        T msg = {};
+        if (picoserdes::deserialize(rx_data, msg, data_len, &arena)) {
+            impl->callback(msg);
+        }
+        else {
+            impl->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        BufferPool::release(storage);
+    }
+    void reset() {
+        if (impl_ && impl_->res == PICOROS_OK) {
+            picoros_unsubscribe(&impl_->sub);
+        }
+        impl_.reset();
+    }
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Typed service server, undeclared on destruction
+ * @details Callback fills reply and returns true to send it. Request strings and sequences
+ *          are valid only until callback returns.
+ * @tparam S Service type from picoros::srv
+ */
+template<class S>
+class ServiceServer {
+public:
+    using Request = typename S::Request;
+    using Reply = typename S::Reply;
+    using Callback = std::function<bool(const Request&, Reply&)>;
+
+    /**
+     * @brief Declare service server
+     * @param node Node of service
+     * @param service Service name
+     * @param callback Called for every request
+     * @param pool Buffers for reply serialization, each buffer also holds request arena of same size
+     */
+    ServiceServer(Node& node, const char* service, Callback callback, PoolConfig pool = PoolConfig())
+        : impl_(new (std::nothrow) Impl(buffer_size<Reply>(pool), pool.count)) {
+        if (impl_ == nullptr) {
+            return;
+        }
+        TypeInfo type = S::get();
+        impl_->callback = std::move(callback);
+        impl_->srv.topic = {service, type.name, type.hash};
+        impl_->srv.user_callback = on_request;
+        impl_->srv.user_data = impl_.get();
+        impl_->res = picoros_service_declare(node.native(), &impl_->srv);
+    }
+    ~ServiceServer() { reset(); }
+    ServiceServer(ServiceServer&&) noexcept = default;
+    ServiceServer& operator=(ServiceServer&& other) noexcept {
+        if (this != &other) {
+            reset();
+            impl_ = std::move(other.impl_);
+        }
+        return *this;
+    }
+
+    /** @brief Result of declaration */
+    picoros_res_t result() const { return impl_ ? impl_->res : PICOROS_ERROR; }
+    explicit operator bool() const { return result() == PICOROS_OK; }
+    picoros_srv_server_t* native() { return impl_ ? &impl_->srv : nullptr; }
+
+private:
+    struct Impl {
+        Impl(size_t size, size_t count) : srv(), size(size), pool(2 * size, count) {}
+        picoros_srv_server_t srv;
+        size_t size;
+        BufferPool pool;
+        Callback callback;
+        picoros_res_t res = PICOROS_ERROR;
+    };
+    static picoros_service_reply_t on_request(picoros_srv_server_t* srv, uint8_t* rx_data, size_t rx_size) {
+        Impl* impl = (Impl*)srv->user_data;
+        picoros_service_reply_t reply = {nullptr, 0, nullptr};
+        uint8_t* buf = impl->pool.acquire();
+        if (buf == nullptr) {
+            return reply;
+        }
+        ps_arena_t arena = {buf + impl->size, impl->size, 0};
+        Request request = {};
+        Reply response = {};
+        size_t len = 0;
+        if (picoserdes::deserialize(rx_data, request, rx_size, &arena) && impl->callback(request, response)) {
+            len = picoserdes::serialize(buf, response, impl->size);
+        }
+        if (len == 0) {
+            BufferPool::release(buf);
+            return reply;
+        }
+        // buffer is returned to pool by picoros after reply is sent
+        reply.data = buf;
+        reply.length = len;
+        reply.free_callback = BufferPool::release;
+        return reply;
+    }
+    void reset() {
+        if (impl_ && impl_->res == PICOROS_OK) {
+            picoros_service_undeclare(&impl_->srv);
+        }
+        impl_.reset();
+    }
+    std::unique_ptr<Impl> impl_;
+};
+
+#if PICOROS_CPP_COROUTINES
+class Scheduler;
+
+/**
+ * @brief Coroutine run by Scheduler
+ * @details Coroutines returning Task can co_await ServiceClient::call(). Task starts suspended
+ *          and runs after Scheduler::spawn(), its frame is freed when coroutine returns.
+ */
+class Task {
+public:
+    /** @brief Queue entry of suspended coroutine, resumed by Scheduler::run() */
+    struct Entry {
+        std::coroutine_handle<> handle;
+        Entry* next = nullptr;
+    };
+    struct promise_type {
+        Scheduler* scheduler = nullptr;
+        Entry entry;
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void();
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Task(Task&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) { handle_.destroy(); }
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        // coroutine was never spawned
+        if (handle_) { handle_.destroy(); }
+    }
+
+private:
+    friend class Scheduler;
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Single threaded coroutine scheduler
+ * @details Coroutines are resumed one at a time by thread calling run(). Service call
+ *          completions are posted from zenoh read task and wake run() without polling, so
+ *          any number of concurrent calls costs no threads. spawn() and run() must be called
+ *          from the same thread.
+ */
+class Scheduler {
+public:
+    Scheduler() = default;
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /** @brief Queue task for first resume by run() */
+    void spawn(Task task) {
+        std::coroutine_handle<Task::promise_type> handle = task.handle_;
+        task.handle_ = nullptr;
+        handle.promise().scheduler = this;
+        handle.promise().entry.handle = handle;
+        tasks_++;
+        post(&handle.promise().entry);
+    }
+    /** @brief Resume queued coroutines until all spawned tasks returned */
+    void run() {
+        while (true) {
+            Task::Entry* entry;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return head_ != nullptr || tasks_ == 0; });
+                if (head_ == nullptr) {
+                    return;
+                }
+                entry = head_;
+                head_ = entry->next;
+                if (head_ == nullptr) {
+                    tail_ = nullptr;
+                }
+            }
+            entry->handle.resume();
+        }
+    }
+    /** @brief Queue suspended coroutine for resume, can be called from any thread */
+    void post(Task::Entry* entry) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entry->next = nullptr;
+            if (tail_ != nullptr) {
+                tail_->next = entry;
+            }
+            else {
+                head_ = entry;
+            }
+            tail_ = entry;
+        }
+        cv_.notify_one();
+    }
+
+private:
+    friend struct Task::promise_type;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    Task::Entry* head_ = nullptr;
+    Task::Entry* tail_ = nullptr;
+    size_t tasks_ = 0;              /**< Spawned tasks not returned, changed only by run() thread */
+};
+
+inline void Task::promise_type::return_void() {
+    std::lock_guard<std::mutex> lock(scheduler->mutex_);
+    scheduler->tasks_--;
+}
+
+/**
+ * @brief Result of awaited service call
+ * @details Holds pool buffer of reply strings and sequences until destroyed, must not
+ *          outlive its ServiceClient.
+ * @tparam T Reply type
+ */
+template<class T>
+class Response {
+public:
+    Response(picoros_res_t res, uint8_t* buf = nullptr, const T& value = T()) : value_(value), res_(res), buf_(buf) {}
+    Response(Response&& other) noexcept : value_(other.value_), res_(other.res_), buf_(other.buf_) { other.buf_ = nullptr; }
+    Response& operator=(Response&& other) noexcept {
+        if (this != &other) {
+            BufferPool::release(buf_);
+            value_ = other.value_;
+            res_ = other.res_;
+            buf_ = other.buf_;
+            other.buf_ = nullptr;
+        }
+        return *this;
+    }
+    Response(const Response&) = delete;
+    Response& operator=(const Response&) = delete;
+    ~Response() { BufferPool::release(buf_); }
+
+    /**
+     * @brief Result of call
+     * @return PICOROS_OK with reply, PICOROS_ERROR for error reply or failed call,
+     *         PICOROS_DROPPED when no reply was received before timeout,
+     *         PICOROS_NOT_READY when all client buffers were in use
+     */
+    picoros_res_t result() const { return res_; }
+    explicit operator bool() const { return res_ == PICOROS_OK; }
+    const T& operator*() const { return value_; }
+    const T* operator->() const { return &value_; }
+
+private:
+    T value_;
+    picoros_res_t res_;
+    uint8_t* buf_;
+};
+#endif
+
+/**
+ * @brief Typed service client
+ * @details Callback is called once for every successful call(), with reply or with nullptr
+ *          when server replied with error or no reply was received. Destroying client with
+ *          call in progress defers release until picoros drops the call.
+ *
+ *          With C++20 call(request, timeout_ms) is awaitable from Task coroutines. Any number
+ *          of awaited calls can be in progress, limited by pool count, each resumes its
+ *          coroutine on its Scheduler with Response when reply arrives or call is dropped.
+ *          Client must outlive awaited calls and their responses.
+ * @tparam S Service type from picoros::srv
+ */
+template<class S>
+class ServiceClient {
+public:
+    using Request = typename S::Request;
+    using Reply = typename S::Reply;
+    using Callback = std::function<void(const Reply*)>;
+
+    /**
+     * @brief Create service client
+     * @param server_node Node name of service server
+     * @param service Service name
+     * @param callback Called with reply of every call(request), can be empty when only awaited calls are used
+     * @param domain_id Domain ID of service server
+     * @param pool Buffers for request serialization, reply copy and reply arena
+     */
+    ServiceClient(const char* server_node, const char* service, Callback callback,
+                  uint32_t domain_id = 0, PoolConfig pool = PoolConfig())
+        : impl_(new (std::nothrow) Impl(std::max(buffer_size<Request>(pool), buffer_size<Reply>(pool)), pool.count)) {
+        if (impl_ == nullptr) {
+            return;
+        }
+        TypeInfo type = S::get();
+        impl_->callback = std::move(callback);
+        impl_->client.node_name = const_cast<char*>(server_node);
+        impl_->client.node_domain_id = domain_id;
+        impl_->client.topic = {service, type.name, type.hash};
+        impl_->client.user_callback = on_reply;
+        impl_->client.drop_callback = on_drop;
+        impl_->client.user_data = impl_.get();
+        impl_->res = picoros_service_client_init(&impl_->client);
+    }
+    ~ServiceClient() { reset(); }
+    ServiceClient(ServiceClient&&) noexcept = default;
+    ServiceClient& operator=(ServiceClient&& other) noexcept {
+        if (this != &other) {
+            reset();
+            impl_ = std::move(other.impl_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Serialize request and call service
+     * @return Result of picoros_service_call(), PICOROS_NOT_READY if call is in progress
+     */
+    picoros_res_t call(const Request& request) {
+        if (!*this) {
+            return PICOROS_ERROR;
+        }
+        if (picoros_service_call_in_progress(&impl_->client)) {
+            return PICOROS_NOT_READY;
+        }
+        uint8_t* buf = impl_->pool.acquire();
+        if (buf == nullptr) {
+            return PICOROS_NOT_READY;
+        }
+        size_t len = picoserdes::serialize(buf, request, impl_->size);
+        impl_->replied = false;
+        picoros_res_t res = (len > 0) ? picoros_service_call(&impl_->client, buf, len) : PICOROS_ERROR;
+        BufferPool::release(buf);
+        return res;
+    }
+    bool in_progress() { return impl_ && picoros_service_call_in_progress(&impl_->client); }
+
+#if PICOROS_CPP_COROUTINES
+    class CallAwaiter;
+
+    /**
+     * @brief Awaitable service call, co_await from Task coroutine
+     * @param request Request, serialized before coroutine is suspended
+     * @param timeout_ms Call timeout, 0 to use client options
+     * @return Awaiter resuming with Response<Reply>
+     */
+    CallAwaiter call(const Request& request, uint32_t timeout_ms) {
+        return CallAwaiter(impl_.get(), request, timeout_ms);
+    }
+#endif
+
+    /** @brief Result of client initialization */
+    picoros_res_t result() const { return impl_ ? impl_->res : PICOROS_ERROR; }
+    explicit operator bool() const { return result() == PICOROS_OK; }
+    picoros_srv_client_t* native() { return impl_ ? &impl_->client : nullptr; }
+
+private:
+    /** Offset of reply copy in buffer, CDR origin after encapsulation header becomes 8 byte aligned */
+    static constexpr size_t REPLY_OFFSET = 4;
+    struct Impl {
+        Impl(size_t size, size_t count) : client(), size(size), pool(2 * size + 2 * REPLY_OFFSET, count) {}
+        picoros_srv_client_t client;
+        size_t size;
+        BufferPool pool;
+        Callback callback;
+        std::atomic<bool> replied{false};   /**< Reply or drop of current call was delivered */
+        std::atomic<bool> orphaned{false};  /**< Client destroyed, callbacks are not delivered */
+        std::atomic<bool> released{false};  /**< First of reset() and on_drop() done, second one deletes */
+        picoros_res_t res = PICOROS_ERROR;
+    };
+    static void on_reply(picoros_srv_client_t* client, uint8_t* data, size_t len, bool error) {
+        Impl* impl = (Impl*)client->user_data;
+        if (impl->orphaned || impl->replied.exchange(true)) {
+            return;
+        }
+        uint8_t* storage = error ? nullptr : impl->pool.acquire();
+        ps_arena_t arena = {storage, impl->pool.size(), 0};
+        Reply reply = {};
+        bool ok = storage != nullptr && picoserdes::deserialize(data, reply, len, &arena);
+        if (impl->callback) {
+            impl->callback(ok ? &reply : nullptr);
+        }
+        BufferPool::release(storage);
+    }
+    static void on_drop(picoros_srv_client_t* client) {
+        Impl* impl = (Impl*)client->user_data;
+        if (impl->orphaned) {
+            if (impl->released.exchange(true)) {
+                picoros_service_client_undeclare(client);
+                delete impl;
+            }
+            return;
+        }
+        if (!impl->replied.exchange(true) && impl->callback) {
+            impl->callback(nullptr);
+        }
+    }
+    void reset() {
+        if (!impl_) {
+            return;
+        }
+        // orphan before undeclare, drop delivered in between must see it
+        impl_->orphaned = true;
+        if (picoros_service_client_undeclare(&impl_->client) == PICOROS_NOT_READY) {
+            // call in flight, last of reset() and on_drop() deletes impl
+            Impl* impl = impl_.release();
+            if (impl->released.exchange(true)) {
+                picoros_service_client_undeclare(&impl->client);
+                delete impl;
+            }
+            return;
+        }
+        impl_.reset();
+    }
+    std::unique_ptr<Impl> impl_;
+
+#if PICOROS_CPP_COROUTINES
+public:
+    /**
+     * @brief Awaiter of one service call, see call(request, timeout_ms)
+     * @details Lives in awaiting coroutine frame and is picoros_srv_call_t context of the call.
+     *          Reply is copied to pool buffer in zenoh read task, deserialized in resumed coroutine.
+     */
+    class CallAwaiter {
+    public:
+        CallAwaiter(Impl* impl, const Request& request, uint32_t timeout_ms)
+            : impl_(impl), request_(&request), call_() {
+            call_.timeout_ms = timeout_ms;
+        }
+        CallAwaiter(const CallAwaiter&) = delete;
+        CallAwaiter& operator=(const CallAwaiter&) = delete;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<Task::promise_type> handle) {
+            if (impl_ == nullptr || impl_->res != PICOROS_OK) {
+                res_ = PICOROS_ERROR;
+                return false;
+            }
+            buf_ = impl_->pool.acquire();
+            if (buf_ == nullptr) {
+                res_ = PICOROS_NOT_READY;
+                return false;
+            }
+            size_t len = picoserdes::serialize(buf_, *request_, impl_->size);
+            if (len == 0) {
+                res_ = PICOROS_ERROR;
+                return false;
+            }
+            scheduler_ = handle.promise().scheduler;
+            entry_.handle = handle;
+            res_ = PICOROS_DROPPED;
+            call_.reply_callback = on_call_reply;
+            call_.drop_callback = on_call_drop;
+            call_.user_data = this;
+            // payload is copied by zenoh, buffer is reused for reply.
+            // Drop callback resumes coroutine also when call fails.
+            if (picoros_service_call_async(&impl_->client, &call_, buf_, len) != PICOROS_OK) {
+                res_ = PICOROS_ERROR;
+            }
+            return true;
+        }
+        Response<Reply> await_resume() {
+            if (impl_ == nullptr || buf_ == nullptr) {
+                // not suspended, no client or no pool buffer
+                return Response<Reply>(res_ != PICOROS_OK ? res_ : PICOROS_ERROR);
+            }
+            Reply reply = {};
+            ps_arena_t arena = {buf_ + impl_->size + 2 * REPLY_OFFSET, impl_->size, 0};
+            if (res_ == PICOROS_OK && !picoserdes::deserialize(buf_ + REPLY_OFFSET, reply, len_, &arena)) {
+                res_ = PICOROS_ERROR;
+            }
+            if (res_ != PICOROS_OK) {
+                BufferPool::release(buf_);
+                return Response<Reply>(res_);
+            }
+            return Response<Reply>(res_, buf_, reply);
+        }
+
+    private:
+        static void on_call_reply(picoros_srv_call_t* call, uint8_t* data, size_t len, bool error) {
+            CallAwaiter* self = (CallAwaiter*)call->user_data;
+            if (self->replied_) {
+                return;
+            }
+            self->replied_ = true;
+            if (error || len > self->impl_->size) {
+                self->res_ = PICOROS_ERROR;
+                return;
+            }
+            memcpy(self->buf_ + REPLY_OFFSET, data, len);
+            self->len_ = len;
+            self->res_ = PICOROS_OK;
+        }
+        static void on_call_drop(picoros_srv_call_t* call) {
+            CallAwaiter* self = (CallAwaiter*)call->user_data;
+            // awaiter may be destroyed by resumed coroutine after post()
+            self->scheduler_->post(&self->entry_);
+        }
+        Impl* impl_;
+        const Request* request_;
+        picoros_srv_call_t call_;
+        Scheduler* scheduler_ = nullptr;
+        Task::Entry entry_;
+        uint8_t* buf_ = nullptr;
+        size_t len_ = 0;
+        bool replied_ = false;
+        picoros_res_t res_ = PICOROS_ERROR;
+    };
+#endif
+};
+
+/** @} */
+
+} // namespace picoros
+
+#endif /* PICO_ROS_HPP_ */
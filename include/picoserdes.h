@@ -32,7 +32,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 #include "ucdr/microcdr.h"
+
  /**
  * @defgroup user_types_list User types list
  * @ingroup picoserdes
@@ -49,8 +51,11 @@
  *         (seperated to disable types in _Generic calls)
  * CTYPE = Compound type - more members, implemented as struct. FUNC(name, rmw_name, rmw_hash, <fields...>)
  *      FIELD = Field of coumpound type FUNC(type, name)
+ *              Bounded string FUNC(rstring, name, bound) is stored inline as char name[bound + 1]
  *      ARRAY = Array field of coumpound type FUNC(type, name, size)
  *      SEQUENCE = Sequence field of compound type FUNC(type, name)
+ *              Bounded sequence FUNC(type, name, bound) is stored inline as
+ *              struct { type data[bound]; uint32_t n_elements; } name
  *
  * Each entry in table must have the following format
  * TYPE(                 \  // Can be BTYPE, CTYPE, TTYPE
@@ -71,9 +76,9 @@
  * User provided list of service types for creating serdes functions
  * SRV = Top level service name, hash and type. FUNC(srv_name, rmw_name, rmw_hash, <request>, <reply>)
  *      REQUEST / REPLY = Request/reply type, implemented as struct. FUNC(<fields...>)
- *          FIELD = Field of request/reply member. FUNC(type, name)
+ *          FIELD = Field of request/reply member. FUNC(type, name), bounded string FUNC(rstring, name, bound)
  *          ARRAY = Array field of request/reply member. FUNC(type, name, size)
- *          SEQUENCE = Sequence field of request/reply member. FUNC(type, name). 
+ *          SEQUENCE = Sequence field of request/reply member. FUNC(type, name), bounded FUNC(type, name, bound)
  *
  * Each entry in table must have the following format
  * SRV(                  \
@@ -125,6 +130,16 @@
 /** @brief Empty macro function */
 #define PS_UNUSED(...)
 
+/**
+ * @brief Select field macro by optional bound of FIELD / SEQUENCE entry
+ * @details Takes NAME and optional BOUND of entry and names UNBOUNDED for entries without bound
+ *          and BOUNDED for bounded strings and sequences stored inline. Callers paste type names
+ *          before passing them to selected macro, so types like bool are not expanded:
+ *          PS_BOUNDED(UNBOUNDED, BOUNDED, __VA_ARGS__)(ps_ser_##TYPE, __VA_ARGS__)
+ */
+#define PS_BOUNDED(UNBOUNDED, BOUNDED, ...) PS_BOUNDED_SELECT(__VA_ARGS__, BOUNDED, UNBOUNDED, )
+#define PS_BOUNDED_SELECT(_1, _2, MACRO, ...) MACRO
+
 /* Exported types ------------------------------------------------------------*/
 /** @brief char* type alias to be used for string fields */
 typedef char* rstring;
@@ -134,9 +149,13 @@ typedef char* rstring;
  * @{
  */
 #define CAT(x, y) x##y
-#define FIELD_EXPAND(TYPE, NAME) TYPE NAME;
+#define FIELD_EXPAND(TYPE, ...) PS_BOUNDED(FIELD_EXPAND_TYPE, FIELD_EXPAND_STRING, __VA_ARGS__)(TYPE, __VA_ARGS__)
+#define FIELD_EXPAND_TYPE(TYPE, NAME) TYPE NAME;
+#define FIELD_EXPAND_STRING(TYPE, NAME, BOUND) char NAME[(BOUND) + 1];
 #define ARRAY_EXPAND(TYPE, NAME, SIZE) TYPE NAME[SIZE];
-#define SEQUENCE_EXPAND(TYPE, NAME, ...) TYPE##_sequence NAME;
+#define SEQUENCE_EXPAND(TYPE, ...) PS_BOUNDED(SEQUENCE_EXPAND_POINTER, SEQUENCE_EXPAND_INLINE, __VA_ARGS__)(TYPE##_sequence, TYPE, __VA_ARGS__)
+#define SEQUENCE_EXPAND_POINTER(SEQ, TYPE, NAME) SEQ NAME;
+#define SEQUENCE_EXPAND_INLINE(SEQ, TYPE, NAME, BOUND) struct { TYPE data[BOUND]; uint32_t n_elements; } NAME;
 #define SEQUENCE_DECLARE(TYPE, ...)             \
     typedef struct{                             \
         TYPE* data;                             \
@@ -175,7 +194,12 @@ typedef char* rstring;
 /** @} */
 #undef CAT
 #undef FIELD_EXPAND
+#undef FIELD_EXPAND_TYPE
+#undef FIELD_EXPAND_STRING
 #undef ARRAY_EXPAND
+#undef SEQUENCE_EXPAND
+#undef SEQUENCE_EXPAND_POINTER
+#undef SEQUENCE_EXPAND_INLINE
 #undef BTYPE_DECLARE
 #undef CTYPE_DECLARE
 #undef SRV_DECLARE
@@ -183,6 +207,171 @@ typedef char* rstring;
 #undef REPLY_DECLARE
 
 
+/**
+ * @defgroup plain_types Plain type detection
+ * @ingroup picoserdes
+ * @details Type is plain if all its primitive members have the same size. C layout of plain
+ *          type has no padding and matches CDR layout, so it is serialized with one memcpy
+ *          on hosts with matching endianness. Each type gets compile time constants
+ *          ps_leaf_<TYPE> (bitmask of member sizes) and ps_plain_size_<TYPE> (sum of member sizes).
+ * @{
+ */
+
+/** @brief Member size mask bit for types that are never plain (bool, strings, sequences) */
+#define PS_LEAF_NOT_PLAIN 0x10u
+
+/** @brief True if member size mask describes a plain type */
+#define PS_IS_PLAIN(MASK) ((MASK) != 0 && ((MASK) & ((MASK) - 1)) == 0 && (MASK) < PS_LEAF_NOT_PLAIN)
+
+/** @brief Size of members of a plain type, equals alignment in CDR */
+#define PS_PLAIN_ALIGN(MASK) ((size_t)(MASK))
+
+enum {
+    ps_leaf_bool = PS_LEAF_NOT_PLAIN,   ps_plain_size_bool = sizeof(bool),
+    ps_leaf_char = 1,                   ps_plain_size_char = 1,
+    ps_leaf_int8_t = 1,                 ps_plain_size_int8_t = 1,
+    ps_leaf_uint8_t = 1,                ps_plain_size_uint8_t = 1,
+    ps_leaf_int16_t = 2,                ps_plain_size_int16_t = 2,
+    ps_leaf_uint16_t = 2,               ps_plain_size_uint16_t = 2,
+    ps_leaf_int32_t = 4,                ps_plain_size_int32_t = 4,
+    ps_leaf_uint32_t = 4,               ps_plain_size_uint32_t = 4,
+    ps_leaf_int64_t = 8,                ps_plain_size_int64_t = 8,
+    ps_leaf_uint64_t = 8,               ps_plain_size_uint64_t = 8,
+    ps_leaf_float = 4,                  ps_plain_size_float = 4,
+    ps_leaf_double = 8,                 ps_plain_size_double = 8,
+    ps_leaf_rstring = PS_LEAF_NOT_PLAIN, ps_plain_size_rstring = 0,
+};
+
+#define PS_LEAF_FIELD(TYPE, NAME, ...) | ps_leaf_##TYPE
+#define PS_LEAF_ARRAY(TYPE, NAME, SIZE) | ps_leaf_##TYPE
+#define PS_LEAF_SEQUENCE(TYPE, NAME, ...) | PS_LEAF_NOT_PLAIN
+#define PS_PLAIN_SIZE_FIELD(TYPE, NAME, ...) + ps_plain_size_##TYPE
+#define PS_PLAIN_SIZE_ARRAY(TYPE, NAME, SIZE) + (SIZE) * ps_plain_size_##TYPE
+#define PS_LEAF_BTYPE(TYPE, NAME, HASH, TYPE2, ...) enum { ps_leaf_##TYPE = ps_leaf_##TYPE2 };
+#define PS_PLAIN_SIZE_BTYPE(TYPE, NAME, HASH, TYPE2, ...) enum { ps_plain_size_##TYPE = ps_plain_size_##TYPE2 };
+#define PS_LEAF_CTYPE(TYPE, NAME, HASH, ...) enum { ps_leaf_##TYPE = 0 __VA_ARGS__ };
+#define PS_PLAIN_SIZE_CTYPE(TYPE, NAME, HASH, ...) enum { ps_plain_size_##TYPE = 0 __VA_ARGS__ };
+
+MSG_LIST(PS_LEAF_BTYPE, PS_LEAF_CTYPE, PS_LEAF_BTYPE, PS_LEAF_FIELD, PS_LEAF_ARRAY, PS_LEAF_SEQUENCE)
+MSG_LIST(PS_PLAIN_SIZE_BTYPE, PS_PLAIN_SIZE_CTYPE, PS_PLAIN_SIZE_BTYPE, PS_PLAIN_SIZE_FIELD, PS_PLAIN_SIZE_ARRAY, PS_UNUSED)
+
+#undef PS_LEAF_FIELD
+#undef PS_LEAF_ARRAY
+#undef PS_LEAF_SEQUENCE
+#undef PS_PLAIN_SIZE_FIELD
+#undef PS_PLAIN_SIZE_ARRAY
+#undef PS_LEAF_BTYPE
+#undef PS_PLAIN_SIZE_BTYPE
+#undef PS_LEAF_CTYPE
+#undef PS_PLAIN_SIZE_CTYPE
+
+/** @} */
+
+/**
+ * @defgroup max_size Maximum serialized size
+ * @ingroup picoserdes
+ * @details PS_MAX_SIZE(TYPE) is compile time upper bound of ps_serialize() result for messages
+ *          and service request_/reply_ types, usable for sizing static buffers and pools. Bound
+ *          comes from C layout of shadow struct with CDR size and alignment of every member. It
+ *          is not exact, sizeof of shadow struct includes trailing padding of the type itself and
+ *          of nested types, e.g. uint32 member after double. Types with strings or sequences
+ *          are unbounded and their PS_MAX_SIZE is -1, so buffer declared with it fails to compile.
+ *          Bounded strings and sequences count with their bound. ps_unbounded_<TYPE> is mask of
+ *          PS_SIZE_UNBOUNDED and PS_SIZE_VARIABLE, any of them ends fixed layout prefix.
+ * @{
+ */
+
+/** @brief Size mask bit of types without maximum serialized size */
+#define PS_SIZE_UNBOUNDED 0x1u
+
+/** @brief Size mask bit of types with variable serialized size */
+#define PS_SIZE_VARIABLE 0x2u
+
+/** @brief Maximum serialized size including encapsulation header, -1 for unbounded types */
+#define PS_MAX_SIZE(TYPE) ps_max_size_##TYPE
+
+#define PS_SHADOW_BASE(TYPE, SIZE, UNBOUNDED)                                       \
+    typedef struct __attribute__((aligned(SIZE))) { uint8_t b[SIZE]; } ps_shadow_##TYPE; \
+    enum { ps_unbounded_##TYPE = UNBOUNDED };
+PS_SHADOW_BASE(bool, 1, 0)
+PS_SHADOW_BASE(char, 1, 0)
+PS_SHADOW_BASE(int8_t, 1, 0)
+PS_SHADOW_BASE(uint8_t, 1, 0)
+PS_SHADOW_BASE(int16_t, 2, 0)
+PS_SHADOW_BASE(uint16_t, 2, 0)
+PS_SHADOW_BASE(int32_t, 4, 0)
+PS_SHADOW_BASE(uint32_t, 4, 0)
+PS_SHADOW_BASE(int64_t, 8, 0)
+PS_SHADOW_BASE(uint64_t, 8, 0)
+PS_SHADOW_BASE(float, 4, 0)
+PS_SHADOW_BASE(double, 8, 0)
+PS_SHADOW_BASE(rstring, 4, PS_SIZE_UNBOUNDED | PS_SIZE_VARIABLE)
+
+#define PS_SHADOW_FIELD(TYPE, ...) PS_BOUNDED(PS_SHADOW_TYPE, PS_SHADOW_STRING, __VA_ARGS__)(ps_shadow_##TYPE, __VA_ARGS__)
+#define PS_SHADOW_TYPE(SHADOW, NAME) SHADOW NAME;
+#define PS_SHADOW_STRING(SHADOW, NAME, BOUND) ps_shadow_uint32_t NAME##_n; uint8_t NAME[(BOUND) + 1];
+#define PS_SHADOW_ARRAY(TYPE, NAME, SIZE) ps_shadow_##TYPE NAME[SIZE];
+#define PS_SHADOW_SEQUENCE(TYPE, ...) PS_BOUNDED(PS_SHADOW_POINTER, PS_SHADOW_INLINE, __VA_ARGS__)(ps_shadow_##TYPE, __VA_ARGS__)
+#define PS_SHADOW_POINTER(SHADOW, NAME) ps_shadow_uint32_t NAME;
+#define PS_SHADOW_INLINE(SHADOW, NAME, BOUND) ps_shadow_uint32_t NAME##_n; SHADOW NAME[BOUND];
+#define PS_UNBOUNDED_FIELD(TYPE, ...) PS_BOUNDED(PS_UNBOUNDED_TYPE, PS_UNBOUNDED_STRING, __VA_ARGS__)(ps_unbounded_##TYPE, __VA_ARGS__)
+#define PS_UNBOUNDED_TYPE(UNBOUNDED, NAME) | UNBOUNDED
+#define PS_UNBOUNDED_STRING(UNBOUNDED, NAME, BOUND) | PS_SIZE_VARIABLE
+#define PS_UNBOUNDED_ARRAY(TYPE, NAME, SIZE) | ps_unbounded_##TYPE
+#define PS_UNBOUNDED_SEQUENCE(TYPE, ...) PS_BOUNDED(PS_UNBOUNDED_POINTER, PS_UNBOUNDED_INLINE, __VA_ARGS__)(ps_unbounded_##TYPE, __VA_ARGS__)
+#define PS_UNBOUNDED_POINTER(UNBOUNDED, NAME) | PS_SIZE_UNBOUNDED | PS_SIZE_VARIABLE
+#define PS_UNBOUNDED_INLINE(UNBOUNDED, NAME, BOUND) | UNBOUNDED | PS_SIZE_VARIABLE
+#define PS_MAX_SIZE_ENUM(TYPE)                                                      \
+    enum { ps_max_size_##TYPE = (ps_unbounded_##TYPE & PS_SIZE_UNBOUNDED) ? -1      \
+                                : (int)(sizeof(ps_shadow_##TYPE) + sizeof(uint32_t)) };
+#define PS_SHADOW_BTYPE(TYPE, NAME, HASH, TYPE2, ...)                               \
+    typedef ps_shadow_##TYPE2 ps_shadow_##TYPE;                                     \
+    PS_MAX_SIZE_ENUM(TYPE)
+#define PS_SHADOW_CTYPE(TYPE, NAME, HASH, ...)                                      \
+    typedef struct { __VA_ARGS__ } ps_shadow_##TYPE;                                \
+    PS_MAX_SIZE_ENUM(TYPE)
+#define PS_UNBOUNDED_BTYPE(TYPE, NAME, HASH, TYPE2, ...) enum { ps_unbounded_##TYPE = ps_unbounded_##TYPE2 };
+#define PS_UNBOUNDED_CTYPE(TYPE, NAME, HASH, ...) enum { ps_unbounded_##TYPE = 0 __VA_ARGS__ };
+#define PS_SHADOW_SRV(TYPE, NAME, HASH, REQ, REP)                                   \
+    typedef struct { REQ } ps_shadow_request_##TYPE;                                \
+    typedef struct { REP } ps_shadow_reply_##TYPE;
+#define PS_UNBOUNDED_SRV(TYPE, NAME, HASH, REQ, REP)                                \
+    enum { ps_unbounded_request_##TYPE = 0 REQ, ps_unbounded_reply_##TYPE = 0 REP }; \
+    PS_MAX_SIZE_ENUM(request_##TYPE)                                                \
+    PS_MAX_SIZE_ENUM(reply_##TYPE)
+#define PS_SHADOW_MEMBERS(...) __VA_ARGS__
+
+MSG_LIST(PS_UNBOUNDED_BTYPE, PS_UNBOUNDED_CTYPE, PS_UNBOUNDED_BTYPE, PS_UNBOUNDED_FIELD, PS_UNBOUNDED_ARRAY, PS_UNBOUNDED_SEQUENCE)
+MSG_LIST(PS_SHADOW_BTYPE, PS_SHADOW_CTYPE, PS_SHADOW_BTYPE, PS_SHADOW_FIELD, PS_SHADOW_ARRAY, PS_SHADOW_SEQUENCE)
+SRV_LIST(PS_SHADOW_SRV, PS_SHADOW_MEMBERS, PS_SHADOW_MEMBERS, PS_SHADOW_FIELD, PS_SHADOW_ARRAY, PS_SHADOW_SEQUENCE)
+SRV_LIST(PS_UNBOUNDED_SRV, PS_SHADOW_MEMBERS, PS_SHADOW_MEMBERS, PS_UNBOUNDED_FIELD, PS_UNBOUNDED_ARRAY, PS_UNBOUNDED_SEQUENCE)
+
+#undef PS_SHADOW_BASE
+#undef PS_SHADOW_FIELD
+#undef PS_SHADOW_TYPE
+#undef PS_SHADOW_STRING
+#undef PS_SHADOW_ARRAY
+#undef PS_SHADOW_SEQUENCE
+#undef PS_SHADOW_POINTER
+#undef PS_SHADOW_INLINE
+#undef PS_UNBOUNDED_FIELD
+#undef PS_UNBOUNDED_TYPE
+#undef PS_UNBOUNDED_STRING
+#undef PS_UNBOUNDED_ARRAY
+#undef PS_UNBOUNDED_SEQUENCE
+#undef PS_UNBOUNDED_POINTER
+#undef PS_UNBOUNDED_INLINE
+#undef PS_MAX_SIZE_ENUM
+#undef PS_SHADOW_BTYPE
+#undef PS_SHADOW_CTYPE
+#undef PS_UNBOUNDED_BTYPE
+#undef PS_UNBOUNDED_CTYPE
+#undef PS_SHADOW_SRV
+#undef PS_UNBOUNDED_SRV
+#undef PS_SHADOW_MEMBERS
+
+/** @} */
+
 /**
  * @brief Writer context for CDR serialization
  */
@@ -271,6 +460,151 @@ BASE_TYPES_LIST(PS_DES_FUNC_DEF)
 #undef PS_DES_SRV_FUNC_DEF
 
 
+/* Generate serialized size function declarations */
+#define PS_SIZE_FUNC_DEF(TYPE, ...)                                         \
+    size_t ps_size_##TYPE(size_t offset, TYPE* msg);                        \
+    size_t ps_size_sequence_##TYPE(size_t offset, TYPE##_sequence* msg);
+#define PS_SIZE_SRV_FUNC_DEF(TYPE, ...)                                     \
+    size_t ps_size_##TYPE##_request(size_t offset, request_##TYPE* msg);    \
+    size_t ps_size_##TYPE##_reply(size_t offset, reply_##TYPE* msg);
+/**
+ * @defgroup size_functions Serialized size functions
+ * @ingroup picoserdes
+ * @details Functions return CDR offset after message serialized at given offset.
+ * @{
+ */
+MSG_LIST(PS_SIZE_FUNC_DEF, PS_SIZE_FUNC_DEF, PS_SIZE_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+SRV_LIST(PS_SIZE_SRV_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+BASE_TYPES_LIST(PS_SIZE_FUNC_DEF)
+/** @} */
+#undef PS_SIZE_FUNC_DEF
+#undef PS_SIZE_SRV_FUNC_DEF
+
+
+/** @brief Validation function result for malformed CDR data */
+#define PS_VAL_FAIL SIZE_MAX
+
+/* Generate validation function declarations */
+#define PS_VAL_FUNC_DEF(TYPE, ...)                                                      \
+    size_t ps_val_##TYPE(const uint8_t* cdr, size_t len, size_t offset);                \
+    size_t ps_val_sequence_##TYPE(const uint8_t* cdr, size_t len, size_t offset);
+#define PS_VAL_SRV_FUNC_DEF(TYPE, ...)                                                  \
+    size_t ps_val_##TYPE##_request(const uint8_t* cdr, size_t len, size_t offset);      \
+    size_t ps_val_##TYPE##_reply(const uint8_t* cdr, size_t len, size_t offset);
+/**
+ * @defgroup validation_functions Validation functions
+ * @ingroup picoserdes
+ * @details Functions walk CDR data of type starting at offset from CDR origin cdr, without
+ *          decoding it. They return offset after the data or PS_VAL_FAIL if any length does
+ *          not fit into len bytes or string is not null terminated. CDR origin must follow
+ *          encapsulation header, lengths are read in its byte order.
+ * @{
+ */
+MSG_LIST(PS_VAL_FUNC_DEF, PS_VAL_FUNC_DEF, PS_VAL_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+SRV_LIST(PS_VAL_SRV_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+BASE_TYPES_LIST(PS_VAL_FUNC_DEF)
+/** @} */
+#undef PS_VAL_FUNC_DEF
+#undef PS_VAL_SRV_FUNC_DEF
+
+
+/* Generate field seek function declarations */
+#define PS_SEEK_FUNC_DEF(TYPE, ...)                                                     \
+    size_t ps_seek_##TYPE(const uint8_t* cdr, size_t len, size_t offset, const char* path);
+/**
+ * @defgroup seek_functions Field seek functions
+ * @ingroup picoserdes
+ * @details Functions return CDR offset of field given by path of dot separated field names, e.g.
+ *          "header.stamp", in CDR data of type at offset. Preceding fields are skipped by their
+ *          CDR lengths without decoding. They return PS_VAL_FAIL if type has no such field or
+ *          preceding data does not fit into len bytes.
+ * @{
+ */
+MSG_LIST(PS_SEEK_FUNC_DEF, PS_SEEK_FUNC_DEF, PS_SEEK_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+BASE_TYPES_LIST(PS_SEEK_FUNC_DEF)
+/** @} */
+#undef PS_SEEK_FUNC_DEF
+
+/**
+ * @defgroup type_descriptors Type descriptors
+ * @ingroup picoserdes
+ * @details With PS_REFLECTION defined every type gets descriptor with its fields names, kinds,
+ *          counts and offsets for generic tooling. With PS_TABLE_DRIVEN defined serialize,
+ *          deserialize, size and validation functions of all types are implemented by single
+ *          interpreter walking these descriptors instead of generated per type code. This trades
+ *          speed for code size. Both options must be defined equally for library and its users.
+ * @{
+ */
+#if defined(PS_TABLE_DRIVEN) && !defined(PS_REFLECTION)
+#define PS_REFLECTION
+#endif
+
+#ifdef PS_REFLECTION
+/** @brief Kind of field in type descriptor */
+typedef enum {
+    PS_KIND_FIELD,          /**< Single member */
+    PS_KIND_ARRAY,          /**< Fixed size array member */
+    PS_KIND_SEQUENCE,       /**< Sequence member, TYPE_sequence in C struct */
+    PS_KIND_BOUNDED_STRING, /**< Bounded string member, char[count + 1] in C struct */
+    PS_KIND_BOUNDED_SEQUENCE, /**< Bounded sequence member, inline data[count] and n_elements */
+} ps_field_kind_t;
+
+/** @brief Base type identifiers, PS_BASE_NONE for compound types */
+#define PS_BASE_ID(TYPE) PS_BASE_##TYPE,
+enum { PS_BASE_NONE, BASE_TYPES_LIST(PS_BASE_ID) };
+#undef PS_BASE_ID
+
+typedef struct ps_type_desc_s ps_type_desc_t;
+
+/** @brief Field descriptor */
+typedef struct {
+    const char* name;                       /**< Field name */
+    const ps_type_desc_t* (*type)(void);    /**< Getter of field type descriptor */
+    uint32_t offset;                        /**< Offset of field in C struct */
+    uint16_t kind;                          /**< Field kind, ps_field_kind_t */
+    uint16_t count;                         /**< Array size or bound, 1 for fields and 0 for sequences */
+} ps_field_desc_t;
+
+/** @brief Type descriptor */
+struct ps_type_desc_s {
+    const char* name;                       /**< C type name */
+    const ps_field_desc_t* fields;          /**< Fields in serialization order, NULL for base types */
+    uint32_t size;                          /**< C type size */
+    uint16_t align;                         /**< C type alignment */
+    uint16_t n_fields;                      /**< Number of fields */
+    uint8_t base;                           /**< Base type identifier */
+    uint8_t leaf;                           /**< Plain type mask, see ps_leaf_<TYPE> */
+};
+
+/**
+ * @brief Get type descriptor
+ * @details BTYPE and TTYPE aliases return descriptor of aliased type.
+ * @param TYPE Type name, request_<SRV> and reply_<SRV> are named <SRV>_request and <SRV>_reply
+ */
+#define PS_DESC(TYPE) ps_desc_##TYPE()
+
+/* Generate type descriptor getter declarations */
+#define PS_DESC_FUNC_DEF(TYPE, ...) const ps_type_desc_t* ps_desc_##TYPE(void);
+#define PS_DESC_SRV_FUNC_DEF(TYPE, ...)                                                 \
+    const ps_type_desc_t* ps_desc_##TYPE##_request(void);                               \
+    const ps_type_desc_t* ps_desc_##TYPE##_reply(void);
+MSG_LIST(PS_DESC_FUNC_DEF, PS_DESC_FUNC_DEF, PS_DESC_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+SRV_LIST(PS_DESC_SRV_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+BASE_TYPES_LIST(PS_DESC_FUNC_DEF)
+#undef PS_DESC_FUNC_DEF
+#undef PS_DESC_SRV_FUNC_DEF
+
+/**
+ * @brief Find field of type by name
+ * @param desc Type descriptor
+ * @param name Field name
+ * @return Field descriptor or NULL if type has no such field
+ */
+const ps_field_desc_t* ps_desc_field(const ps_type_desc_t* desc, const char* name);
+#endif
+/** @} */
+
+
 /**
  * @brief Generic serdes macros helpers
  * @{
@@ -287,6 +621,18 @@ BASE_TYPES_LIST(PS_DES_FUNC_DEF)
 #define PS_SEL_SRV_DES(TYPE, ...)                       \
             request_##TYPE*: ps_des_##TYPE##_request,   \
             reply_##TYPE*: ps_des_##TYPE##_reply,
+#define PS_SEL_VAL(TYPE, ...)                           \
+            TYPE*: ps_val_##TYPE,                       \
+            TYPE##_sequence*: ps_val_sequence_##TYPE,
+#define PS_SEL_SRV_VAL(TYPE, ...)                       \
+            request_##TYPE*: ps_val_##TYPE##_request,   \
+            reply_##TYPE*: ps_val_##TYPE##_reply,
+#define PS_SEL_SIZE(TYPE, ...)                          \
+            TYPE*: ps_size_##TYPE,                      \
+            TYPE##_sequence*: ps_size_sequence_##TYPE,
+#define PS_SEL_SRV_SIZE(TYPE, ...)                      \
+            request_##TYPE*: ps_size_##TYPE##_request,  \
+            reply_##TYPE*: ps_size_##TYPE##_reply,
 
 // Helpers needed for using _ps_serialize in macros given to xxx_LIST xmacros
 // xxx_LIST macro expanison needs to be deffered to allow rescaning and expanding the second time
@@ -304,6 +650,101 @@ BASE_TYPES_LIST(PS_DES_FUNC_DEF)
 /** @} */
 
 
+/**
+ * @defgroup byte_order CDR byte order
+ * @ingroup picoserdes
+ * @details Messages are written in host byte order. Byte order of received message is taken
+ *          from its encapsulation header, so messages from hosts of other byte order are decoded
+ *          too. Plain data in foreign byte order is copied at once and swapped in place.
+ * @{
+ */
+
+/**
+ * @brief Byte order of CDR message from its encapsulation header
+ * @details Lowest bit of big endian representation identifier selects little endian encoding,
+ *          same for CDR, PL_CDR and XCDR2 representations.
+ * @param pBUF Pointer to raw CDR message buffer
+ */
+#define PS_CDR_ENDIANNESS(pBUF) ((ucdrEndianness)(((const uint8_t*)(pBUF))[1] & 0x01u))
+
+/**
+ * @brief Write encapsulation header of CDR message in host byte order
+ * @param pBUF Pointer to raw CDR message buffer
+ */
+#define PS_CDR_HEADER(pBUF)                                                                         \
+    do {                                                                                            \
+        uint8_t* _hdr = (uint8_t*)(pBUF);                                                           \
+        _hdr[0] = 0x00;                                                                             \
+        _hdr[1] = (uint8_t)UCDR_MACHINE_ENDIANNESS;                                                 \
+        _hdr[2] = 0x00;                                                                             \
+        _hdr[3] = 0x00;                                                                             \
+    } while (0)
+
+/**
+ * @brief Reverse byte order of elements in place
+ * @details Vectorized with SSSE3 or NEON when targeted by compiler. Data needs no alignment.
+ * @param data Pointer to elements
+ * @param n Number of elements
+ * @param size Size of element, 2, 4 or 8, other sizes are left unchanged
+ */
+void ps_bswap(void* data, size_t n, size_t size);
+
+/** @} */
+
+/**
+ * @defgroup parallel_copy Parallel plain copies
+ * @ingroup picoserdes
+ * @details Plain blocks, e.g. ros_PointCloud points or float64 sequences, have offsets of all
+ *          elements known in advance. With PS_PARALLEL defined (POSIX threads) copies of large
+ *          blocks are split across small thread pool started by ps_parallel_init(), including
+ *          byte swap of foreign byte order data. Each thread writes its own range, so output
+ *          is byte identical to single thread copy. Without pool copies run on calling thread.
+ * @{
+ */
+
+#ifndef PS_PARALLEL_MAX_THREADS
+/** @brief Maximum number of pool threads, calling thread is not included */
+#define PS_PARALLEL_MAX_THREADS 8
+#endif
+
+#ifndef PS_PARALLEL_MIN_SIZE
+/** @brief Default size of smallest block copied in parallel */
+#define PS_PARALLEL_MIN_SIZE (256u * 1024u)
+#endif
+
+/**
+ * @brief Copy block of plain elements
+ * @details Block at least pool threshold in size is copied by pool threads and calling thread
+ *          together. Copy runs on calling thread alone if pool is not started or busy with
+ *          block of another thread.
+ * @param dst Destination
+ * @param src Source, must not overlap destination
+ * @param size Size of block in bytes
+ * @param align Size of plain members, see PS_PLAIN_ALIGN()
+ * @param swap Reverse byte order of members after copy, see ps_bswap()
+ */
+void ps_copy_plain(void* dst, const void* src, size_t size, size_t align, bool swap);
+
+#ifdef PS_PARALLEL
+/**
+ * @brief Start thread pool of plain copies
+ * @details Must not be called concurrently with serialization or deserialization.
+ * @param n_threads Number of pool threads besides calling thread, at most PS_PARALLEL_MAX_THREADS
+ * @param threshold Size of smallest block copied in parallel, 0 for PS_PARALLEL_MIN_SIZE
+ * @return false if pool is already started or threads can not be created
+ */
+bool ps_parallel_init(unsigned n_threads, size_t threshold);
+
+/**
+ * @brief Stop thread pool of plain copies
+ * @details Waits for running copy and joins pool threads. Must not be called concurrently
+ *          with serialization or deserialization.
+ */
+void ps_parallel_deinit(void);
+#endif
+
+/** @} */
+
 /**
  * @defgroup generic_serdes_macros Generic serdes macros
  * @ingroup picoserdes
@@ -315,13 +756,13 @@ BASE_TYPES_LIST(PS_DES_FUNC_DEF)
  * @param pBUF Pointer to raw CDR message buffer
  * @param pMSG Pointer to ROS message
  * @param MAX Maximum buffer size
- * @return Size of serialized message
+ * @return Size of serialized message, 0 if buffer is too small or bound is exceeded
  */
 #define ps_serialize(pBUF, pMSG, MAX) PS_EXPAND(_ps_serialize(pBUF, pMSG, MAX))
 #define _ps_serialize(pBUF, pMSG, MAX)                                                              \
     ({                                                                                              \
         ucdrBuffer writer = {};                                                                     \
-        *((uint32_t*)pBUF) =  0x0100; /*Little endian header*/                                      \
+        PS_CDR_HEADER(pBUF);                                                                        \
         ucdr_init_buffer(&writer, pBUF + sizeof(uint32_t), MAX - sizeof(uint32_t));                 \
         _Generic((pMSG),                                                                            \
             PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_SER)                                          \
@@ -329,21 +770,133 @@ BASE_TYPES_LIST(PS_DES_FUNC_DEF)
             PS_DEFER(SRV_LIST_INDIRECT)(PS_SEL_SRV_SER, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED) \
             default: 0                                                                              \
         )(&writer, pMSG);                                                                           \
-        size_t _ret = ucdr_buffer_length(&writer) + sizeof(uint32_t);                               \
+        size_t _ret = writer.error ? 0 : ucdr_buffer_length(&writer) + sizeof(uint32_t);            \
         _ret;                                                                                       \
     })
+
+/**
+ * @brief Generic serialized size macro
+ * @details Computes exact size ps_serialize() returns for message, without writing any bytes.
+ * @param pMSG Pointer to ROS message
+ * @return Size of serialized message including encapsulation header
+ */
+#define ps_serialized_size(pMSG) PS_EXPAND(_ps_serialized_size(pMSG))
+#define _ps_serialized_size(pMSG)                                                                   \
+    ({                                                                                              \
+        size_t _ret = _Generic((pMSG),                                                              \
+            PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_SIZE)                                         \
+            PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_SIZE, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)     \
+            PS_DEFER(SRV_LIST_INDIRECT)(PS_SEL_SRV_SIZE, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED) \
+            default: 0                                                                              \
+        )(0, pMSG);                                                                                 \
+        _ret + sizeof(uint32_t);                                                                    \
+    })
+
+/**
+ * @brief Generic validation macro
+ * @details Checks that all lengths of CDR message fit into buffer, message is not accessed
+ *          and only its type is used. Deserialization of validated buffer does not run out of
+ *          data, so it fails only on sequence capacity or arena size and does not leave message
+ *          partially filled because of truncated or malicious input.
+ * @param pBUF Pointer to raw CDR message buffer
+ * @param pMSG Pointer to ROS message of expected type
+ * @param MAX Size of data in buffer
+ * @return true if buffer holds structurally valid message
+ */
+#define ps_validate(pBUF, pMSG, MAX) PS_EXPAND(_ps_validate(pBUF, pMSG, MAX))
+#define _ps_validate(pBUF, pMSG, MAX)                                                               \
+    ({                                                                                              \
+        size_t _max = (MAX);                                                                        \
+        _max >= sizeof(uint32_t) && _Generic((pMSG),                                                \
+            PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_VAL)                                          \
+            PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_VAL, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)      \
+            PS_DEFER(SRV_LIST_INDIRECT)(PS_SEL_SRV_VAL, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)  \
+            default: 0                                                                              \
+        )((pBUF) + sizeof(uint32_t), _max - sizeof(uint32_t), 0) != PS_VAL_FAIL;                    \
+    })
+
+/**
+ * @brief Read single field of serialized message
+ * @details Field is found by skipping preceding fields using their CDR lengths and only the field
+ *          is deserialized, so cost depends on message prefix before the field and not on whole
+ *          message. Path and output type are checked at compile time. Sequences and strings are
+ *          read as with ps_deserialize(), arrays and array elements can not be read.
+ * @param pBUF Pointer to raw CDR message buffer
+ * @param LEN Size of data in buffer
+ * @param TYPE Message type name
+ * @param PATH Field path, e.g. header.stamp
+ * @param pOUT Pointer to output of field type
+ * @return true if field was read
+ */
+#define ps_peek(pBUF, LEN, TYPE, PATH, pOUT) PS_EXPAND(_ps_peek(pBUF, LEN, TYPE, PATH, pOUT))
+#define _ps_peek(pBUF, LEN, TYPE, PATH, pOUT)                                                       \
+    ({                                                                                              \
+        _Static_assert(__builtin_types_compatible_p(__typeof__(((TYPE*)0)->PATH), __typeof__(*(pOUT))), \
+                       "ps_peek output does not match type of " #TYPE "." #PATH);                   \
+        size_t _len = (LEN);                                                                        \
+        size_t _off = (_len >= sizeof(uint32_t)) ? ps_seek_##TYPE((pBUF) + sizeof(uint32_t),        \
+                        _len - sizeof(uint32_t), 0, #PATH) : PS_VAL_FAIL;                           \
+        _off != PS_VAL_FAIL && _ps_deserialize_at(pBUF, _off, pOUT, _len);                          \
+    })
+
+/**
+ * @brief Generic deserialization macro at CDR offset
+ * @details Deserializes value of pMSG type found at CDR offset, e.g. by ps_seek_<TYPE>() or
+ *          message view. Alignment is relative to CDR origin as in whole message.
+ * @param pBUF Pointer to raw CDR message buffer
+ * @param OFFSET CDR offset of value, from end of encapsulation header
+ * @param pMSG Pointer to output value
+ * @param MAX Size of data in buffer
+ * @return true if deserialization successful
+ */
+#define ps_deserialize_at(pBUF, OFFSET, pMSG, MAX) PS_EXPAND(_ps_deserialize_at(pBUF, OFFSET, pMSG, MAX))
+#define _ps_deserialize_at(pBUF, OFFSET, pMSG, MAX)                                                 \
+    ({                                                                                              \
+        ucdrBuffer reader = {};                                                                     \
+        ucdr_init_buffer_origin_offset_endian(&reader, (pBUF) + sizeof(uint32_t),                   \
+                (MAX) - sizeof(uint32_t), 0, OFFSET, PS_CDR_ENDIANNESS(pBUF));                      \
+        bool _ok = _Generic((pMSG),                                                                 \
+            PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_DES)                                          \
+            PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_DES, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)     \
+            default: 0                                                                              \
+        )(&reader, pMSG);                                                                           \
+        _ok;                                                                                        \
+    })
+
 /**
  * @brief Generic deserialization macro
+ * @details Sequence n_elements is capacity of its data array on input and number of read elements
+ *          on output. Sequence of plain type with data set to NULL is not copied, data points
+ *          into pBUF instead. This needs host endianness and element alignment in memory, CDR
+ *          origin at pBUF + 4 must be 8 byte aligned for 8 byte elements. Byte order is read
+ *          from encapsulation header, see @ref byte_order.
  * @param pBUF Pointer to raw CDR message buffer
  * @param pMSG Pointer to ROS message
  * @param MAX Maximum buffer size
  * @return true if deserialization successful
  */
 #define ps_deserialize(pBUF, pMSG, MAX) PS_EXPAND(_ps_deserialize(pBUF, pMSG, MAX))
-#define _ps_deserialize(pBUF, pMSG, MAX)                                                            \
+#define _ps_deserialize(pBUF, pMSG, MAX) _ps_deserialize_arena(pBUF, pMSG, MAX, NULL)
+
+/**
+ * @brief Generic deserialization macro with arena storage
+ * @details Sequences with data set to NULL are deserialized as views into pBUF when possible,
+ *          otherwise their storage is allocated from arena. Allocations are zeroed, so nested
+ *          sequences of allocated elements are allocated too. Zero initialized message needs no
+ *          preset capacities. Strings point into pBUF.
+ * @param pBUF Pointer to raw CDR message buffer
+ * @param pMSG Pointer to ROS message
+ * @param MAX Maximum buffer size
+ * @param pARENA Pointer to arena, arena.used holds number of used bytes after call
+ * @return true if deserialization successful
+ */
+#define ps_deserialize_arena(pBUF, pMSG, MAX, pARENA) PS_EXPAND(_ps_deserialize_arena(pBUF, pMSG, MAX, pARENA))
+#define _ps_deserialize_arena(pBUF, pMSG, MAX, pARENA)                                              \
     ({                                                                                              \
         ucdrBuffer reader = {};                                                                     \
-        ucdr_init_buffer(&reader, pBUF + sizeof(uint32_t), MAX - sizeof(uint32_t));                 \
+        ucdr_init_buffer_origin_offset_endian(&reader, pBUF + sizeof(uint32_t),                     \
+                MAX - sizeof(uint32_t), 0, 0, PS_CDR_ENDIANNESS(pBUF));                             \
+        reader.args = (pARENA);                                                                     \
         bool _ok = _Generic((pMSG),                                                                 \
             PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_DES)                                          \
             PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_DES, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)     \
@@ -353,6 +906,374 @@ BASE_TYPES_LIST(PS_DES_FUNC_DEF)
         _ok;                                                                                        \
     })
 
+/** @} */
+
+/**
+ * @defgroup message_views Message views
+ * @ingroup picoserdes
+ * @details Read only views of serialized messages. Creating view walks message once without
+ *          decoding it and caches CDR offsets of all its fields in view.at, fields are decoded only
+ *          when accessed. Nested messages are accessed as views and sequences as iterators over
+ *          serialized elements, so large message can be inspected and passed between pipeline
+ *          stages without building its C struct or copying data. Views are generated for CTYPE
+ *          messages, field names and output types are checked at compile time.
+ *
+ * \verbatim
+ * ros_Odometry_view odo;
+ * ros_Header_view header;
+ * ros_Time stamp;
+ * if (ps_view(buf, len, &odo) && ps_view_sub(&odo, header, &header)
+ *     && ps_view_get(&header, stamp, &stamp)) { ... }
+ * \endverbatim
+ * @{
+ */
+#define PS_VIEW_OFFSET_FIELD(TYPE, NAME, ...) uint32_t NAME;
+#define PS_VIEW_DECLARE(TYPE, NAME, HASH, ...)                                          \
+    typedef struct {                                                                    \
+        uint8_t* buf;                   /* message buffer with encapsulation header */  \
+        size_t len;                     /* size of data in buffer */                    \
+        size_t end;                     /* CDR offset after viewed message */           \
+        struct { __VA_ARGS__ } at;      /* CDR offsets of fields */                     \
+    } TYPE##_view;
+#define PS_ITER_DECLARE(TYPE, ...)                                                      \
+    typedef struct {                                                                    \
+        uint8_t* buf;                   /* message buffer with encapsulation header */  \
+        size_t len;                     /* size of data in buffer */                    \
+        size_t offset;                  /* CDR offset of next element */                \
+        uint32_t n;                     /* number of elements */                        \
+        uint32_t i;                     /* index of next element */                     \
+    } TYPE##_iter;
+MSG_LIST(PS_UNUSED, PS_VIEW_DECLARE, PS_UNUSED, PS_VIEW_OFFSET_FIELD, PS_VIEW_OFFSET_FIELD, PS_VIEW_OFFSET_FIELD)
+MSG_LIST(PS_ITER_DECLARE, PS_ITER_DECLARE, PS_ITER_DECLARE, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+BASE_TYPES_LIST(PS_ITER_DECLARE)
+#undef PS_VIEW_OFFSET_FIELD
+#undef PS_VIEW_DECLARE
+#undef PS_ITER_DECLARE
+
+/* Generate view function declarations */
+#define PS_VIEW_FUNC_DEF(TYPE, ...)                                                     \
+    size_t ps_view_init_##TYPE(TYPE##_view* view, uint8_t* buf, size_t len, size_t offset);
+#define PS_ITER_FUNC_DEF(TYPE, ...)                                                     \
+    bool ps_iter_next_##TYPE(TYPE##_iter* iter, TYPE* out);
+#define PS_DES_ARRAY_FUNC_DEF(TYPE, ...)                                                \
+    bool ps_des_array_##TYPE(ucdrBuffer* reader, TYPE* msg, uint32_t max_number);
+MSG_LIST(PS_UNUSED, PS_VIEW_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+MSG_LIST(PS_ITER_FUNC_DEF, PS_ITER_FUNC_DEF, PS_ITER_FUNC_DEF, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+BASE_TYPES_LIST(PS_ITER_FUNC_DEF)
+BASE_TYPES_LIST(PS_DES_ARRAY_FUNC_DEF)
+#undef PS_VIEW_FUNC_DEF
+#undef PS_ITER_FUNC_DEF
+#undef PS_DES_ARRAY_FUNC_DEF
+
+/**
+ * @brief Read sequence length at CDR offset
+ * @param buf Message buffer with encapsulation header
+ * @param len Size of data in buffer
+ * @param offset CDR offset of sequence
+ * @param n Output number of elements
+ * @return CDR offset of first element, PS_VAL_FAIL if length does not fit into buffer
+ */
+size_t ps_view_count(const uint8_t* buf, size_t len, size_t offset, uint32_t* n);
+
+/**
+ * @brief View helpers
+ * @{
+ */
+#define PS_SEL_VIEW(TYPE, ...)      TYPE##_view*: ps_view_init_##TYPE,
+#define PS_SEL_ITER(TYPE, ...)      TYPE##_iter*: ps_iter_next_##TYPE,
+#define PS_SEL_DES_ARRAY(TYPE, ...) TYPE*: ps_des_array_##TYPE,
+#define PS_SEL_VIEW_TYPE(TYPE, ...) TYPE##_view*: (TYPE*)0,
+#define PS_SEL_ITER_TYPE(TYPE, ...) TYPE##_iter*: (TYPE*)0,
+// Null pointer of viewed or element type, only used as operand of __typeof__
+#define PS_VIEWED_TYPE(pVIEW)                                                                       \
+    _Generic((pVIEW),                                                                               \
+        PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_VIEW_TYPE, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED) \
+        default: (void*)0                                                                           \
+    )
+#define PS_ELEMENT_TYPE(pITER)                                                                      \
+    _Generic((pITER),                                                                               \
+        PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_ITER_TYPE)                                        \
+        PS_DEFER(MSG_LIST_INDIRECT)(PS_SEL_ITER_TYPE, PS_SEL_ITER_TYPE, PS_SEL_ITER_TYPE, PS_UNUSED, PS_UNUSED, PS_UNUSED) \
+        default: (void*)0                                                                           \
+    )
+#define PS_VIEW_CHECK(A, B, WHAT)                                                                   \
+    _Static_assert(__builtin_types_compatible_p(__typeof__(A), __typeof__(B)), WHAT " type mismatch")
+/** @} */
+
+/**
+ * @brief Create view of serialized message
+ * @param pBUF Pointer to raw CDR message buffer, must outlive view
+ * @param LEN Size of data in buffer
+ * @param pVIEW Pointer to message view, e.g. ros_Odometry_view*
+ * @return true if buffer holds structurally valid message
+ */
+#define ps_view(pBUF, LEN, pVIEW) PS_EXPAND(_ps_view(pBUF, LEN, pVIEW))
+#define _ps_view(pBUF, LEN, pVIEW)                                                                  \
+    (_Generic((pVIEW),                                                                              \
+        PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_VIEW, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)    \
+        default: 0                                                                                  \
+    )(pVIEW, pBUF, LEN, 0) != PS_VAL_FAIL)
+
+/**
+ * @brief Decode field of view
+ * @details Sequence fields are decoded as with ps_deserialize(), with data NULL plain sequences
+ *          point into buffer.
+ * @param pVIEW Pointer to message view
+ * @param NAME Field name
+ * @param pOUT Pointer to output of field type
+ * @return true if field was decoded
+ */
+#define ps_view_get(pVIEW, NAME, pOUT) PS_EXPAND(_ps_view_get(pVIEW, NAME, pOUT))
+#define _ps_view_get(pVIEW, NAME, pOUT)                                                             \
+    ({                                                                                              \
+        PS_VIEW_CHECK(PS_VIEWED_TYPE(pVIEW)->NAME, *(pOUT), "ps_view_get " #NAME);                  \
+        _ps_deserialize_at((pVIEW)->buf, (pVIEW)->at.NAME, pOUT, (pVIEW)->len);                     \
+    })
+
+/**
+ * @brief Decode array field of view
+ * @param pVIEW Pointer to message view
+ * @param NAME Array field name
+ * @param pOUT Pointer to output array of field type
+ * @return true if array was decoded
+ */
+#define ps_view_array(pVIEW, NAME, pOUT) PS_EXPAND(_ps_view_array(pVIEW, NAME, pOUT))
+#define _ps_view_array(pVIEW, NAME, pOUT)                                                           \
+    ({                                                                                              \
+        PS_VIEW_CHECK(PS_VIEWED_TYPE(pVIEW)->NAME, *(pOUT), "ps_view_array " #NAME);                \
+        ucdrBuffer reader = {0};                                                                    \
+        ucdr_init_buffer_origin_offset_endian(&reader, (pVIEW)->buf + sizeof(uint32_t),             \
+                (pVIEW)->len - sizeof(uint32_t), 0, (pVIEW)->at.NAME, PS_CDR_ENDIANNESS((pVIEW)->buf)); \
+        _Generic(&(*(pOUT))[0],                                                                     \
+            PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_DES_ARRAY)                                    \
+            default: 0                                                                              \
+        )(&reader, &(*(pOUT))[0], sizeof(*(pOUT)) / sizeof((*(pOUT))[0]));                          \
+    })
+
+/**
+ * @brief Create view of nested message field
+ * @param pVIEW Pointer to message view
+ * @param NAME Field name
+ * @param pSUB Pointer to view of field type
+ * @return true if view was created
+ */
+#define ps_view_sub(pVIEW, NAME, pSUB) PS_EXPAND(_ps_view_sub(pVIEW, NAME, pSUB))
+#define _ps_view_sub(pVIEW, NAME, pSUB)                                                             \
+    ({                                                                                              \
+        PS_VIEW_CHECK(&PS_VIEWED_TYPE(pVIEW)->NAME, PS_VIEWED_TYPE(pSUB), "ps_view_sub " #NAME);    \
+        _Generic((pSUB),                                                                            \
+            PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_VIEW, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)    \
+            default: 0                                                                              \
+        )(pSUB, (pVIEW)->buf, (pVIEW)->len, (pVIEW)->at.NAME) != PS_VAL_FAIL;                       \
+    })
+
+/**
+ * @brief Create iterator over serialized elements of sequence field
+ * @param pVIEW Pointer to message view
+ * @param NAME Sequence field name
+ * @param pITER Pointer to iterator of element type, e.g. ros_KeyValue_iter*
+ * @return true if iterator was created
+ */
+#define ps_view_seq(pVIEW, NAME, pITER) PS_EXPAND(_ps_view_seq(pVIEW, NAME, pITER))
+#define _ps_view_seq(pVIEW, NAME, pITER)                                                            \
+    ({                                                                                              \
+        PS_VIEW_CHECK(&PS_VIEWED_TYPE(pVIEW)->NAME.data[0], PS_ELEMENT_TYPE(pITER), "ps_view_seq " #NAME); \
+        (pITER)->buf = (pVIEW)->buf;                                                                \
+        (pITER)->len = (pVIEW)->len;                                                                \
+        (pITER)->i = 0;                                                                             \
+        (pITER)->offset = ps_view_count((pVIEW)->buf, (pVIEW)->len, (pVIEW)->at.NAME, &(pITER)->n); \
+        (pITER)->offset != PS_VAL_FAIL;                                                             \
+    })
+
+/**
+ * @brief Decode next element of sequence iterator
+ * @param pITER Pointer to iterator
+ * @param pOUT Pointer to output of element type
+ * @return true if element was decoded, false at end of sequence
+ */
+#define ps_iter_next(pITER, pOUT) PS_EXPAND(_ps_iter_next(pITER, pOUT))
+#define _ps_iter_next(pITER, pOUT)                                                                  \
+    _Generic((pITER),                                                                               \
+        PS_DEFER(BASE_TYPES_LIST_INDIRECT)(PS_SEL_ITER)                                             \
+        PS_DEFER(MSG_LIST_INDIRECT)(PS_SEL_ITER, PS_SEL_ITER, PS_SEL_ITER, PS_UNUSED, PS_UNUSED, PS_UNUSED) \
+        default: 0                                                                                  \
+    )(pITER, pOUT)
+
+/**
+ * @brief Create view of next element of sequence iterator
+ * @param pITER Pointer to iterator
+ * @param pVIEW Pointer to view of element type
+ * @return true if view was created, false at end of sequence
+ */
+#define ps_iter_view(pITER, pVIEW) PS_EXPAND(_ps_iter_view(pITER, pVIEW))
+#define _ps_iter_view(pITER, pVIEW)                                                                 \
+    ({                                                                                              \
+        PS_VIEW_CHECK(PS_ELEMENT_TYPE(pITER), PS_VIEWED_TYPE(pVIEW), "ps_iter_view");               \
+        bool _ok = (pITER)->i < (pITER)->n && _Generic((pVIEW),                                     \
+            PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_VIEW, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)    \
+            default: 0                                                                              \
+        )(pVIEW, (pITER)->buf, (pITER)->len, (pITER)->offset) != PS_VAL_FAIL;                       \
+        if (_ok){                                                                                   \
+            (pITER)->offset = (pVIEW)->end;                                                         \
+            (pITER)->i++;                                                                           \
+        }                                                                                           \
+        _ok;                                                                                        \
+    })
+/** @} */
+
+/**
+ * @defgroup serdes_arena Deserialization arena
+ * @ingroup picoserdes
+ * @details Bump allocator over caller provided storage for ps_deserialize_arena().
+ * @{
+ */
+
+/**
+ * @brief Deserialization arena
+ */
+typedef struct {
+    uint8_t* buf;       /**< Arena storage */
+    size_t   size;      /**< Size of arena storage */
+    size_t   used;      /**< Number of used bytes, including alignment padding */
+} ps_arena_t;
+
+/**
+ * @brief Allocate zeroed array from arena
+ * @param arena Pointer to arena
+ * @param n Number of elements
+ * @param size Size of one element
+ * @param align Alignment of allocation, power of two
+ * @return Pointer to allocated memory, NULL if arena is full
+ */
+void* ps_arena_alloc(ps_arena_t* arena, size_t n, size_t size, size_t align);
+
+/**
+ * @brief Release all allocations of arena
+ * @param arena Pointer to arena
+ */
+void ps_arena_reset(ps_arena_t* arena);
+
+/** @} */
+
+/**
+ * @defgroup serdes_templates Serialized message templates
+ * @ingroup picoserdes
+ * @details Message is serialized once and CDR offsets of selected numeric fields are recorded.
+ *          On every cycle changed field values are copied from message struct into template
+ *          instead of serializing whole message again. Strings and sequences in message must
+ *          keep their length while template is used. Fields are numeric or bool message values,
+ *          an element of array or sequence is selected by trailing index, e.g. position.data[0].
+ *          Sequences of nested messages can not be entered.
+ * \verbatim
+ * ps_template_t tpl = {.buf = buf, .size = sizeof(buf)};
+ * ps_template_init(&tpl, &js, PS_FIELD(&js, header.stamp.sec), PS_FIELD(&js, position.data[0]));
+ * ...
+ * js.position.data[0] = pos;
+ * ps_template_update(&tpl);   // tpl.buf holds serialized js, tpl.len bytes
+ * \endverbatim
+ * @{
+ */
+
+/** @brief Maximum number of patchable fields in template */
+#ifndef PS_TEMPLATE_MAX_FIELDS
+    #define PS_TEMPLATE_MAX_FIELDS 16
+#endif
+
+/** @brief Maximum length of template field path */
+#ifndef PS_TEMPLATE_MAX_PATH
+    #define PS_TEMPLATE_MAX_PATH 64
+#endif
+
+/**
+ * @brief Patchable template field
+ */
+typedef struct {
+    void*       src;    /**< Address of field in message struct */
+    uint32_t    size;   /**< Size of field in bytes, 0 if field is not numeric */
+    uint32_t    offset; /**< Offset of field in serialized template */
+    const char* path;   /**< Field path in message */
+} ps_template_field_t;
+
+/**
+ * @brief Serialized message template
+ */
+typedef struct {
+    uint8_t*            buf;                            /**< Buffer holding serialized template */
+    size_t              size;                           /**< Size of buf */
+    size_t              len;                            /**< Length of serialized template */
+    size_t              n_fields;                       /**< Number of recorded fields */
+    ps_template_field_t fields[PS_TEMPLATE_MAX_FIELDS]; /**< Recorded fields */
+} ps_template_t;
+
+/** @brief Field seek function of message type, e.g. ps_seek_ros_JointState() */
+typedef size_t (*ps_seek_t)(const uint8_t* cdr, size_t len, size_t offset, const char* path);
+
+/** @brief Size of numeric or bool value, 0 for other types */
+#define PS_TEMPLATE_SIZE(V)                                                                         \
+    _Generic((V),                                                                                   \
+        bool: 1, char: 1, int8_t: 1, uint8_t: 1, int16_t: 2, uint16_t: 2, int32_t: 4, uint32_t: 4,  \
+        int64_t: 8, uint64_t: 8, float: 4, double: 8,                                               \
+        default: 0                                                                                  \
+    )
+
+/**
+ * @brief Reference to message field for ps_template_init()
+ * @param pMSG Pointer to ROS message given to ps_template_init()
+ * @param PATH Field path, e.g. header.stamp.sec or position.data[0]
+ */
+#define PS_FIELD(pMSG, PATH)                                                                        \
+    ((ps_template_field_t){ .src = (void*)&(pMSG)->PATH, .size = PS_TEMPLATE_SIZE((pMSG)->PATH),    \
+                            .path = #PATH })
+
+#define PS_SEL_SEEK(TYPE, ...) TYPE*: ps_seek_##TYPE,
+
+/**
+ * @brief Serialize message to template and record offsets of fields
+ * @details Offsets are found by ps_seek_<TYPE>() in serialized template, message is not changed.
+ *          Sequence of base type may be template root, its elements are PS_FIELD(pMSG, data[i]).
+ * @param pTPL Pointer to template with buf and size set
+ * @param pMSG Pointer to ROS message, must stay valid while template is used
+ * @param ... Fields to record, each wrapped in PS_FIELD()
+ * @return true if all fields were located
+ */
+#define ps_template_init(pTPL, pMSG, ...) PS_EXPAND(_ps_template_init(pTPL, pMSG, __VA_ARGS__))
+#define _ps_template_init(pTPL, pMSG, ...)                                                          \
+    ({                                                                                              \
+        ps_template_field_t _fields[] = { __VA_ARGS__ };                                            \
+        memset((pTPL)->buf, 0, (pTPL)->size); /* alignment padding is not written by ucdr */        \
+        (pTPL)->len = ps_serialize((pTPL)->buf, pMSG, (pTPL)->size);                                \
+        ps_template_record(pTPL, _Generic((pMSG),                                                   \
+            PS_DEFER(MSG_LIST_INDIRECT)(PS_UNUSED, PS_SEL_SEEK, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)     \
+            default: NULL                                                                           \
+        ), _fields, sizeof(_fields) / sizeof(_fields[0]));                                          \
+    })
+
+/**
+ * @brief Record offsets of fields in serialized template, used by ps_template_init()
+ * @param tpl Pointer to template holding serialized message
+ * @param seek Seek function of message type, NULL if message is sequence of base type
+ * @param fields Fields to record
+ * @param n Number of fields
+ * @return true if all fields were located
+ */
+bool ps_template_record(ps_template_t* tpl, ps_seek_t seek, const ps_template_field_t* fields, size_t n);
+
+/**
+ * @brief Copy current values of recorded fields from message into template
+ * @param tpl Pointer to initialized template
+ */
+void ps_template_update(ps_template_t* tpl);
+
+/**
+ * @brief Write value of one recorded field into template
+ * @param tpl Pointer to initialized template
+ * @param idx Index of field in order given to ps_template_init()
+ * @param value Pointer to value of same type as field
+ * @param size Size of value, must match field size
+ * @return true if value was written
+ */
+bool ps_template_patch(ps_template_t* tpl, size_t idx, const void* value, size_t size);
+
 /** @} */
 
  /**
@@ -444,8 +1365,15 @@ void ucdr_seq_end(ucdr_writer_t* writer);
 #ifdef __cplusplus
 }
 
+#include <type_traits>
+
 #undef ps_deserialize
+#undef ps_deserialize_arena
 #undef ps_serialize
+#undef ps_serialized_size
+#undef ps_validate
+#undef ps_peek
+#undef ps_deserialize_at
 
 /**
  * @defgroup generic_serdes_macros Generic serdes c++ overrides
@@ -457,21 +1385,50 @@ void ucdr_seq_end(ucdr_writer_t* writer);
 #define PS_CPP_SER_OVERLOAD(TYPE, ...)                                     \
     inline size_t ps_serialize(uint8_t* pBUF, TYPE* pMSG, size_t MAX) {    \
         ucdrBuffer writer = {};                                            \
-        *((uint32_t*)pBUF) = 0x0100; /* Little endian header */            \
+        PS_CDR_HEADER(pBUF);                                               \
         ucdr_init_buffer(&writer, pBUF + sizeof(uint32_t),                 \
                         MAX - sizeof(uint32_t));                           \
         ps_ser_##TYPE(&writer, pMSG);                                      \
-        return ucdr_buffer_length(&writer) + sizeof(uint32_t);             \
+        return writer.error ? 0 : ucdr_buffer_length(&writer) + sizeof(uint32_t); \
+    }                                                                      \
+    inline size_t ps_serialized_size(TYPE* pMSG) {                         \
+        return ps_size_##TYPE(0, pMSG) + sizeof(uint32_t);                 \
+    }                                                                      \
+    inline bool ps_validate(const uint8_t* pBUF, TYPE*, size_t MAX) {      \
+        return MAX >= sizeof(uint32_t) && ps_val_##TYPE(pBUF + sizeof(uint32_t), \
+                        MAX - sizeof(uint32_t), 0) != PS_VAL_FAIL;         \
     }
 
 #define PS_CPP_DES_OVERLOAD(TYPE, ...)                                     \
+    inline bool ps_deserialize_arena(uint8_t* pBUF, TYPE* pMSG, size_t MAX, ps_arena_t* arena) { \
+        ucdrBuffer reader = {};                                            \
+        ucdr_init_buffer_origin_offset_endian(&reader, pBUF + sizeof(uint32_t), \
+                        MAX - sizeof(uint32_t), 0, 0, PS_CDR_ENDIANNESS(pBUF)); \
+        reader.args = arena;                                               \
+        return ps_des_##TYPE(&reader, pMSG);                               \
+    }                                                                      \
     inline bool ps_deserialize(uint8_t* pBUF, TYPE* pMSG, size_t MAX) {    \
+        return ps_deserialize_arena(pBUF, pMSG, MAX, NULL);                \
+    }                                                                      \
+    inline bool ps_deserialize_at(uint8_t* pBUF, size_t offset, TYPE* pMSG, size_t MAX) { \
         ucdrBuffer reader = {};                                            \
-        ucdr_init_buffer(&reader, pBUF + sizeof(uint32_t),                 \
-                        MAX - sizeof(uint32_t));                           \
+        ucdr_init_buffer_origin_offset_endian(&reader, pBUF + sizeof(uint32_t), \
+                        MAX - sizeof(uint32_t), 0, offset, PS_CDR_ENDIANNESS(pBUF)); \
         return ps_des_##TYPE(&reader, pMSG);                               \
     }
 
+// Field read, see C ps_peek()
+#define ps_peek(pBUF, LEN, TYPE, PATH, pOUT)                               \
+    ([&]() -> bool {                                                       \
+        static_assert(std::is_same<decltype(((TYPE*)0)->PATH),             \
+                      typename std::remove_pointer<decltype(pOUT)>::type>::value, \
+                      "ps_peek output does not match type of " #TYPE "." #PATH); \
+        size_t _len = (LEN);                                               \
+        size_t _off = (_len >= sizeof(uint32_t)) ? ps_seek_##TYPE((pBUF) + sizeof(uint32_t), \
+                        _len - sizeof(uint32_t), 0, #PATH) : PS_VAL_FAIL;  \
+        return _off != PS_VAL_FAIL && ps_deserialize_at(pBUF, _off, pOUT, _len); \
+    }())
+
 
 // Generate C++ overloads for all message types
 BASE_TYPES_LIST(PS_CPP_SER_OVERLOAD)
@@ -483,33 +1440,55 @@ MSG_LIST(PS_UNUSED, PS_CPP_DES_OVERLOAD, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNU
 #define PS_CPP_SRV_SER_OVERLOAD(TYPE, NAME, HASH, ...)                     \
     inline size_t ps_serialize(uint8_t* pBUF, request_##TYPE* pMSG, size_t MAX) { \
         ucdrBuffer writer = {};                                             \
-        *((uint32_t*)pBUF) = 0x0100;                                        \
+        PS_CDR_HEADER(pBUF);                                                \
         ucdr_init_buffer(&writer, pBUF + sizeof(uint32_t),                  \
                         MAX - sizeof(uint32_t));                            \
         ps_ser_##TYPE##_request(&writer, pMSG);                             \
-        return ucdr_buffer_length(&writer) + sizeof(uint32_t);              \
+        return writer.error ? 0 : ucdr_buffer_length(&writer) + sizeof(uint32_t); \
     }                                                                       \
     inline size_t ps_serialize(uint8_t* pBUF, reply_##TYPE* pMSG, size_t MAX) { \
         ucdrBuffer writer = {};                                             \
-        *((uint32_t*)pBUF) = 0x0100;                                        \
+        PS_CDR_HEADER(pBUF);                                                \
         ucdr_init_buffer(&writer, pBUF + sizeof(uint32_t),                  \
                         MAX - sizeof(uint32_t));                            \
         ps_ser_##TYPE##_reply(&writer, pMSG);                               \
-        return ucdr_buffer_length(&writer) + sizeof(uint32_t);              \
+        return writer.error ? 0 : ucdr_buffer_length(&writer) + sizeof(uint32_t); \
+    }                                                                       \
+    inline size_t ps_serialized_size(request_##TYPE* pMSG) {                \
+        return ps_size_##TYPE##_request(0, pMSG) + sizeof(uint32_t);        \
+    }                                                                       \
+    inline size_t ps_serialized_size(reply_##TYPE* pMSG) {                  \
+        return ps_size_##TYPE##_reply(0, pMSG) + sizeof(uint32_t);          \
+    }                                                                       \
+    inline bool ps_validate(const uint8_t* pBUF, request_##TYPE*, size_t MAX) { \
+        return MAX >= sizeof(uint32_t) && ps_val_##TYPE##_request(pBUF + sizeof(uint32_t), \
+                        MAX - sizeof(uint32_t), 0) != PS_VAL_FAIL;          \
+    }                                                                       \
+    inline bool ps_validate(const uint8_t* pBUF, reply_##TYPE*, size_t MAX) { \
+        return MAX >= sizeof(uint32_t) && ps_val_##TYPE##_reply(pBUF + sizeof(uint32_t), \
+                        MAX - sizeof(uint32_t), 0) != PS_VAL_FAIL;          \
     }
 
 #define PS_CPP_SRV_DES_OVERLOAD(TYPE, NAME, HASH, ...)                      \
-    inline bool ps_deserialize(uint8_t* pBUF, request_##TYPE* pMSG, size_t MAX) { \
+    inline bool ps_deserialize_arena(uint8_t* pBUF, request_##TYPE* pMSG, size_t MAX, ps_arena_t* arena) { \
         ucdrBuffer reader = {};                                             \
-        ucdr_init_buffer(&reader, pBUF + sizeof(uint32_t),                  \
-                        MAX - sizeof(uint32_t));                            \
+        ucdr_init_buffer_origin_offset_endian(&reader, pBUF + sizeof(uint32_t), \
+                        MAX - sizeof(uint32_t), 0, 0, PS_CDR_ENDIANNESS(pBUF)); \
+        reader.args = arena;                                                \
         return ps_des_##TYPE##_request(&reader, pMSG);                      \
     }                                                                       \
-    inline bool ps_deserialize(uint8_t* pBUF, reply_##TYPE* pMSG, size_t MAX) { \
+    inline bool ps_deserialize_arena(uint8_t* pBUF, reply_##TYPE* pMSG, size_t MAX, ps_arena_t* arena) { \
         ucdrBuffer reader = {};                                             \
-        ucdr_init_buffer(&reader, pBUF + sizeof(uint32_t),                  \
-                        MAX - sizeof(uint32_t));                            \
+        ucdr_init_buffer_origin_offset_endian(&reader, pBUF + sizeof(uint32_t), \
+                        MAX - sizeof(uint32_t), 0, 0, PS_CDR_ENDIANNESS(pBUF)); \
+        reader.args = arena;                                                \
         return ps_des_##TYPE##_reply(&reader, pMSG);                        \
+    }                                                                       \
+    inline bool ps_deserialize(uint8_t* pBUF, request_##TYPE* pMSG, size_t MAX) { \
+        return ps_deserialize_arena(pBUF, pMSG, MAX, NULL);                 \
+    }                                                                       \
+    inline bool ps_deserialize(uint8_t* pBUF, reply_##TYPE* pMSG, size_t MAX) { \
+        return ps_deserialize_arena(pBUF, pMSG, MAX, NULL);                 \
     }
 
 // Generate C++ overloads for all service types
@@ -0,0 +1,530 @@
+/*******************************************************************************
+ * @file    picoserdes.hpp
+ * @brief   Pico CDR header only C++ serializer
+ * @date    2026-Oct-16
+ *
+ * @details C++17 front end of picoserdes. Each MSG_LIST and SRV_LIST type gets a
+ *          picoserdes::traits<> specialization generated from the same type list as the C
+ *          library, and picoserdes::Serializer<> templates walk the message members at compile
+ *          time. Whole messages are inlined into the caller, so member offsets and alignment
+ *          padding of fixed size messages are folded to constants. Messages with bounded size
+ *          (see PS_MAX_SIZE()) are written without per member bounds checks when the output
+ *          buffer is large enough.
+ *
+ *          Output is byte identical to ps_serialize() and deserialization follows ps_deserialize()
+ *          rules for strings and sequences (views into buffer, caller provided storage or arena).
+ *          Only host endianness is written, same as C path. Messages in foreign byte order are
+ *          read with ps_bswap() of every copied value.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+#ifndef PICOSERDES_HPP
+#define PICOSERDES_HPP
+
+/* Exported includes ---------------------------------------------------------*/
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+#include "picoserdes.h"
+
+namespace picoserdes {
+
+/**
+ * @defgroup cpp_serdes C++ serializer
+ * @ingroup picoserdes
+ * @{
+ */
+
+#if defined(__cpp_lib_span)
+/** @brief Contiguous view of sequence elements */
+template<class T> using span = std::span<T>;
+#else
+/** @brief Contiguous view of sequence elements, std::span subset for C++17 */
+template<class T>
+class span {
+public:
+    constexpr span() noexcept : data_(nullptr), size_(0) {}
+    constexpr span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T& operator[](size_t i) const noexcept { return data_[i]; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+private:
+    T* data_;
+    size_t size_;
+};
+#endif
+
+/**
+ * @brief Bounded string stored inline, FIELD(rstring, NAME, BOUND) member is visited as
+ *        bounded_string<BOUND + 1>
+ */
+template<size_t N>
+struct bounded_string {
+    char data[N];   /**< Characters with terminator, N - 1 characters at most */
+};
+
+/** @brief View char array member as bounded string */
+template<size_t N>
+inline bounded_string<N>& as_bounded(char (&s)[N]) { return reinterpret_cast<bounded_string<N>&>(s); }
+template<size_t N>
+inline const bounded_string<N>& as_bounded(const char (&s)[N]) { return reinterpret_cast<const bounded_string<N>&>(s); }
+
+/**
+ * @brief Compile time description of message type
+ * @details Specializations for user types provide:
+ *          leaf - plain type mask, see ps_leaf_<TYPE>
+ *          max_size - serialized size limit including header, -1 if unbounded, see PS_MAX_SIZE()
+ *          visit(msg, f) - calls f for every member in CDR order
+ */
+template<class T>
+struct traits {
+    static constexpr bool message = false;
+};
+
+// Traits generation macros
+#define PS_HPP_FIELD(TYPE, ...) PS_BOUNDED(PS_HPP_MEMBER, PS_HPP_STRING, __VA_ARGS__)(TYPE, __VA_ARGS__)
+#define PS_HPP_MEMBER(TYPE, NAME, ...) f(msg.NAME);
+#define PS_HPP_STRING(TYPE, NAME, BOUND) f(as_bounded(msg.NAME));
+#define PS_HPP_MEMBERS(...) __VA_ARGS__
+#define PS_HPP_TRAITS(TYPE, LEAF, ...)                                     \
+    template<>                                                             \
+    struct traits<TYPE> {                                                  \
+        static constexpr bool message = true;                              \
+        static constexpr unsigned leaf = LEAF;                             \
+        static constexpr long max_size = PS_MAX_SIZE(TYPE);                \
+        template<class M, class F>                                         \
+        static inline __attribute__((always_inline)) void visit(M& msg, F&& f) { \
+            (void)msg; (void)f; __VA_ARGS__                                \
+        }                                                                  \
+    };
+#define PS_HPP_CTYPE(TYPE, NAME, HASH, ...) PS_HPP_TRAITS(TYPE, ps_leaf_##TYPE, __VA_ARGS__)
+#define PS_HPP_SRV(TYPE, NAME, HASH, REQ, REP)                             \
+    PS_HPP_TRAITS(request_##TYPE, PS_LEAF_NOT_PLAIN, REQ)                  \
+    PS_HPP_TRAITS(reply_##TYPE, PS_LEAF_NOT_PLAIN, REP)
+
+MSG_LIST(PS_UNUSED, PS_HPP_CTYPE, PS_UNUSED, PS_HPP_FIELD, PS_HPP_MEMBER, PS_HPP_MEMBER)
+SRV_LIST(PS_HPP_SRV, PS_HPP_MEMBERS, PS_HPP_MEMBERS, PS_HPP_FIELD, PS_HPP_MEMBER, PS_HPP_MEMBER)
+
+#undef PS_HPP_FIELD
+#undef PS_HPP_MEMBER
+#undef PS_HPP_STRING
+#undef PS_HPP_MEMBERS
+#undef PS_HPP_TRAITS
+#undef PS_HPP_CTYPE
+#undef PS_HPP_SRV
+
+/** @brief True for <TYPE>_sequence structures */
+template<class T, class = void>
+struct is_sequence : std::false_type {};
+template<class T>
+struct is_sequence<T, std::void_t<decltype(std::declval<T&>().data), decltype(std::declval<T&>().n_elements)>>
+    : std::is_pointer<decltype(std::declval<T&>().data)> {};
+
+/** @brief True for bounded sequences stored inline, data array followed by n_elements */
+template<class T, class = void>
+struct is_inline_sequence : std::false_type {};
+template<class T>
+struct is_inline_sequence<T, std::void_t<decltype(std::declval<T&>().data), decltype(std::declval<T&>().n_elements)>>
+    : std::is_array<decltype(std::declval<T&>().data)> {};
+
+/** @brief True for types copied with one memcpy, see PS_IS_PLAIN() */
+template<class T, class = void>
+struct is_plain : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+template<class T>
+struct is_plain<T, std::enable_if_t<traits<T>::message>>
+    : std::integral_constant<bool, PS_IS_PLAIN(traits<T>::leaf)> {};
+
+/** @brief CDR alignment of plain type */
+template<class T>
+constexpr size_t plain_align() {
+    if constexpr (traits<T>::message) { return PS_PLAIN_ALIGN(traits<T>::leaf); }
+    else { return sizeof(T); }
+}
+
+/**
+ * @brief CDR output cursor
+ * @tparam Checked false if caller guarantees that whole message fits into buffer
+ */
+template<bool Checked>
+struct Writer {
+    uint8_t* origin;    /**< Start of CDR data, alignment is relative to it */
+    uint8_t* pos;       /**< Write position */
+    uint8_t* end;       /**< End of buffer */
+    bool ok;            /**< False after overflow */
+
+    /** @brief Skip alignment padding and reserve n bytes, nullptr on overflow */
+    inline __attribute__((always_inline)) uint8_t* reserve(size_t align, size_t n) {
+        size_t pad = (align - (size_t)(pos - origin) % align) & (align - 1);
+        if (Checked && (!ok || (size_t)(end - pos) < pad + n)) {
+            ok = false;
+            return nullptr;
+        }
+        uint8_t* p = pos + pad;
+        pos = p + n;
+        return p;
+    }
+    /** @brief Write n bytes aligned to align */
+    inline __attribute__((always_inline)) void put(const void* data, size_t align, size_t n) {
+        uint8_t* p = reserve(align, n);
+        if (p != nullptr) { memcpy(p, data, n); }
+    }
+    /** @brief Write block of plain elements, copied by pool threads when built with PS_PARALLEL */
+    inline void put_block(const void* data, size_t align, size_t n) {
+#ifdef PS_PARALLEL
+        uint8_t* p = reserve(align, n);
+        if (p != nullptr) { ps_copy_plain(p, data, n, align, false); }
+#else
+        put(data, align, n);
+#endif
+    }
+    inline __attribute__((always_inline)) void put_count(uint32_t n) {
+        put(&n, sizeof(n), sizeof(n));
+    }
+};
+
+/** @brief CDR input cursor, always bounds checked */
+struct Reader {
+    uint8_t* origin;    /**< Start of CDR data, alignment is relative to it */
+    uint8_t* pos;       /**< Read position */
+    uint8_t* end;       /**< End of buffer */
+    ps_arena_t* arena;  /**< Storage for sequences without data, can be NULL */
+    bool ok;            /**< False after error */
+    bool swap;          /**< Data is in foreign byte order */
+
+    /** @brief Skip alignment padding and consume n bytes, nullptr if not available */
+    inline __attribute__((always_inline)) uint8_t* take(size_t align, size_t n) {
+        size_t pad = (align - (size_t)(pos - origin) % align) & (align - 1);
+        if (!ok || (size_t)(end - pos) < pad || (size_t)(end - pos) - pad < n) {
+            ok = false;
+            return nullptr;
+        }
+        uint8_t* p = pos + pad;
+        pos = p + n;
+        return p;
+    }
+    /** @brief Read n bytes aligned to align, align is also size of swapped values */
+    inline __attribute__((always_inline)) void get(void* data, size_t align, size_t n) {
+        uint8_t* p = take(align, n);
+        if (p != nullptr) { memcpy(data, p, n); }
+        if (swap && p != nullptr && align > 1) { ps_bswap(data, n / align, align); }
+    }
+    /** @brief Read block of plain elements, copied by pool threads when built with PS_PARALLEL */
+    inline void get_block(void* data, size_t align, size_t n) {
+#ifdef PS_PARALLEL
+        uint8_t* p = take(align, n);
+        if (p != nullptr) { ps_copy_plain(data, p, n, align, swap); }
+#else
+        get(data, align, n);
+#endif
+    }
+    inline __attribute__((always_inline)) uint32_t get_count() {
+        uint32_t n = 0;
+        get(&n, sizeof(n), sizeof(n));
+        return n;
+    }
+    size_t remaining() const { return (size_t)(end - pos); }
+};
+
+/**
+ * @brief Compile time serializer of type T
+ * @details Specializations provide write(Writer&, const T&) and read(Reader&, T&).
+ */
+template<class T, class = void>
+struct Serializer;
+
+// Primitive types
+template<class T>
+struct Serializer<T, std::enable_if_t<std::is_arithmetic<T>::value>> {
+    template<class W>
+    static inline __attribute__((always_inline)) void write(W& w, const T& v) {
+        w.put(&v, sizeof(T), sizeof(T));
+    }
+    static inline __attribute__((always_inline)) void read(Reader& r, T& v) {
+        if constexpr (std::is_same<T, bool>::value) {
+            uint8_t* p = r.take(1, 1);
+            if (p != nullptr) { v = (*p != 0); }
+        }
+        else {
+            r.get(&v, sizeof(T), sizeof(T));
+        }
+    }
+};
+
+// Strings, length with terminator followed by characters
+template<>
+struct Serializer<rstring> {
+    template<class W>
+    static inline void write(W& w, const rstring& v) {
+        if (v == nullptr) {
+            w.put_count(0);
+            return;
+        }
+        uint32_t len = (uint32_t)strlen(v) + 1;
+        w.put_count(len);
+        w.put(v, 1, len);
+    }
+    static inline void read(Reader& r, rstring& v) {
+        uint32_t len = r.get_count();
+        uint8_t* p = r.take(1, len);
+        if (p != nullptr) { v = (char*)p; }
+    }
+};
+
+// Bounded strings, same CDR as rstring, longer strings are rejected
+template<size_t N>
+struct Serializer<bounded_string<N>> {
+    template<class W>
+    static inline void write(W& w, const bounded_string<N>& v) {
+        uint32_t len = (uint32_t)strnlen(v.data, N) + 1;
+        if (len > N) {
+            w.ok = false;
+            return;
+        }
+        w.put_count(len);
+        w.put(v.data, 1, len);
+    }
+    static inline void read(Reader& r, bounded_string<N>& v) {
+        uint32_t len = r.get_count();
+        uint8_t* p = (len <= N) ? r.take(1, len) : nullptr;
+        if (p == nullptr) {
+            r.ok = false;
+            return;
+        }
+        memcpy(v.data, p, len);
+        v.data[N - 1] = '\0';
+    }
+};
+
+// Fixed size arrays, string arrays carry element count
+template<class T, size_t N>
+struct Serializer<T[N]> {
+    template<class W>
+    static inline __attribute__((always_inline)) void write(W& w, const T (&v)[N]) {
+        if constexpr (std::is_same<T, rstring>::value) {
+            w.put_count((uint32_t)N);
+        }
+        if constexpr (is_plain<T>::value) {
+            w.put(v, plain_align<T>(), sizeof(v));
+        }
+        else {
+            for (const T& e : v) { Serializer<T>::write(w, e); }
+        }
+    }
+    static inline __attribute__((always_inline)) void read(Reader& r, T (&v)[N]) {
+        if constexpr (std::is_same<T, rstring>::value) {
+            uint32_t n = r.get_count();
+            if (n > N) { r.ok = false; return; }
+            for (uint32_t i = 0; i < n && r.ok; i++) { Serializer<T>::read(r, v[i]); }
+        }
+        else if constexpr (is_plain<T>::value) {
+            r.get(v, plain_align<T>(), sizeof(v));
+        }
+        else {
+            for (T& e : v) { Serializer<T>::read(r, e); }
+        }
+    }
+};
+
+// Sequences, element count followed by elements
+template<class S>
+struct Serializer<S, std::enable_if_t<is_sequence<S>::value>> {
+    using T = std::remove_pointer_t<decltype(S::data)>;
+
+    template<class W>
+    static inline void write(W& w, const S& v) {
+        w.put_count(v.n_elements);
+        if constexpr (is_plain<T>::value) {
+            if (v.n_elements > 0) { w.put_block(v.data, plain_align<T>(), v.n_elements * sizeof(T)); }
+        }
+        else {
+            for (uint32_t i = 0; i < v.n_elements; i++) { Serializer<T>::write(w, v.data[i]); }
+        }
+    }
+    static inline void read(Reader& r, S& v) {
+        uint32_t n = r.get_count();
+        // every element takes at least one byte of buffer, reject corrupted lengths early
+        if (!r.ok || n > r.remaining()) {
+            r.ok = false;
+            return;
+        }
+        if (v.data == nullptr) {
+            if (n == 0) {
+                // Empty sequence needs no storage
+                v.n_elements = 0;
+                return;
+            }
+            if constexpr (is_plain<T>::value) {
+                // Point into reader buffer when aligned and in host byte order
+                size_t pad = (plain_align<T>() - (size_t)(r.pos - r.origin) % plain_align<T>())
+                             & (plain_align<T>() - 1);
+                uint8_t* p = r.pos + pad;
+                if (p > r.end || (size_t)(r.end - p) / sizeof(T) < n) {
+                    r.ok = false;
+                    return;
+                }
+                if ((uintptr_t)p % plain_align<T>() == 0 && !r.swap) {
+                    v.data = (T*)p;
+                    v.n_elements = n;
+                    r.pos = p + (size_t)n * sizeof(T);
+                    return;
+                }
+            }
+            v.data = (r.arena != nullptr) ? (T*)ps_arena_alloc(r.arena, n, sizeof(T), alignof(T)) : nullptr;
+            if (v.data == nullptr) {
+                r.ok = false;
+                return;
+            }
+        }
+        else if (n > v.n_elements) {
+            r.ok = false;
+            return;
+        }
+        v.n_elements = n;
+        if constexpr (is_plain<T>::value) {
+            if (n > 0) { r.get_block(v.data, plain_align<T>(), (size_t)n * sizeof(T)); }
+        }
+        else {
+            for (uint32_t i = 0; i < n && r.ok; i++) { Serializer<T>::read(r, v.data[i]); }
+        }
+    }
+};
+
+// Bounded sequences stored inline, element count followed by at most bound elements
+template<class S>
+struct Serializer<S, std::enable_if_t<is_inline_sequence<S>::value>> {
+    using T = std::remove_extent_t<decltype(S::data)>;
+    static constexpr uint32_t bound = std::extent<decltype(S::data)>::value;
+
+    template<class W>
+    static inline void write(W& w, const S& v) {
+        if (v.n_elements > bound) {
+            w.ok = false;
+            return;
+        }
+        w.put_count(v.n_elements);
+        if constexpr (is_plain<T>::value) {
+            if (v.n_elements > 0) { w.put_block(v.data, plain_align<T>(), v.n_elements * sizeof(T)); }
+        }
+        else {
+            for (uint32_t i = 0; i < v.n_elements; i++) { Serializer<T>::write(w, v.data[i]); }
+        }
+    }
+    static inline void read(Reader& r, S& v) {
+        uint32_t n = r.get_count();
+        v.n_elements = 0;
+        if (!r.ok || n > bound) {
+            r.ok = false;
+            return;
+        }
+        v.n_elements = n;
+        if constexpr (is_plain<T>::value) {
+            if (n > 0) { r.get_block(v.data, plain_align<T>(), (size_t)n * sizeof(T)); }
+        }
+        else {
+            for (uint32_t i = 0; i < n && r.ok; i++) { Serializer<T>::read(r, v.data[i]); }
+        }
+    }
+};
+
+// User message types, members in declaration order
+template<class T>
+struct Serializer<T, std::enable_if_t<traits<T>::message>> {
+    template<class W>
+    static inline __attribute__((always_inline)) void write(W& w, const T& v) {
+        if constexpr (is_plain<T>::value) {
+            w.put(&v, plain_align<T>(), sizeof(T));
+        }
+        else {
+            traits<T>::visit(v, [&w](const auto& m) {
+                Serializer<std::remove_cv_t<std::remove_reference_t<decltype(m)>>>::write(w, m);
+            });
+        }
+    }
+    static inline __attribute__((always_inline)) void read(Reader& r, T& v) {
+        if constexpr (is_plain<T>::value) {
+            r.get(&v, plain_align<T>(), sizeof(T));
+        }
+        else {
+            traits<T>::visit(v, [&r](auto& m) {
+                Serializer<std::remove_reference_t<decltype(m)>>::read(r, m);
+            });
+        }
+    }
+};
+
+/**
+ * @brief Serialized size limit of message including header
+ * @return Size in bytes, -1 for types with strings or sequences
+ */
+template<class T>
+constexpr long max_size() {
+    if constexpr (traits<T>::message) { return traits<T>::max_size; }
+    else { return -1; }
+}
+
+/**
+ * @brief Serialize message into buffer, output is identical to ps_serialize()
+ * @param buf Output buffer
+ * @param msg Message
+ * @param max Size of output buffer
+ * @return Number of bytes written, 0 if message does not fit into buffer
+ */
+template<class T>
+inline size_t serialize(uint8_t* buf, const T& msg, size_t max) {
+    if (max < sizeof(uint32_t)) {
+        return 0;
+    }
+    PS_CDR_HEADER(buf);
+    if constexpr (max_size<T>() > 0) {
+        // Buffer large enough for any value of T, no bounds checks
+        if (max >= (size_t)max_size<T>()) {
+            Writer<false> w = {buf + sizeof(uint32_t), buf + sizeof(uint32_t), buf + max, true};
+            Serializer<T>::write(w, msg);
+            return w.ok ? (size_t)(w.pos - buf) : 0; // bounded members over their bound
+        }
+    }
+    Writer<true> w = {buf + sizeof(uint32_t), buf + sizeof(uint32_t), buf + max, true};
+    Serializer<T>::write(w, msg);
+    return w.ok ? (size_t)(w.pos - buf) : 0;
+}
+
+/**
+ * @brief Deserialize message from buffer, same rules as ps_deserialize_arena()
+ * @param buf Serialized data including header
+ * @param msg Output message, strings and sequences without storage point into buf
+ * @param len Length of serialized data
+ * @param arena Storage for sequences that can not point into buf, can be NULL
+ * @return true on success
+ */
+template<class T>
+inline bool deserialize(uint8_t* buf, T& msg, size_t len, ps_arena_t* arena = nullptr) {
+    if (len < sizeof(uint32_t)) {
+        return false;
+    }
+    Reader r = {buf + sizeof(uint32_t), buf + sizeof(uint32_t), buf + len, arena, true,
+                PS_CDR_ENDIANNESS(buf) != UCDR_MACHINE_ENDIANNESS};
+    Serializer<T>::read(r, msg);
+    return r.ok;
+}
+
+/**
+ * @brief View sequence elements as span
+ * @param seq <TYPE>_sequence structure
+ */
+template<class S, class = std::enable_if_t<is_sequence<S>::value>>
+inline auto as_span(const S& seq) -> span<std::remove_pointer_t<decltype(S::data)>> {
+    return {seq.data, seq.n_elements};
+}
+
+/** @} */
+
+} // namespace picoserdes
+
+#endif /* PICOSERDES_HPP */
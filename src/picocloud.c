@@ -0,0 +1,344 @@
+/*******************************************************************************
+ * @file    picocloud.c
+ * @brief   Pico-ROS PointCloud2 packing helpers implementation
+ * @date    2026-Oct-16
+ *
+ * @details Channels are resolved against ros_PointField layout and sorted by offset in
+ *          point. Runs of 2 to 4 consecutive 4 byte fields are moved as 4x4 transposes of
+ *          32 bit lanes, missing lanes of packed run are written as zero and overwritten by
+ *          following fields. Lanes are moved as bit patterns, so any 4 byte field type works.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+/* Private includes ----------------------------------------------------------*/
+#include "picocloud.h"
+#include <string.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+/* Private typedef -----------------------------------------------------------*/
+// Channel resolved against point field
+typedef struct {
+    uint8_t*        data;           // channel array
+    uint32_t        offset;         // offset of field in point
+    uint32_t        size;           // bytes of field per point, datatype size * count
+    uint32_t        elem;           // datatype size
+} pc_slot_t;
+/* Private define ------------------------------------------------------------*/
+// Transposed runs are made of 4 byte fields, at most 4 of them fill one 16 byte vector
+#define PC_LANE 4u
+#define PC_RUN_MAX 4u
+/* Private macro -------------------------------------------------------------*/
+#if defined(__AVX2__)
+// Transpose 4x4 blocks of 32 bit lanes in both 128 bit halves, same operation packs and unpacks
+#define PC_TRANSPOSE8(V0, V1, V2, V3)                                               \
+    do {                                                                            \
+        __m256 _t0 = _mm256_unpacklo_ps(V0, V1);                                    \
+        __m256 _t1 = _mm256_unpackhi_ps(V0, V1);                                    \
+        __m256 _t2 = _mm256_unpacklo_ps(V2, V3);                                    \
+        __m256 _t3 = _mm256_unpackhi_ps(V2, V3);                                    \
+        V0 = _mm256_shuffle_ps(_t0, _t2, 0x44);                                     \
+        V1 = _mm256_shuffle_ps(_t0, _t2, 0xEE);                                     \
+        V2 = _mm256_shuffle_ps(_t1, _t3, 0x44);                                     \
+        V3 = _mm256_shuffle_ps(_t1, _t3, 0xEE);                                     \
+    } while (0)
+#endif
+/* Private constants ---------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+// Resolve channels into slots sorted by offset, check that fields fit point and do not overlap
+static bool pc_resolve(const ros_PointCloud2* msg, const pc_channel_t* channels, uint32_t n,
+                       pc_slot_t* slots, size_t* n_points){
+    uint64_t points = (uint64_t)msg->width * msg->height;
+    if (n > PC_MAX_CHANNELS || msg->point_step == 0 || points * msg->point_step > SIZE_MAX){
+        return false;
+    }
+    for (uint32_t c = 0; c < n; c++){
+        const ros_PointField* field = NULL;
+        for (uint32_t f = 0; f < msg->fields.n_elements && field == NULL; f++){
+            const char* name = msg->fields.data[f].name;
+            field = (name != NULL && channels[c].name != NULL && strcmp(name, channels[c].name) == 0)
+                ? &msg->fields.data[f] : NULL;
+        }
+        if (field == NULL || (points > 0 && channels[c].data == NULL)){
+            return false;
+        }
+        pc_slot_t slot = {
+            .data = (uint8_t*)channels[c].data,
+            .offset = field->offset,
+            .elem = pc_datatype_size(field->datatype),
+        };
+        uint64_t size = (uint64_t)slot.elem * field->count;
+        if (slot.elem == 0 || size == 0 || slot.offset + size > msg->point_step){
+            return false;
+        }
+        slot.size = (uint32_t)size;
+        uint32_t i = c;
+        for (; i > 0 && slots[i - 1].offset > slot.offset; i--){
+            slots[i] = slots[i - 1];
+        }
+        slots[i] = slot;
+    }
+    for (uint32_t i = 1; i < n; i++){
+        if (slots[i - 1].offset + slots[i - 1].size > slots[i].offset){
+            return false;
+        }
+    }
+    *n_points = (size_t)points;
+    return true;
+}
+
+// Number of slots from i forming run of consecutive 4 byte fields whose vector fits point
+static uint32_t pc_run(const pc_slot_t* slots, uint32_t i, uint32_t n, uint32_t step){
+    uint32_t k = 0;
+    while (i + k < n && k < PC_RUN_MAX && slots[i + k].size == PC_LANE
+           && slots[i + k].offset == slots[i].offset + k * PC_LANE){
+        k++;
+    }
+    return (k > 1 && slots[i].offset + PC_RUN_MAX * PC_LANE <= step) ? k : 1;
+}
+
+/* ----- packing -------------------------------------------------------------*/
+
+// Interleave up to 4 lanes into 16 bytes of each point, NULL lanes are zero
+static void pc_pack_run(uint8_t* dst, uint32_t step, const uint8_t* const* src, size_t n_points){
+    size_t p = 0;
+#if defined(__AVX2__)
+    for (; p + 8 <= n_points; p += 8){
+        __m256 v0 = (src[0] != NULL) ? _mm256_loadu_ps((const float*)&src[0][p * PC_LANE]) : _mm256_setzero_ps();
+        __m256 v1 = (src[1] != NULL) ? _mm256_loadu_ps((const float*)&src[1][p * PC_LANE]) : _mm256_setzero_ps();
+        __m256 v2 = (src[2] != NULL) ? _mm256_loadu_ps((const float*)&src[2][p * PC_LANE]) : _mm256_setzero_ps();
+        __m256 v3 = (src[3] != NULL) ? _mm256_loadu_ps((const float*)&src[3][p * PC_LANE]) : _mm256_setzero_ps();
+        PC_TRANSPOSE8(v0, v1, v2, v3);
+        uint8_t* d = &dst[p * step];
+        _mm_storeu_ps((float*)&d[0 * step], _mm256_castps256_ps128(v0));
+        _mm_storeu_ps((float*)&d[1 * step], _mm256_castps256_ps128(v1));
+        _mm_storeu_ps((float*)&d[2 * step], _mm256_castps256_ps128(v2));
+        _mm_storeu_ps((float*)&d[3 * step], _mm256_castps256_ps128(v3));
+        _mm_storeu_ps((float*)&d[4 * step], _mm256_extractf128_ps(v0, 1));
+        _mm_storeu_ps((float*)&d[5 * step], _mm256_extractf128_ps(v1, 1));
+        _mm_storeu_ps((float*)&d[6 * step], _mm256_extractf128_ps(v2, 1));
+        _mm_storeu_ps((float*)&d[7 * step], _mm256_extractf128_ps(v3, 1));
+    }
+#endif
+#if defined(__SSE__)
+    for (; p + 4 <= n_points; p += 4){
+        __m128 v0 = (src[0] != NULL) ? _mm_loadu_ps((const float*)&src[0][p * PC_LANE]) : _mm_setzero_ps();
+        __m128 v1 = (src[1] != NULL) ? _mm_loadu_ps((const float*)&src[1][p * PC_LANE]) : _mm_setzero_ps();
+        __m128 v2 = (src[2] != NULL) ? _mm_loadu_ps((const float*)&src[2][p * PC_LANE]) : _mm_setzero_ps();
+        __m128 v3 = (src[3] != NULL) ? _mm_loadu_ps((const float*)&src[3][p * PC_LANE]) : _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+        uint8_t* d = &dst[p * step];
+        _mm_storeu_ps((float*)&d[0 * step], v0);
+        _mm_storeu_ps((float*)&d[1 * step], v1);
+        _mm_storeu_ps((float*)&d[2 * step], v2);
+        _mm_storeu_ps((float*)&d[3 * step], v3);
+    }
+#endif
+    for (; p < n_points; p++){
+        for (uint32_t l = 0; l < PC_RUN_MAX; l++){
+            if (src[l] != NULL){
+                memcpy(&dst[p * step + l * PC_LANE], &src[l][p * PC_LANE], PC_LANE);
+            }
+            else {
+                memset(&dst[p * step + l * PC_LANE], 0, PC_LANE);
+            }
+        }
+    }
+}
+
+// Copy one field into every point, constant sizes let compiler inline copies
+static void pc_pack_slot(uint8_t* dst, uint32_t step, const pc_slot_t* slot, size_t n_points){
+    uint8_t* d = &dst[slot->offset];
+    const uint8_t* s = slot->data;
+    switch (slot->size){
+        case 1: for (size_t p = 0; p < n_points; p++){ d[p * step] = s[p]; } break;
+        case 2: for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * step], &s[p * 2], 2); } break;
+        case 4: for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * step], &s[p * 4], 4); } break;
+        case 8: for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * step], &s[p * 8], 8); } break;
+        default:
+            for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * step], &s[p * slot->size], slot->size); }
+    }
+}
+
+/* ----- unpacking -----------------------------------------------------------*/
+
+// De-interleave 16 bytes of each point into k lanes
+static void pc_unpack_run(const uint8_t* src, uint32_t step, uint8_t* const* dst, uint32_t k, size_t n_points){
+    size_t p = 0;
+#if defined(__AVX2__)
+    for (; p + 8 <= n_points; p += 8){
+        const uint8_t* s = &src[p * step];
+        __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)&s[0 * step])),
+                                         _mm_loadu_ps((const float*)&s[4 * step]), 1);
+        __m256 v1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)&s[1 * step])),
+                                         _mm_loadu_ps((const float*)&s[5 * step]), 1);
+        __m256 v2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)&s[2 * step])),
+                                         _mm_loadu_ps((const float*)&s[6 * step]), 1);
+        __m256 v3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)&s[3 * step])),
+                                         _mm_loadu_ps((const float*)&s[7 * step]), 1);
+        PC_TRANSPOSE8(v0, v1, v2, v3);
+        __m256 v[PC_RUN_MAX] = {v0, v1, v2, v3};
+        for (uint32_t l = 0; l < k; l++){
+            _mm256_storeu_ps((float*)&dst[l][p * PC_LANE], v[l]);
+        }
+    }
+#endif
+#if defined(__SSE__)
+    for (; p + 4 <= n_points; p += 4){
+        const uint8_t* s = &src[p * step];
+        __m128 v0 = _mm_loadu_ps((const float*)&s[0 * step]);
+        __m128 v1 = _mm_loadu_ps((const float*)&s[1 * step]);
+        __m128 v2 = _mm_loadu_ps((const float*)&s[2 * step]);
+        __m128 v3 = _mm_loadu_ps((const float*)&s[3 * step]);
+        _MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+        __m128 v[PC_RUN_MAX] = {v0, v1, v2, v3};
+        for (uint32_t l = 0; l < k; l++){
+            _mm_storeu_ps((float*)&dst[l][p * PC_LANE], v[l]);
+        }
+    }
+#endif
+    for (; p < n_points; p++){
+        for (uint32_t l = 0; l < k; l++){
+            memcpy(&dst[l][p * PC_LANE], &src[p * step + l * PC_LANE], PC_LANE);
+        }
+    }
+}
+
+// Copy one field of every point into its channel
+static void pc_unpack_slot(const uint8_t* src, uint32_t step, const pc_slot_t* slot, size_t n_points){
+    const uint8_t* s = &src[slot->offset];
+    uint8_t* d = slot->data;
+    switch (slot->size){
+        case 1: for (size_t p = 0; p < n_points; p++){ d[p] = s[p * step]; } break;
+        case 2: for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * 2], &s[p * step], 2); } break;
+        case 4: for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * 4], &s[p * step], 4); } break;
+        case 8: for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * 8], &s[p * step], 8); } break;
+        default:
+            for (size_t p = 0; p < n_points; p++){ memcpy(&d[p * slot->size], &s[p * step], slot->size); }
+    }
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+uint32_t pc_datatype_size(uint8_t datatype){
+    switch (datatype){
+        case PC_INT8:    case PC_UINT8:   return 1;
+        case PC_INT16:   case PC_UINT16:  return 2;
+        case PC_INT32:   case PC_UINT32:  case PC_FLOAT32: return 4;
+        case PC_FLOAT64: return 8;
+        default: return 0;
+    }
+}
+
+uint32_t pc_fields_init(ros_PointField* fields, uint32_t n){
+    uint32_t offset = 0;
+    uint32_t align = 1;
+    for (uint32_t f = 0; f < n; f++){
+        uint32_t size = pc_datatype_size(fields[f].datatype);
+        if (size == 0){
+            return 0;
+        }
+        offset = (offset + size - 1) & ~(size - 1);
+        fields[f].offset = offset;
+        offset += size * fields[f].count;
+        align = (size > align) ? size : align;
+    }
+    return (offset + align - 1) & ~(align - 1);
+}
+
+bool pc_pack(const ros_PointCloud2* msg, const pc_channel_t* channels, uint32_t n, uint8_t* dst){
+    pc_slot_t slots[PC_MAX_CHANNELS];
+    size_t n_points = 0;
+    if (!pc_resolve(msg, channels, n, slots, &n_points)){
+        return false;
+    }
+    uint32_t step = msg->point_step;
+    uint32_t covered = 0;
+    for (uint32_t i = 0; i < n; i++){
+        covered += slots[i].size;
+    }
+    if (covered < step){
+        memset(dst, 0, n_points * step);
+    }
+    for (uint32_t i = 0; i < n;){
+        uint32_t k = pc_run(slots, i, n, step);
+        if (k > 1){
+            const uint8_t* src[PC_RUN_MAX] = {NULL};
+            for (uint32_t l = 0; l < k; l++){
+                src[l] = slots[i + l].data;
+            }
+            pc_pack_run(&dst[slots[i].offset], step, src, n_points);
+        }
+        else {
+            pc_pack_slot(dst, step, &slots[i], n_points);
+        }
+        i += k;
+    }
+    return true;
+}
+
+bool pc_unpack(const ros_PointCloud2* msg, const pc_channel_t* channels, uint32_t n){
+    pc_slot_t slots[PC_MAX_CHANNELS];
+    size_t n_points = 0;
+    if (!pc_resolve(msg, channels, n, slots, &n_points)
+        || (n_points > 0 && msg->data.data == NULL)
+        || msg->data.n_elements / msg->point_step < n_points){
+        return false;
+    }
+    uint32_t step = msg->point_step;
+    for (uint32_t i = 0; i < n;){
+        uint32_t k = pc_run(slots, i, n, step);
+        if (k > 1){
+            uint8_t* dst[PC_RUN_MAX];
+            for (uint32_t l = 0; l < k; l++){
+                dst[l] = slots[i + l].data;
+            }
+            pc_unpack_run(&msg->data.data[slots[i].offset], step, dst, k, n_points);
+        }
+        else {
+            pc_unpack_slot(msg->data.data, step, &slots[i], n_points);
+        }
+        i += k;
+    }
+    if ((bool)msg->is_bigendian != PC_HOST_BIGENDIAN){
+        for (uint32_t i = 0; i < n; i++){
+            ps_bswap(slots[i].data, n_points * (slots[i].size / slots[i].elem), slots[i].elem);
+        }
+    }
+    return true;
+}
+
+size_t pc_serialize(uint8_t* buf, ros_PointCloud2* msg, const pc_channel_t* channels, uint32_t n, size_t max){
+    uint64_t size = (uint64_t)msg->point_step * msg->width * msg->height;
+    if (size > UINT32_MAX || max < sizeof(uint32_t)){
+        return 0;
+    }
+    msg->row_step = msg->point_step * msg->width;
+    msg->is_bigendian = PC_HOST_BIGENDIAN;
+
+    // Serialize cloud with empty data, then open gap for data at its position. Data is only
+    // followed by is_dense, so no padding after it depends on data size.
+    uint8_t_sequence data = msg->data;
+    msg->data = (uint8_t_sequence){.data = NULL, .n_elements = 0};
+    size_t len = ps_serialize(buf, msg, max);
+    msg->data = data;
+    if (len == 0 || size > max - len){
+        return 0;
+    }
+    size_t offset = ps_seek_ros_PointCloud2(buf + sizeof(uint32_t), len - sizeof(uint32_t), 0, "data");
+    if (offset == PS_VAL_FAIL){
+        return 0;
+    }
+    offset = sizeof(uint32_t) + ((offset + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1));
+    uint8_t* block = &buf[offset + sizeof(uint32_t)];
+    memmove(block + size, block, len - (offset + sizeof(uint32_t)));
+    uint32_t count = (uint32_t)size;
+    memcpy(&buf[offset], &count, sizeof(count));
+    return pc_pack(msg, channels, n, block) ? len + (size_t)size : 0;
+}
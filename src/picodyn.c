@@ -0,0 +1,828 @@
+/*******************************************************************************
+ * @file    picodyn.c
+ * @brief   Pico-ROS runtime dynamic types implementation
+ * @date    2026-Oct-16
+ *
+ * @details Type description JSON loader and schema walking CDR serializer. Values are
+ *          written with the same Micro-CDR calls and padding rules as picoserdes generated
+ *          code, so output matches it byte for byte.
+ *
+ * @copyright Copyright (c) 2025 Ubiquity Robotics
+ *******************************************************************************/
+
+/* Private includes ----------------------------------------------------------*/
+#include "picodyn.h"
+#include <stdio.h>
+#include <string.h>
+/* Private typedef -----------------------------------------------------------*/
+// JSON parser state, all loaded data goes to arena
+typedef struct {
+    const char*     p;
+    const char*     end;
+    ps_arena_t*     arena;
+    pd_type_t*      types;          // loaded and forward declared types
+} pd_json_t;
+
+// Schema walk state of one serialization or deserialization
+typedef struct {
+    ucdrBuffer      ub;
+    ps_arena_t*     arena;          // value tree storage, NULL in callback mode
+    pd_field_cb_t   cb;             // field callback, NULL in value tree mode
+    void*           ctx;
+    size_t          path_len;
+    char            path[PD_PATH_MAX];
+} pd_walk_t;
+/* Private define ------------------------------------------------------------*/
+// Maximum length of JSON object keys that are looked at
+#define PD_JSON_KEY_MAX 32
+// rosidl FIELD_TYPE_* ranges of arrays and sequences, element type is id - offset
+#define PD_ID_ARRAY_OFFSET       48
+#define PD_ID_BOUNDED_OFFSET     96
+#define PD_ID_UNBOUNDED_OFFSET   144
+#define PD_ID_BOUNDED_STRING     21
+// Prefix of RIHS01 hashes in type description JSON
+#define PD_HASH_PREFIX "RIHS01_"
+/* Private macro -------------------------------------------------------------*/
+#define PD_JSON_WS(j) while ((j)->p < (j)->end && (*(j)->p == ' ' || *(j)->p == '\n' || *(j)->p == '\r' || *(j)->p == '\t')) { (j)->p++; }
+/* Private constants ---------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static bool pd_ser_type(pd_walk_t* w, const pd_type_t* type, const pd_value_t* items);
+static bool pd_des_type(pd_walk_t* w, const pd_type_t* type, pd_value_t* value);
+static pd_value_t* pd_value_alloc(const pd_field_t* field, uint32_t n, ps_arena_t* arena);
+/* Private functions ---------------------------------------------------------*/
+
+/* ----- JSON loader ---------------------------------------------------------*/
+
+// Consume expected character
+static bool pd_json_char(pd_json_t* j, char c){
+    PD_JSON_WS(j);
+    if (j->p < j->end && *j->p == c){
+        j->p++;
+        return true;
+    }
+    return false;
+}
+
+// Peek next non white space character
+static char pd_json_peek(pd_json_t* j){
+    PD_JSON_WS(j);
+    return (j->p < j->end) ? *j->p : '\0';
+}
+
+// Parse string into out, copy to arena if out is NULL. Only ASCII \u escapes are supported.
+static char* pd_json_string(pd_json_t* j, char* out, size_t size){
+    if (!pd_json_char(j, '"')){
+        return NULL;
+    }
+    const char* start = j->p;
+    size_t len = 0;
+    // first pass finds length
+    for (const char* p = start; ; p++, len++){
+        if (p >= j->end){
+            return NULL;
+        }
+        if (*p == '"'){
+            break;
+        }
+        if (*p == '\\'){
+            p += (p + 1 < j->end && p[1] == 'u') ? 5 : 1;
+        }
+    }
+    if (out == NULL){
+        out = ps_arena_alloc(j->arena, len + 1, 1, 1);
+        size = len + 1;
+        if (out == NULL){
+            return NULL;
+        }
+    }
+    size_t n = 0;
+    while (*j->p != '"'){
+        char c = *j->p++;
+        if (c == '\\'){
+            c = *j->p++;
+            switch (c){
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'u': {
+                    unsigned v = 0;
+                    for (int i = 0; i < 4; i++){
+                        char h = *j->p++;
+                        v = v * 16 + ((h >= '0' && h <= '9') ? h - '0' : ((h | 0x20) - 'a' + 10));
+                    }
+                    c = (v < 0x80) ? (char)v : '?';
+                    break;
+                }
+                default: break; // \" \\ \/
+            }
+        }
+        if (n + 1 < size){
+            out[n++] = c;
+        }
+    }
+    out[n] = '\0';
+    j->p++;
+    return out;
+}
+
+// Parse unsigned integer
+static bool pd_json_uint(pd_json_t* j, uint32_t* out){
+    PD_JSON_WS(j);
+    uint64_t v = 0;
+    const char* start = j->p;
+    while (j->p < j->end && *j->p >= '0' && *j->p <= '9' && v <= UINT32_MAX){
+        v = v * 10 + (uint32_t)(*j->p++ - '0');
+    }
+    *out = (uint32_t)v;
+    return j->p > start && v <= UINT32_MAX;
+}
+
+// Skip any JSON value
+static bool pd_json_skip(pd_json_t* j){
+    char c = pd_json_peek(j);
+    if (c == '"'){
+        char dummy[1];
+        return pd_json_string(j, dummy, sizeof(dummy)) != NULL;
+    }
+    if (c == '{' || c == '['){
+        char close = (c == '{') ? '}' : ']';
+        j->p++;
+        if (pd_json_char(j, close)){
+            return true;
+        }
+        do {
+            if (c == '{'){
+                char key[1];
+                if (pd_json_string(j, key, sizeof(key)) == NULL || !pd_json_char(j, ':')){
+                    return false;
+                }
+            }
+            if (!pd_json_skip(j)){
+                return false;
+            }
+        } while (pd_json_char(j, ','));
+        return pd_json_char(j, close);
+    }
+    // number, true, false, null
+    const char* start = j->p;
+    while (j->p < j->end && *j->p != ',' && *j->p != '}' && *j->p != ']'
+           && *j->p != ' ' && *j->p != '\n' && *j->p != '\r' && *j->p != '\t'){
+        j->p++;
+    }
+    return j->p > start;
+}
+
+// Iterate object members: call with *first = true, returns false at end of object or on error
+static bool pd_json_member(pd_json_t* j, bool* first, char* key, bool* error){
+    if (*first){
+        *first = false;
+        if (!pd_json_char(j, '{')){
+            *error = true;
+            return false;
+        }
+        if (pd_json_char(j, '}')){
+            return false;
+        }
+    }
+    else if (!pd_json_char(j, ',')){
+        *error = !pd_json_char(j, '}');
+        return false;
+    }
+    if (pd_json_string(j, key, PD_JSON_KEY_MAX) == NULL || !pd_json_char(j, ':')){
+        *error = true;
+        return false;
+    }
+    return true;
+}
+
+// Iterate array elements: call with *first = true, returns false at end of array or on error
+static bool pd_json_element(pd_json_t* j, bool* first, bool* error){
+    if (*first){
+        *first = false;
+        if (!pd_json_char(j, '[')){
+            *error = true;
+            return false;
+        }
+        return !pd_json_char(j, ']');
+    }
+    if (!pd_json_char(j, ',')){
+        *error = !pd_json_char(j, ']');
+        return false;
+    }
+    return true;
+}
+
+// Find loaded type or forward declare it, undefined types have NULL fields
+static pd_type_t* pd_json_type(pd_json_t* j, const char* name){
+    for (pd_type_t* t = j->types; t != NULL; t = (pd_type_t*)t->next){
+        if (strcmp(t->name, name) == 0){
+            return t;
+        }
+    }
+    pd_type_t* t = ps_arena_alloc(j->arena, 1, sizeof(pd_type_t), _Alignof(pd_type_t));
+    size_t len = strlen(name);
+    char* copy = ps_arena_alloc(j->arena, len + 1, 1, 1);
+    if (t == NULL || copy == NULL){
+        return NULL;
+    }
+    memcpy(copy, name, len + 1);
+    t->name = copy;
+    t->next = j->types;
+    j->types = t;
+    return t;
+}
+
+// Map rosidl field type to element type, kind and capacity
+static bool pd_json_field_type(pd_field_t* field, uint32_t id, uint32_t capacity){
+    field->kind = PD_KIND_FIELD;
+    if (id > PD_ID_UNBOUNDED_OFFSET){
+        field->kind = PD_KIND_SEQUENCE;
+        id -= PD_ID_UNBOUNDED_OFFSET;
+        capacity = 0;
+    }
+    else if (id > PD_ID_BOUNDED_OFFSET){
+        field->kind = PD_KIND_SEQUENCE;
+        id -= PD_ID_BOUNDED_OFFSET;
+    }
+    else if (id > PD_ID_ARRAY_OFFSET){
+        field->kind = PD_KIND_ARRAY;
+        id -= PD_ID_ARRAY_OFFSET;
+    }
+    if (id == PD_ID_BOUNDED_STRING){
+        id = PD_TYPE_STRING; // bounded strings are serialized as strings
+    }
+    field->type = (uint8_t)id;
+    field->capacity = (field->kind == PD_KIND_FIELD) ? 0 : capacity;
+    switch (id){
+        case PD_TYPE_NESTED: case PD_TYPE_INT8: case PD_TYPE_UINT8: case PD_TYPE_INT16:
+        case PD_TYPE_UINT16: case PD_TYPE_INT32: case PD_TYPE_UINT32: case PD_TYPE_INT64:
+        case PD_TYPE_UINT64: case PD_TYPE_FLOAT32: case PD_TYPE_FLOAT64: case PD_TYPE_CHAR:
+        case PD_TYPE_BOOL: case PD_TYPE_BYTE: case PD_TYPE_STRING:
+            break;
+        default:
+            return false; // long double, wchar, wstring and fixed strings
+    }
+    return field->kind != PD_KIND_ARRAY || capacity > 0;
+}
+
+// Parse field object {"name", "type": {"type_id", "capacity", "nested_type_name"}}
+static bool pd_json_field(pd_json_t* j, pd_field_t* field){
+    char key[PD_JSON_KEY_MAX];
+    char nested[PD_PATH_MAX] = "";
+    uint32_t id = 0;
+    uint32_t capacity = 0;
+    bool first = true;
+    bool error = false;
+    while (pd_json_member(j, &first, key, &error)){
+        if (strcmp(key, "name") == 0){
+            field->name = pd_json_string(j, NULL, 0);
+            error = field->name == NULL;
+        }
+        else if (strcmp(key, "type") == 0){
+            bool first_type = true;
+            while (!error && pd_json_member(j, &first_type, key, &error)){
+                if (strcmp(key, "type_id") == 0){
+                    error = !pd_json_uint(j, &id);
+                }
+                else if (strcmp(key, "capacity") == 0){
+                    error = !pd_json_uint(j, &capacity);
+                }
+                else if (strcmp(key, "nested_type_name") == 0){
+                    error = pd_json_string(j, nested, sizeof(nested)) == NULL;
+                }
+                else {
+                    error = !pd_json_skip(j);
+                }
+            }
+        }
+        else {
+            error = !pd_json_skip(j);
+        }
+        if (error){
+            return false;
+        }
+    }
+    if (error || field->name == NULL || !pd_json_field_type(field, id, capacity)){
+        return false;
+    }
+    if (field->type == PD_TYPE_NESTED){
+        field->nested = (nested[0] != '\0') ? pd_json_type(j, nested) : NULL;
+        return field->nested != NULL;
+    }
+    return true;
+}
+
+// Parse individual type description {"type_name", "fields": [...]}, fields are counted first
+static pd_type_t* pd_json_description(pd_json_t* j){
+    char key[PD_JSON_KEY_MAX];
+    char name[PD_PATH_MAX] = "";
+    const char* fields = NULL;
+    bool first = true;
+    bool error = false;
+    while (pd_json_member(j, &first, key, &error)){
+        if (strcmp(key, "type_name") == 0){
+            error = pd_json_string(j, name, sizeof(name)) == NULL;
+        }
+        else {
+            PD_JSON_WS(j);
+            if (strcmp(key, "fields") == 0){
+                fields = j->p;
+            }
+            error = !pd_json_skip(j);
+        }
+        if (error){
+            return NULL;
+        }
+    }
+    pd_type_t* type = (error || name[0] == '\0' || fields == NULL) ? NULL : pd_json_type(j, name);
+    if (type == NULL || type->fields != NULL){
+        return NULL; // invalid or described twice
+    }
+    const char* end = j->p;
+    uint32_t n = 0;
+    j->p = fields;
+    first = true;
+    while (pd_json_element(j, &first, &error) && pd_json_skip(j)){
+        n++;
+    }
+    pd_field_t* field = (n > 0 && n <= UINT16_MAX) ? ps_arena_alloc(j->arena, n, sizeof(pd_field_t), _Alignof(pd_field_t)) : NULL;
+    if (error || field == NULL){
+        return NULL;
+    }
+    type->fields = field;
+    type->n_fields = (uint16_t)n;
+    j->p = fields;
+    first = true;
+    while (pd_json_element(j, &first, &error)){
+        if (!pd_json_field(j, field++)){
+            return NULL;
+        }
+    }
+    j->p = end;
+    return error ? NULL : type;
+}
+
+// Parse TypeDescription {"type_description", "referenced_type_descriptions"}
+static bool pd_json_type_description(pd_json_t* j, const char* key, pd_type_t** root){
+    if (strcmp(key, "type_description") == 0){
+        *root = pd_json_description(j);
+        return *root != NULL;
+    }
+    if (strcmp(key, "referenced_type_descriptions") == 0){
+        bool first = true;
+        bool error = false;
+        while (pd_json_element(j, &first, &error)){
+            if (pd_json_description(j) == NULL){
+                return false;
+            }
+        }
+        return !error;
+    }
+    return pd_json_skip(j);
+}
+
+// Parse type hashes [{"type_name", "hash_string"}]
+static bool pd_json_hashes(pd_json_t* j){
+    bool first = true;
+    bool error = false;
+    while (pd_json_element(j, &first, &error)){
+        char key[PD_JSON_KEY_MAX];
+        char name[PD_PATH_MAX] = "";
+        char* hash = NULL;
+        bool first_member = true;
+        while (!error && pd_json_member(j, &first_member, key, &error)){
+            if (strcmp(key, "type_name") == 0){
+                error = pd_json_string(j, name, sizeof(name)) == NULL;
+            }
+            else if (strcmp(key, "hash_string") == 0){
+                error = (hash = pd_json_string(j, NULL, 0)) == NULL;
+            }
+            else {
+                error = !pd_json_skip(j);
+            }
+        }
+        pd_type_t* type = (error || hash == NULL) ? NULL : pd_json_type(j, name);
+        if (type == NULL){
+            return false;
+        }
+        size_t prefix = strlen(PD_HASH_PREFIX);
+        type->hash = (strncmp(hash, PD_HASH_PREFIX, prefix) == 0) ? hash + prefix : hash;
+    }
+    return !error;
+}
+
+// RMW type name "pkg::msg::dds_::Name" from ROS type name "pkg/msg/Name"
+static char* pd_json_rmw_name(ps_arena_t* arena, const char* name){
+    const char* last = strrchr(name, '/');
+    if (last == NULL){
+        return NULL;
+    }
+    // every '/' before last one becomes "::", last one becomes "::dds_::"
+    size_t slashes = 0;
+    for (const char* p = name; *p != '\0'; p++){
+        slashes += (*p == '/');
+    }
+    size_t len = strlen(name) + (slashes - 1) + strlen("::dds_::") - 1;
+    char* out = ps_arena_alloc(arena, len + 1, 1, 1);
+    if (out == NULL){
+        return NULL;
+    }
+    size_t n = 0;
+    for (const char* p = name; p < last; p++){
+        if (*p == '/'){
+            out[n++] = ':';
+            out[n++] = ':';
+        }
+        else {
+            out[n++] = *p;
+        }
+    }
+    memcpy(&out[n], "::dds_::", 8);
+    n += 8;
+    strcpy(&out[n], last + 1);
+    return out;
+}
+
+/* ----- schema walk ---------------------------------------------------------*/
+
+// Append ".name" or "[index]" to callback path, restored by caller
+static bool pd_path_push(pd_walk_t* w, const char* name, uint32_t index){
+    if (w->cb == NULL){
+        return true;
+    }
+    size_t room = PD_PATH_MAX - w->path_len;
+    int n = (name != NULL) ? snprintf(&w->path[w->path_len], room, (w->path_len > 0) ? ".%s" : "%s", name)
+                           : snprintf(&w->path[w->path_len], room, "[%u]", (unsigned)index);
+    if (n < 0 || (size_t)n >= room){
+        return false;
+    }
+    w->path_len += (size_t)n;
+    return true;
+}
+
+static void pd_path_pop(pd_walk_t* w, size_t len){
+    w->path_len = len;
+    w->path[len] = '\0';
+}
+
+// Write scalar with picoserdes base type serializer of the same C type
+static bool pd_ser_scalar(ucdrBuffer* ub, uint8_t type, const pd_value_t* v){
+    switch (type){
+        case PD_TYPE_INT8:    return ucdr_serialize_int8_t(ub, (int8_t)v->i);
+        case PD_TYPE_UINT8:
+        case PD_TYPE_BYTE:    return ucdr_serialize_uint8_t(ub, (uint8_t)v->u);
+        case PD_TYPE_CHAR:    return ucdr_serialize_char(ub, (char)v->u);
+        case PD_TYPE_INT16:   return ucdr_serialize_int16_t(ub, (int16_t)v->i);
+        case PD_TYPE_UINT16:  return ucdr_serialize_uint16_t(ub, (uint16_t)v->u);
+        case PD_TYPE_INT32:   return ucdr_serialize_int32_t(ub, (int32_t)v->i);
+        case PD_TYPE_UINT32:  return ucdr_serialize_uint32_t(ub, (uint32_t)v->u);
+        case PD_TYPE_INT64:   return ucdr_serialize_int64_t(ub, v->i);
+        case PD_TYPE_UINT64:  return ucdr_serialize_uint64_t(ub, v->u);
+        case PD_TYPE_FLOAT32: return ucdr_serialize_float(ub, (float)v->f);
+        case PD_TYPE_FLOAT64: return ucdr_serialize_double(ub, v->f);
+        case PD_TYPE_BOOL:    return ucdr_serialize_bool(ub, v->b);
+        case PD_TYPE_STRING:  return ucdr_serialize_rstring(ub, v->s);
+        default:              return false;
+    }
+}
+
+static bool pd_des_scalar(ucdrBuffer* ub, uint8_t type, pd_value_t* v){
+    bool ret = false;
+    switch (type){
+        case PD_TYPE_INT8:    { int8_t x = 0;   ret = ucdr_deserialize_int8_t(ub, &x);   v->i = x; break; }
+        case PD_TYPE_UINT8:
+        case PD_TYPE_BYTE:    { uint8_t x = 0;  ret = ucdr_deserialize_uint8_t(ub, &x);  v->u = x; break; }
+        case PD_TYPE_CHAR:    { char x = 0;     ret = ucdr_deserialize_char(ub, &x);     v->u = (uint8_t)x; break; }
+        case PD_TYPE_INT16:   { int16_t x = 0;  ret = ucdr_deserialize_int16_t(ub, &x);  v->i = x; break; }
+        case PD_TYPE_UINT16:  { uint16_t x = 0; ret = ucdr_deserialize_uint16_t(ub, &x); v->u = x; break; }
+        case PD_TYPE_INT32:   { int32_t x = 0;  ret = ucdr_deserialize_int32_t(ub, &x);  v->i = x; break; }
+        case PD_TYPE_UINT32:  { uint32_t x = 0; ret = ucdr_deserialize_uint32_t(ub, &x); v->u = x; break; }
+        case PD_TYPE_INT64:   ret = ucdr_deserialize_int64_t(ub, &v->i); break;
+        case PD_TYPE_UINT64:  ret = ucdr_deserialize_uint64_t(ub, &v->u); break;
+        case PD_TYPE_FLOAT32: { float x = 0;    ret = ucdr_deserialize_float(ub, &x);    v->f = x; break; }
+        case PD_TYPE_FLOAT64: ret = ucdr_deserialize_double(ub, &v->f); break;
+        case PD_TYPE_BOOL:    ret = ucdr_deserialize_bool(ub, &v->b); break;
+        case PD_TYPE_STRING:  ret = ucdr_deserialize_rstring(ub, &v->s); break;
+        default:              break;
+    }
+    return ret && !ub->error;
+}
+
+// Serialize one element, value comes from tree item or from callback when item is NULL
+static bool pd_ser_element(pd_walk_t* w, const pd_field_t* field, const pd_value_t* item){
+    if (field->type == PD_TYPE_NESTED){
+        return pd_ser_type(w, field->nested, (item != NULL) ? item->items : NULL);
+    }
+    pd_value_t v = {0};
+    if (item == NULL){
+        if (!w->cb(w->ctx, w->path, field, &v)){
+            return false;
+        }
+        item = &v;
+    }
+    return pd_ser_scalar(&w->ub, field->type, item);
+}
+
+// Serialize field, arrays and sequences follow generated code: strings arrays carry count,
+// plain elements are padded only when there is at least one element
+static bool pd_ser_field(pd_walk_t* w, const pd_field_t* field, const pd_value_t* value){
+    if (field->kind == PD_KIND_FIELD){
+        return pd_ser_element(w, field, value);
+    }
+    pd_value_t count = {.n = (field->kind == PD_KIND_ARRAY) ? field->capacity : 0};
+    if (value == NULL){
+        if (!w->cb(w->ctx, w->path, field, &count)){
+            return false;
+        }
+    }
+    else {
+        count.n = value->n;
+    }
+    if ((field->kind == PD_KIND_ARRAY && count.n != field->capacity)
+        || (field->capacity > 0 && count.n > field->capacity)){
+        return false;
+    }
+    if ((field->kind == PD_KIND_SEQUENCE || field->type == PD_TYPE_STRING)
+        && !ucdr_serialize_uint32_t(&w->ub, count.n)){
+        return false;
+    }
+    size_t len = w->path_len;
+    for (uint32_t i = 0; i < count.n; i++){
+        if (!pd_path_push(w, NULL, i) || !pd_ser_element(w, field, (value != NULL) ? &value->items[i] : NULL)){
+            return false;
+        }
+        pd_path_pop(w, len);
+    }
+    return !w->ub.error;
+}
+
+static bool pd_ser_type(pd_walk_t* w, const pd_type_t* type, const pd_value_t* items){
+    size_t len = w->path_len;
+    for (uint16_t f = 0; f < type->n_fields; f++){
+        if (!pd_path_push(w, type->fields[f].name, 0)
+            || !pd_ser_field(w, &type->fields[f], (items != NULL) ? &items[f] : NULL)){
+            return false;
+        }
+        pd_path_pop(w, len);
+    }
+    return true;
+}
+
+// Deserialize one element into tree item or to callback when item is NULL
+static bool pd_des_element(pd_walk_t* w, const pd_field_t* field, pd_value_t* item){
+    if (field->type == PD_TYPE_NESTED){
+        return pd_des_type(w, field->nested, item);
+    }
+    pd_value_t v = {0};
+    if (!pd_des_scalar(&w->ub, field->type, (item != NULL) ? item : &v)){
+        return false;
+    }
+    return item != NULL || w->cb(w->ctx, w->path, field, &v);
+}
+
+static bool pd_des_field(pd_walk_t* w, const pd_field_t* field, pd_value_t* value){
+    if (field->kind == PD_KIND_FIELD){
+        return pd_des_element(w, field, value);
+    }
+    uint32_t n = field->capacity;
+    if ((field->kind == PD_KIND_SEQUENCE || field->type == PD_TYPE_STRING)
+        && !ucdr_deserialize_uint32_t(&w->ub, &n)){
+        return false;
+    }
+    // every element takes at least one byte, reject corrupted lengths before allocation
+    if ((field->capacity > 0 && n > field->capacity) || n > (size_t)(w->ub.final - w->ub.iterator)){
+        return false;
+    }
+    pd_value_t count = {.n = n};
+    if (value != NULL){
+        // string arrays may carry less than capacity, remaining strings stay NULL.
+        // Only element slots are allocated, nested elements get their members from pd_des_type().
+        value->n = (field->kind == PD_KIND_ARRAY) ? field->capacity : n;
+        value->items = ps_arena_alloc(w->arena, value->n, sizeof(pd_value_t), _Alignof(pd_value_t));
+        if (value->n > 0 && value->items == NULL){
+            return false;
+        }
+    }
+    else if (!w->cb(w->ctx, w->path, field, &count)){
+        return false;
+    }
+    size_t len = w->path_len;
+    for (uint32_t i = 0; i < n; i++){
+        if (!pd_path_push(w, NULL, i) || !pd_des_element(w, field, (value != NULL) ? &value->items[i] : NULL)){
+            return false;
+        }
+        pd_path_pop(w, len);
+    }
+    return true;
+}
+
+static bool pd_des_type(pd_walk_t* w, const pd_type_t* type, pd_value_t* value){
+    if (value != NULL){
+        value->n = type->n_fields;
+        value->items = ps_arena_alloc(w->arena, type->n_fields, sizeof(pd_value_t), _Alignof(pd_value_t));
+        if (value->items == NULL){
+            return false;
+        }
+    }
+    size_t len = w->path_len;
+    for (uint16_t f = 0; f < type->n_fields; f++){
+        if (!pd_path_push(w, type->fields[f].name, 0)
+            || !pd_des_field(w, &type->fields[f], (value != NULL) ? &value->items[f] : NULL)){
+            return false;
+        }
+        pd_path_pop(w, len);
+    }
+    return true;
+}
+
+// Allocate n zero elements of field, nested elements get their members
+static pd_value_t* pd_value_alloc(const pd_field_t* field, uint32_t n, ps_arena_t* arena){
+    pd_value_t* items = ps_arena_alloc(arena, n, sizeof(pd_value_t), _Alignof(pd_value_t));
+    if (items == NULL || field->type != PD_TYPE_NESTED){
+        return items;
+    }
+    for (uint32_t i = 0; i < n; i++){
+        pd_value_t* value = pd_value_new(field->nested, arena);
+        if (value == NULL){
+            return NULL;
+        }
+        items[i] = *value;
+    }
+    return items;
+}
+
+// Initialize walk over CDR data in byte order of encapsulation header
+static bool pd_walk_init(pd_walk_t* w, uint8_t* buf, size_t len, pd_field_cb_t cb, void* ctx, ps_arena_t* arena){
+    if (buf == NULL || len < sizeof(uint32_t)){
+        return false;
+    }
+    memset(w, 0, sizeof(*w) - sizeof(w->path));
+    w->path[0] = '\0';
+    w->cb = cb;
+    w->ctx = ctx;
+    w->arena = arena;
+    ucdr_init_buffer_origin_offset_endian(&w->ub, buf + sizeof(uint32_t), len - sizeof(uint32_t), 0, 0,
+                                          PS_CDR_ENDIANNESS(buf));
+    return true;
+}
+
+static size_t pd_serialize_walk(uint8_t* buf, const pd_type_t* type, const pd_value_t* value, pd_field_cb_t cb, void* ctx, size_t max){
+    pd_walk_t w;
+    if (type == NULL || buf == NULL || max < sizeof(uint32_t)){
+        return 0;
+    }
+    PS_CDR_HEADER(buf);
+    pd_walk_init(&w, buf, max, cb, ctx, NULL);
+    if (!pd_ser_type(&w, type, (value != NULL) ? value->items : NULL) || w.ub.error){
+        return 0;
+    }
+    return ucdr_buffer_length(&w.ub) + sizeof(uint32_t);
+}
+
+
+/* Public functions ----------------------------------------------------------*/
+
+/* ----- schema --------------------------------------------------------------*/
+const pd_type_t* pd_load_json(const char* json, size_t len, ps_arena_t* arena){
+    if (json == NULL || arena == NULL){
+        return NULL;
+    }
+    pd_json_t j = {.p = json, .end = json + len, .arena = arena};
+    pd_type_t* root = NULL;
+    char key[PD_JSON_KEY_MAX];
+    bool first = true;
+    bool error = false;
+    while (!error && pd_json_member(&j, &first, key, &error)){
+        if (strcmp(key, "type_description_msg") == 0){
+            bool first_msg = true;
+            while (!error && pd_json_member(&j, &first_msg, key, &error)){
+                error = !pd_json_type_description(&j, key, &root);
+            }
+        }
+        else if (strcmp(key, "type_hashes") == 0){
+            error = !pd_json_hashes(&j);
+        }
+        else {
+            error = !pd_json_type_description(&j, key, &root);
+        }
+    }
+    if (error || root == NULL){
+        return NULL;
+    }
+    // every referenced type must be described, described type is moved to front
+    pd_type_t* prev = NULL;
+    for (pd_type_t* t = j.types; t != NULL; prev = t, t = (pd_type_t*)t->next){
+        if (t->fields == NULL || (t->rmw_name = pd_json_rmw_name(arena, t->name)) == NULL){
+            return NULL;
+        }
+        if (t == root && prev != NULL){
+            prev->next = t->next;
+            t->next = j.types;
+            j.types = t;
+            t = prev;
+        }
+    }
+    return root;
+}
+
+const pd_type_t* pd_find_type(const pd_type_t* types, const char* name){
+    for (; types != NULL; types = types->next){
+        if (strcmp(types->name, name) == 0){
+            return types;
+        }
+    }
+    return NULL;
+}
+
+const pd_field_t* pd_find_field(const pd_type_t* type, const char* name){
+    for (uint16_t i = 0; i < type->n_fields; i++){
+        if (strcmp(type->fields[i].name, name) == 0){
+            return &type->fields[i];
+        }
+    }
+    return NULL;
+}
+
+/* ----- values --------------------------------------------------------------*/
+pd_value_t* pd_value_new(const pd_type_t* type, ps_arena_t* arena){
+    pd_value_t* value = ps_arena_alloc(arena, 1, sizeof(pd_value_t), _Alignof(pd_value_t));
+    if (value == NULL){
+        return NULL;
+    }
+    value->n = type->n_fields;
+    value->items = ps_arena_alloc(arena, type->n_fields, sizeof(pd_value_t), _Alignof(pd_value_t));
+    if (value->items == NULL){
+        return NULL;
+    }
+    for (uint16_t f = 0; f < type->n_fields; f++){
+        const pd_field_t* field = &type->fields[f];
+        pd_value_t* member = &value->items[f];
+        if (field->kind == PD_KIND_ARRAY){
+            member->n = field->capacity;
+            member->items = pd_value_alloc(field, field->capacity, arena);
+            if (member->items == NULL){
+                return NULL;
+            }
+        }
+        else if (field->kind == PD_KIND_FIELD && field->type == PD_TYPE_NESTED){
+            pd_value_t* nested = pd_value_new(field->nested, arena);
+            if (nested == NULL){
+                return NULL;
+            }
+            *member = *nested;
+        }
+    }
+    return value;
+}
+
+bool pd_value_resize(const pd_field_t* field, pd_value_t* value, uint32_t n, ps_arena_t* arena){
+    if (field->kind != PD_KIND_SEQUENCE || (field->capacity > 0 && n > field->capacity)){
+        return false;
+    }
+    pd_value_t* items = pd_value_alloc(field, n, arena);
+    if (n > 0 && items == NULL){
+        return false;
+    }
+    value->n = n;
+    value->items = items;
+    return true;
+}
+
+pd_value_t* pd_member(const pd_type_t* type, pd_value_t* value, const char* name){
+    const pd_field_t* field = pd_find_field(type, name);
+    return (field != NULL) ? &value->items[field - type->fields] : NULL;
+}
+
+/* ----- serdes --------------------------------------------------------------*/
+size_t pd_serialize(uint8_t* buf, const pd_type_t* type, const pd_value_t* value, size_t max){
+    if (value == NULL){
+        return 0;
+    }
+    return pd_serialize_walk(buf, type, value, NULL, NULL, max);
+}
+
+bool pd_deserialize(uint8_t* buf, const pd_type_t* type, pd_value_t* value, size_t len, ps_arena_t* arena){
+    pd_walk_t w;
+    if (type == NULL || value == NULL || arena == NULL || !pd_walk_init(&w, buf, len, NULL, NULL, arena)){
+        return false;
+    }
+    return pd_des_type(&w, type, value) && !w.ub.error;
+}
+
+size_t pd_serialize_cb(uint8_t* buf, const pd_type_t* type, pd_field_cb_t cb, void* ctx, size_t max){
+    if (cb == NULL){
+        return 0;
+    }
+    return pd_serialize_walk(buf, type, NULL, cb, ctx, max);
+}
+
+bool pd_deserialize_cb(uint8_t* buf, const pd_type_t* type, pd_field_cb_t cb, void* ctx, size_t len){
+    pd_walk_t w;
+    if (type == NULL || cb == NULL || !pd_walk_init(&w, buf, len, cb, ctx, NULL)){
+        return false;
+    }
+    return pd_des_type(&w, type, NULL) && !w.ub.error;
+}
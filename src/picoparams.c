@@ -388,8 +388,9 @@ picoros_service_reply_t params_server_handler(picoros_srv_server_t* server, uint
 
     ucdrBuffer querry_writter = {};
     ucdrBuffer querry_reader = {};
-    ucdr_init_buffer(&querry_reader, request_data + 4, request_size - 4);
-    *((uint32_t*)pserver.interface.reply_buf) = 0x0100;
+    ucdr_init_buffer_origin_offset_endian(&querry_reader, request_data + 4, request_size - 4, 0, 0,
+                                          PS_CDR_ENDIANNESS(request_data));
+    PS_CDR_HEADER(pserver.interface.reply_buf);
     ucdr_init_buffer(&querry_writter, pserver.interface.reply_buf + 4, pserver.interface.reply_buf_size - 4);
     size_t ret = 0;
     if (server == &pserver.list_srv){
@@ -24,7 +24,42 @@
 #endif
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+/** FNV-1a 64 bit hash parameters */
+#define FNV_OFFSET 0xcbf29ce484222325ull
+#define FNV_PRIME  0x100000001b3ull
+/** Alignment of samples in batch storage */
+#define BATCH_ALIGN 8u
+/** Offset of payload from 8 byte aligned rx storage, CDR origin after 4 byte
+ *  encapsulation header becomes 8 byte aligned for zero copy sequence views */
+#define RX_ALIGN_OFFSET 4u
+/** States of asynchronous service call, drop in CALL_SENDING state is finished by caller */
+#define CALL_SENDING 1
+#define CALL_SENT    2
+#define CALL_DROPPED 3
 /* Private macro -------------------------------------------------------------*/
+#if Z_FEATURE_MULTI_THREAD == 1
+    #define _PR_LOCK(m)   z_mutex_lock(z_mutex_loan_mut(m))
+    #define _PR_UNLOCK(m) z_mutex_unlock(z_mutex_loan_mut(m))
+#else
+    #define _PR_LOCK(m)
+    #define _PR_UNLOCK(m)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define _PR_ATOMIC_INC(p)     __atomic_add_fetch(p, 1, __ATOMIC_RELAXED)
+    #define _PR_ATOMIC_LOAD(p)    __atomic_load_n(p, __ATOMIC_RELAXED)
+    #define _PR_ATOMIC_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELAXED)
+    #define _PR_ATOMIC_XCHG(p, v) __atomic_exchange_n(p, v, __ATOMIC_ACQ_REL)
+#elif Z_FEATURE_MULTI_THREAD == 0
+    // zenoh callbacks run in caller context, plain access is sufficient
+    #define _PR_ATOMIC_INC(p)     (++(*(p)))
+    #define _PR_ATOMIC_LOAD(p)    (*(p))
+    #define _PR_ATOMIC_STORE(p, v) (*(p) = (v))
+    #define _PR_ATOMIC_XCHG(p, v) pr_exchange(p, v)
+static inline int pr_exchange(int* p, int v) { int old = *p; *p = v; return old; }
+#else
+    #error "Atomic builtins are required with Z_FEATURE_MULTI_THREAD, use GCC or Clang compatible compiler"
+#endif
 /* Private constants ---------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static z_owned_session_t s_wrapper;
@@ -133,6 +168,16 @@ static int rmw_zenoh_topic_liveliness_keyexpr(picoros_node_t* node, rmw_topic_t*
    return ret;
 }
 
+// Allocate rx buffer with CDR origin 8 byte aligned
+static uint8_t* rx_alloc(size_t len) {
+    uint8_t* p = (uint8_t*)z_malloc(len + RX_ALIGN_OFFSET);
+    return (p != NULL) ? p + RX_ALIGN_OFFSET : NULL;
+}
+
+static void rx_free(uint8_t* data) {
+    z_free(data - RX_ALIGN_OFFSET);
+}
+
 static void sub_data_handler(z_loaned_sample_t *sample, void *ctx) {
     const z_loaned_bytes_t *b = z_sample_payload(sample);
 
@@ -140,14 +185,213 @@ static void sub_data_handler(z_loaned_sample_t *sample, void *ctx) {
     if (raw_data_len == 0) {
         return;
     }
-    uint8_t *raw_data = (uint8_t*)z_malloc(raw_data_len);
+    uint8_t *raw_data = rx_alloc(raw_data_len);
+    if (raw_data == NULL) {
+        return;
+    }
     _z_bytes_to_buf(b, raw_data, raw_data_len);
 
     // Call user callback function if given:
-    if (ctx != NULL) {
-    	((picoros_sub_cb_t)ctx)(raw_data, raw_data_len);
+    picoros_subscriber_t* sub = (picoros_subscriber_t*)ctx;
+    if (sub->data_callback != NULL) {
+        sub->data_callback(sub, raw_data, raw_data_len);
+    }
+    else if (sub->user_callback != NULL) {
+        sub->user_callback(raw_data, raw_data_len);
+    }
+    rx_free(raw_data);
+}
+
+// Samples and storage of one batch half, the other half may be delivered meanwhile
+#define BATCH_HALF_SAMPLES(b) ((b)->max_samples)
+#define BATCH_HALF_SIZE(b)    (((b)->buf_size / 2) & ~(size_t)(BATCH_ALIGN - 1))
+
+// Take filled half for delivery and continue in other half, must be called with batch lock held.
+// Returns false if batch is empty or previous half is still delivered.
+static bool sub_batch_take(picoros_sub_batch_t* batch, picoros_sample_t** samples, size_t* n_samples) {
+    if (batch->_n_samples == 0 || batch->_delivering) {
+        return false;
+    }
+    *samples = &batch->samples[batch->_fill * BATCH_HALF_SAMPLES(batch)];
+    *n_samples = batch->_n_samples;
+    batch->_delivering = true;
+    batch->_fill ^= 1;
+    batch->_n_samples = 0;
+    batch->_buf_used = 0;
+    return true;
+}
+
+// Deliver taken half to user without batch lock held, so callback can poll or flush
+static void sub_batch_deliver(picoros_sub_batch_t* batch, picoros_sample_t* samples, size_t n_samples) {
+    if (batch->callback != NULL) {
+        batch->callback(samples, n_samples);
+    }
+    _PR_LOCK(&batch->_mutex);
+    batch->_delivering = false;
+#if Z_FEATURE_MULTI_THREAD == 1
+    z_condvar_signal(z_condvar_loan(&batch->_cv));
+#endif
+    _PR_UNLOCK(&batch->_mutex);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+// Period timer task, delivers partial batch when its oldest sample reaches batch period
+static void* sub_batch_timer_task(void* arg) {
+    picoros_sub_batch_t* batch = (picoros_sub_batch_t*)arg;
+    _PR_LOCK(&batch->_mutex);
+    while (batch->_running) {
+        if (batch->_n_samples == 0 || batch->_delivering) {
+            z_condvar_wait(z_condvar_loan(&batch->_cv), z_mutex_loan_mut(&batch->_mutex));
+            continue;
+        }
+        unsigned long age_us = z_clock_elapsed_us(&batch->_first);
+        if (age_us < batch->period_us) {
+            z_clock_t deadline = z_clock_now();
+            z_clock_advance_us(&deadline, batch->period_us - age_us);
+            z_condvar_wait_until(z_condvar_loan(&batch->_cv), z_mutex_loan_mut(&batch->_mutex), &deadline);
+            continue;
+        }
+        picoros_sample_t* taken = NULL;
+        size_t n_taken = 0;
+        sub_batch_take(batch, &taken, &n_taken);
+        _PR_UNLOCK(&batch->_mutex);
+        sub_batch_deliver(batch, taken, n_taken);
+        _PR_LOCK(&batch->_mutex);
+    }
+    _PR_UNLOCK(&batch->_mutex);
+    return NULL;
+}
+#endif
+
+static picoros_res_t sub_batch_start(picoros_sub_batch_t* batch) {
+    if (batch->samples == NULL || batch->max_samples == 0 || batch->buf == NULL
+    || BATCH_HALF_SIZE(batch) <= RX_ALIGN_OFFSET) {
+        _PR_LOG("Invalid subscriber batch configuration!\n");
+        return PICOROS_ERROR;
+    }
+    batch->_n_samples = 0;
+    batch->_buf_used = 0;
+    batch->_fill = 0;
+    batch->_delivering = false;
+    batch->_running = false;
+#if Z_FEATURE_MULTI_THREAD == 1
+    // init in order, drop already initialized primitives on failure
+    z_result_t res = z_mutex_init(&batch->_mutex);
+    if (res == Z_OK) {
+        res = z_condvar_init(&batch->_cv);
+        if (res == Z_OK && batch->period_us != 0) {
+            batch->_running = true;
+            res = z_task_init(&batch->_timer, NULL, sub_batch_timer_task, batch);
+            if (res != Z_OK) {
+                batch->_running = false;
+                z_condvar_drop(z_condvar_move(&batch->_cv));
+            }
+        }
+        if (res != Z_OK) {
+            z_mutex_drop(z_mutex_move(&batch->_mutex));
+        }
+    }
+    if (res != Z_OK) {
+        _PR_LOG("Unable to start subscriber batch! Error:%d\n", res);
+        return PICOROS_ERROR;
+    }
+#endif
+    return PICOROS_OK;
+}
+
+// Stop period timer, deliver what was received so far and drop batch primitives.
+// With Z_FEATURE_MULTI_THREAD a batch still in callback of another thread is waited for,
+// so no thread holds the batch lock when it is dropped. Must not be called from batch callback.
+static void sub_batch_stop(picoros_sub_batch_t* batch) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (batch->_running) {
+        _PR_LOCK(&batch->_mutex);
+        batch->_running = false;
+        z_condvar_signal(z_condvar_loan(&batch->_cv));
+        _PR_UNLOCK(&batch->_mutex);
+        z_task_join(z_task_move(&batch->_timer));
+    }
+#endif
+    picoros_sample_t* taken = NULL;
+    size_t n_taken = 0;
+    _PR_LOCK(&batch->_mutex);
+    for (;;) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        while (batch->_delivering) {
+            z_condvar_wait(z_condvar_loan(&batch->_cv), z_mutex_loan_mut(&batch->_mutex));
+        }
+#endif
+        if (!sub_batch_take(batch, &taken, &n_taken)) {
+            break;
+        }
+        _PR_UNLOCK(&batch->_mutex);
+        sub_batch_deliver(batch, taken, n_taken);
+        _PR_LOCK(&batch->_mutex);
+    }
+    _PR_UNLOCK(&batch->_mutex);
+#if Z_FEATURE_MULTI_THREAD == 1
+    z_condvar_drop(z_condvar_move(&batch->_cv));
+    z_mutex_drop(z_mutex_move(&batch->_mutex));
+#endif
+}
+
+static void sub_batch_handler(z_loaned_sample_t *sample, void *ctx) {
+    picoros_sub_batch_t* batch = ((picoros_subscriber_t*)ctx)->batch;
+    const z_loaned_bytes_t *b = z_sample_payload(sample);
+
+    size_t raw_data_len = _z_bytes_len(b);
+    if (raw_data_len == 0) {
+        return;
+    }
+    if (raw_data_len + RX_ALIGN_OFFSET > BATCH_HALF_SIZE(batch)) {
+        _PR_LOG("Sample of %zu bytes exceeds batch storage, dropped\n", raw_data_len);
+        return;
+    }
+
+    picoros_sample_t* taken = NULL;
+    size_t n_taken = 0;
+    _PR_LOCK(&batch->_mutex);
+    // Make room for new sample
+    if (batch->_n_samples >= BATCH_HALF_SAMPLES(batch)
+    || batch->_buf_used + RX_ALIGN_OFFSET + raw_data_len > BATCH_HALF_SIZE(batch)) {
+        if (!sub_batch_take(batch, &taken, &n_taken)) {
+            _PR_UNLOCK(&batch->_mutex);
+            _PR_LOG("Batch full while previous batch is delivered, sample dropped\n");
+            return;
+        }
+    }
+
+    picoros_sample_t* s = &batch->samples[batch->_fill * BATCH_HALF_SAMPLES(batch) + batch->_n_samples];
+    s->data = &batch->buf[batch->_fill * BATCH_HALF_SIZE(batch) + batch->_buf_used + RX_ALIGN_OFFSET];
+    s->len = _z_bytes_to_buf(b, s->data, raw_data_len);
+
+    const z_loaned_bytes_t *a = z_sample_attachment(sample);
+    if (a != NULL && _z_bytes_len(a) == sizeof(rmw_attachment_t)) {
+        _z_bytes_to_buf(a, (uint8_t*)&s->attachment, sizeof(rmw_attachment_t));
+    }
+    else {
+        memset(&s->attachment, 0, sizeof(rmw_attachment_t));
+    }
+
+    batch->_buf_used += (RX_ALIGN_OFFSET + raw_data_len + BATCH_ALIGN - 1) & ~(size_t)(BATCH_ALIGN - 1);
+    if (batch->_n_samples++ == 0) {
+        batch->_first = z_clock_now();
+#if Z_FEATURE_MULTI_THREAD == 1
+        if (batch->_running) {
+            z_condvar_signal(z_condvar_loan(&batch->_cv));
+        }
+#endif
+    }
+
+    if (taken == NULL && (batch->_n_samples >= BATCH_HALF_SAMPLES(batch)
+    || (batch->period_us != 0 && z_clock_elapsed_us(&batch->_first) >= batch->period_us))) {
+        sub_batch_take(batch, &taken, &n_taken);
+    }
+    _PR_UNLOCK(&batch->_mutex);
+
+    if (taken != NULL) {
+        sub_batch_deliver(batch, taken, n_taken);
     }
-    z_free(raw_data);
 }
 
 static void queriable_data_handler(z_loaned_query_t *query, void *arg) {
@@ -161,7 +405,10 @@ static void queriable_data_handler(z_loaned_query_t *query, void *arg) {
     size_t rx_data_len = _z_bytes_len(b);
 
     // get request data
-    uint8_t* rx_data = (uint8_t*)z_malloc(rx_data_len);
+    uint8_t* rx_data = rx_alloc(rx_data_len);
+    if (rx_data == NULL) {
+        return;
+    }
     _z_bytes_to_buf(b, rx_data, rx_data_len);
 
     // process
@@ -173,12 +420,13 @@ static void queriable_data_handler(z_loaned_query_t *query, void *arg) {
         z_bytes_copy_from_buf(&reply_payload, reply.data, reply.length);
 
         // rmw attachment
-        srv->attachment.sequence_number = 1;
-        srv->attachment.time = z_clock_now().tv_nsec;
+        rmw_attachment_t attachment = srv->attachment;
+        attachment.sequence_number = 1;
+        attachment.time = z_clock_now().tv_nsec;
         z_query_reply_options_t options;
         z_query_reply_options_default(&options);
         z_owned_bytes_t tx_attachment;
-        z_bytes_from_static_buf(&tx_attachment, (uint8_t*)&srv->attachment, sizeof(rmw_attachment_t));
+        z_bytes_from_static_buf(&tx_attachment, (uint8_t*)&attachment, sizeof(rmw_attachment_t));
         options.attachment = z_bytes_move(&tx_attachment);
 
         // send reply
@@ -193,7 +441,7 @@ static void queriable_data_handler(z_loaned_query_t *query, void *arg) {
             reply.free_callback(reply.data);
         }
     }
-    z_free(rx_data);
+    rx_free(rx_data);
 }
 
 static void queriable_drop_handler(void* arg) { _PR_LOG("Drop srv callback\n"); }
@@ -206,17 +454,14 @@ static void get_drop_handler(void* ctx){
     }
 }
 
-static void get_data_handler(z_loaned_reply_t *reply, void *ctx){
-    if (ctx == NULL){
-        return;
-    }
-    size_t raw_data_len = 0;
+// Copy reply payload to rx buffer, NULL for empty payload
+static uint8_t* reply_payload(z_loaned_reply_t *reply, size_t* len, bool* error){
     uint8_t* raw_data  = 0;
-    bool error = false;
     const z_loaned_sample_t* sample = 0;
     const z_loaned_bytes_t* payload = 0;
     const z_loaned_reply_err_t* err = 0;
 
+    *error = false;
     if (z_reply_is_ok(reply)) {
         sample = z_reply_ok(reply);
         payload = z_sample_payload(sample);
@@ -224,21 +469,392 @@ static void get_data_handler(z_loaned_reply_t *reply, void *ctx){
     else {
         err = z_reply_err(reply);
         payload = z_reply_err_payload(err);
-        error = true;
+        *error = true;
     }
 
-    raw_data_len = _z_bytes_len(payload);
-    if (raw_data_len == 0) {
+    *len = _z_bytes_len(payload);
+    if (*len == 0) {
+        return NULL;
+    }
+    raw_data = rx_alloc(*len);
+    if (raw_data == NULL) {
+        return NULL;
+    }
+    _z_bytes_to_buf(payload, raw_data, *len);
+    return raw_data;
+}
+
+static void get_data_handler(z_loaned_reply_t *reply, void *ctx){
+    if (ctx == NULL){
+        return;
+    }
+    size_t raw_data_len = 0;
+    bool error = false;
+    uint8_t* raw_data = reply_payload(reply, &raw_data_len, &error);
+    if (raw_data == NULL) {
         return;
     }
-    raw_data = (uint8_t*)z_malloc(raw_data_len);
-    _z_bytes_to_buf(payload, raw_data, raw_data_len);
 
     picoros_srv_client_t* client = (picoros_srv_client_t*)ctx;
     client->user_callback(client, raw_data, raw_data_len, error);
-    z_free(raw_data);
+    rx_free(raw_data);
+}
+
+static void call_data_handler(z_loaned_reply_t *reply, void *ctx){
+    picoros_srv_call_t* call = (picoros_srv_call_t*)ctx;
+    if (call->reply_callback == NULL){
+        return;
+    }
+    size_t raw_data_len = 0;
+    bool error = false;
+    uint8_t* raw_data = reply_payload(reply, &raw_data_len, &error);
+    if (raw_data == NULL) {
+        return;
+    }
+    call->reply_callback(call, raw_data, raw_data_len, error);
+    rx_free(raw_data);
+}
+
+// Drop during z_get() is finished by picoros_service_call_async() after z_get() returns
+static void call_drop_handler(void* ctx){
+    picoros_srv_call_t* call = (picoros_srv_call_t*)ctx;
+    if (_PR_ATOMIC_XCHG(&call->_state, CALL_DROPPED) == CALL_SENT && call->drop_callback != NULL){
+        call->drop_callback(call);
+    }
+}
+
+// Put payload bytes to zenoh publisher with per call attachment, takes ownership of zbytes
+static picoros_res_t publisher_put_bytes(picoros_publisher_t* pub, z_owned_bytes_t* zbytes) {
+    z_result_t res = Z_OK;
+    z_publisher_put_options_t options;
+    z_publisher_put_options_default(&options);
+
+    // Per call attachment, zenoh encodes it before put returns
+    rmw_attachment_t attachment = pub->attachment;
+    attachment.sequence_number = (int64_t)_PR_ATOMIC_INC(&pub->_sequence);
+    attachment.time = z_clock_now().tv_nsec;
+
+    z_owned_bytes_t z_attachment;
+    z_bytes_from_static_buf(&z_attachment, (uint8_t*)&attachment, sizeof(rmw_attachment_t));
+
+    options.attachment = z_bytes_move(&z_attachment);
+
+    if ((res = z_publisher_put(z_publisher_loan(&pub->zpub), z_bytes_move(zbytes), &options)) != Z_OK) {
+        _PR_LOG("Unable to publish payload! Error:%d\n", res);
+        return PICOROS_ERROR;
+    }
+    return PICOROS_OK;
+}
+
+// Put sample to zenoh publisher
+static picoros_res_t publisher_put(picoros_publisher_t* pub, uint8_t* payload, size_t len) {
+    z_owned_bytes_t zbytes;
+    z_bytes_from_static_buf(&zbytes, payload, len);
+    return publisher_put_bytes(pub, &zbytes);
+}
+
+static uint64_t fnv_hash(uint64_t h, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+// Returns true if payload equals last published one and heartbeat has not expired
+static bool on_change_suppress(picoros_on_change_t* oc, uint8_t* payload, size_t len) {
+    size_t skip_start = (oc->skip_offset < len) ? oc->skip_offset : len;
+    size_t skip_end = (oc->skip_len < len - skip_start) ? skip_start + oc->skip_len : len;
+    uint64_t h = fnv_hash(FNV_OFFSET, payload, skip_start);
+    h = fnv_hash(h, payload + skip_end, len - skip_end);
+    h = fnv_hash(h, (const uint8_t*)&len, sizeof(len));
+    // folded to 32 bit so atomic access is lock free on 32 bit MCUs without libatomic
+    uint32_t h32 = (uint32_t)(h ^ (h >> 32));
+    if (h32 == 0) { h32 = 1; } // 0 marks no previous payload
+
+    uint32_t now_ms = (uint32_t)z_clock_elapsed_ms(&oc->_epoch);
+    // racing publishers at worst send one extra sample
+    uint32_t last = _PR_ATOMIC_LOAD(&oc->_hash);
+    _PR_ATOMIC_STORE(&oc->_hash, h32);
+    if (last == h32 && (oc->heartbeat_ms == 0 || now_ms - _PR_ATOMIC_LOAD(&oc->_last_ms) < oc->heartbeat_ms)) {
+        _PR_ATOMIC_INC(&oc->_suppressed);
+        return true;
+    }
+    _PR_ATOMIC_STORE(&oc->_last_ms, now_ms);
+    return false;
+}
+
+// Refill bucket, returns microseconds until len bytes conform, 0 if conforming
+static uint32_t bucket_wait_us(picoros_token_bucket_t* b, size_t len) {
+    if (b->rate == 0) {
+        return 0;
+    }
+    unsigned long elapsed = z_clock_elapsed_us(&b->_last);
+    b->_last = z_clock_now();
+    // carry fraction of token in byte-microseconds so frequent refills do not lose rate
+    uint64_t credit = (uint64_t)elapsed * b->rate + b->_frac;
+    b->_tokens += (int64_t)(credit / 1000000u);
+    b->_frac = (uint32_t)(credit % 1000000u);
+    if (b->_tokens >= (int64_t)b->burst) {
+        b->_tokens = b->burst;
+        b->_frac = 0;
+    }
+    int64_t need = (len < b->burst) ? (int64_t)len : (int64_t)b->burst;
+    if (b->_tokens >= need) {
+        return 0;
+    }
+    uint64_t wait = (uint64_t)(need - b->_tokens) * 1000000u / b->rate + 1;
+    return (wait > UINT32_MAX) ? UINT32_MAX : (uint32_t)wait;
+}
+
+static void bucket_reset(picoros_token_bucket_t* b) {
+    b->_tokens = b->burst;
+    b->_frac = 0;
+    b->_last = z_clock_now();
+}
+
+// Take tokens from class and publisher buckets, returns microseconds to wait if not conforming
+static uint32_t shaper_acquire(picoros_publisher_t* pub, size_t len) {
+    picoros_shaper_t* sh = pub->shaper;
+    picoros_shaper_class_t* cls = &sh->classes[pub->shaper_class];
+
+    _PR_LOCK(&sh->_mutex);
+    uint32_t wait_cls = bucket_wait_us(&cls->bucket, len);
+    uint32_t wait_pub = bucket_wait_us(&pub->bucket, len);
+    uint32_t wait_us = (wait_cls > wait_pub) ? wait_cls : wait_pub;
+    if (wait_us == 0) {
+        if (cls->bucket.rate != 0) { cls->bucket._tokens -= len; }
+        if (pub->bucket.rate != 0) { pub->bucket._tokens -= len; }
+        cls->_stats.shaped += len;
+    }
+    _PR_UNLOCK(&sh->_mutex);
+    return wait_us;
+}
+
+static void shaper_account(picoros_publisher_t* pub, size_t deferred, size_t dropped) {
+    picoros_shaper_t* sh = pub->shaper;
+    picoros_shaper_class_t* cls = &sh->classes[pub->shaper_class];
+    _PR_LOCK(&sh->_mutex);
+    cls->_stats.deferred += deferred;
+    cls->_stats.dropped += dropped;
+    _PR_UNLOCK(&sh->_mutex);
+}
+
+static inline picoros_shape_policy_t shaper_policy(picoros_publisher_t* pub) {
+    return pub->shaper->classes[pub->shaper_class].policy;
+}
+
+// Apply shaper policy before synchronous put, conflation needs a queue so it drops here
+static picoros_res_t shaper_admit(picoros_publisher_t* pub, size_t len) {
+    bool deferred = false;
+    uint32_t wait_us;
+    while ((wait_us = shaper_acquire(pub, len)) != 0) {
+        if (shaper_policy(pub) != PICOROS_SHAPE_DEFER) {
+            shaper_account(pub, 0, len);
+            return PICOROS_DROPPED;
+        }
+        deferred = true;
+        z_sleep_us(wait_us);
+    }
+    if (deferred) {
+        shaper_account(pub, len, 0);
+    }
+    return PICOROS_OK;
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+// Queue slot layout: [size_t length][slot_size bytes of data]
+static inline uint8_t* queue_slot(picoros_pub_queue_t* q, size_t idx) {
+    return &q->buf[(idx % q->depth) * (q->slot_size + PICOROS_QUEUE_SLOT_HDR)];
+}
+
+// Number of free slots, slot being sent is not free
+static inline size_t queue_free(picoros_pub_queue_t* q) {
+    return q->depth - q->_stats.depth - (q->_busy ? 1 : 0);
+}
+
+// Sender task draining publish queue
+static void* queue_sender_task(void* arg) {
+    picoros_publisher_t* pub = (picoros_publisher_t*)arg;
+    picoros_pub_queue_t* q = pub->queue;
+
+    bool deferred = false;
+    _PR_LOCK(&q->_mutex);
+    while (true) {
+        while (q->_stats.depth == 0 && q->_running) {
+            z_condvar_wait(z_condvar_loan(&q->_cv_data), z_mutex_loan_mut(&q->_mutex));
+        }
+        if (q->_stats.depth == 0) {
+            break; // stopped and drained
+        }
+        size_t len = 0;
+        if (pub->shaper != NULL) {
+            if (shaper_policy(pub) == PICOROS_SHAPE_CONFLATE && q->_stats.depth > 1) {
+                // keep only newest queued sample
+                size_t dropped = 0;
+                while (q->_stats.depth > 1) {
+                    memcpy(&len, queue_slot(q, q->_head), sizeof(size_t));
+                    dropped += len;
+                    q->_head = (q->_head + 1) % q->depth;
+                    q->_stats.depth--;
+                    q->_stats.dropped++;
+                }
+                shaper_account(pub, 0, dropped);
+                z_condvar_signal(z_condvar_loan(&q->_cv_space));
+            }
+            memcpy(&len, queue_slot(q, q->_head), sizeof(size_t));
+            uint32_t wait_us = shaper_acquire(pub, len);
+            if (wait_us != 0) {
+                if (shaper_policy(pub) == PICOROS_SHAPE_DROP) {
+                    q->_head = (q->_head + 1) % q->depth;
+                    q->_stats.depth--;
+                    q->_stats.dropped++;
+                    shaper_account(pub, 0, len);
+                    z_condvar_signal(z_condvar_loan(&q->_cv_space));
+                }
+                else {
+                    // wait for tokens, newer samples may arrive meanwhile
+                    deferred = true;
+                    _PR_UNLOCK(&q->_mutex);
+                    z_sleep_us(wait_us);
+                    _PR_LOCK(&q->_mutex);
+                }
+                continue;
+            }
+        }
+        // take oldest sample, slot stays reserved until put returns
+        uint8_t* slot = queue_slot(q, q->_head);
+        q->_head = (q->_head + 1) % q->depth;
+        q->_stats.depth--;
+        q->_busy = true;
+        _PR_UNLOCK(&q->_mutex);
+
+        memcpy(&len, slot, sizeof(size_t));
+        picoros_res_t res = publisher_put(pub, slot + PICOROS_QUEUE_SLOT_HDR, len);
+        if (deferred) {
+            shaper_account(pub, len, 0);
+            deferred = false;
+        }
+
+        _PR_LOCK(&q->_mutex);
+        q->_busy = false;
+        if (res == PICOROS_OK) {
+            q->_stats.sent++;
+        }
+        else {
+            q->_stats.errors++;
+        }
+        z_condvar_signal(z_condvar_loan(&q->_cv_space));
+    }
+    _PR_UNLOCK(&q->_mutex);
+    return NULL;
 }
 
+static picoros_res_t queue_start(picoros_publisher_t* pub) {
+    picoros_pub_queue_t* q = pub->queue;
+    if (q->buf == NULL || q->depth == 0 || q->slot_size == 0) {
+        _PR_LOG("Invalid publish queue configuration!\n");
+        return PICOROS_ERROR;
+    }
+    if (q->policy == PICOROS_QUEUE_CONFLATE && q->depth < 2) {
+        // spare slot for newest sample while sender task holds the other one
+        _PR_LOG("Conflating publish queue needs depth of at least 2!\n");
+        return PICOROS_ERROR;
+    }
+    memset(&q->_stats, 0, sizeof(q->_stats));
+    q->_head = 0;
+    q->_busy = false;
+    q->_waiters = 0;
+    q->_running = true;
+    // init in order, drop already initialized primitives on failure
+    z_result_t res = z_mutex_init(&q->_mutex);
+    if (res == Z_OK) {
+        res = z_condvar_init(&q->_cv_data);
+        if (res == Z_OK) {
+            res = z_condvar_init(&q->_cv_space);
+            if (res == Z_OK) {
+                res = z_task_init(&q->_task, NULL, queue_sender_task, pub);
+                if (res != Z_OK) {
+                    z_condvar_drop(z_condvar_move(&q->_cv_space));
+                }
+            }
+            if (res != Z_OK) {
+                z_condvar_drop(z_condvar_move(&q->_cv_data));
+            }
+        }
+        if (res != Z_OK) {
+            z_mutex_drop(z_mutex_move(&q->_mutex));
+        }
+    }
+    if (res != Z_OK) {
+        _PR_LOG("Unable to start publish queue sender task!\n");
+        q->_running = false;
+        return PICOROS_ERROR;
+    }
+    return PICOROS_OK;
+}
+
+static void queue_stop(picoros_pub_queue_t* q) {
+    _PR_LOCK(&q->_mutex);
+    q->_running = false;
+    z_condvar_signal(z_condvar_loan(&q->_cv_data));
+    // wake blocked publishers and wait until they left before dropping queue primitives
+    z_condvar_signal_all(z_condvar_loan(&q->_cv_space));
+    while (q->_waiters > 0) {
+        z_condvar_wait(z_condvar_loan(&q->_cv_space), z_mutex_loan_mut(&q->_mutex));
+    }
+    _PR_UNLOCK(&q->_mutex);
+
+    z_task_join(z_task_move(&q->_task));
+    z_condvar_drop(z_condvar_move(&q->_cv_space));
+    z_condvar_drop(z_condvar_move(&q->_cv_data));
+    z_mutex_drop(z_mutex_move(&q->_mutex));
+}
+
+static picoros_res_t queue_push(picoros_pub_queue_t* q, uint8_t* payload, size_t len) {
+    if (len > q->slot_size) {
+        _PR_LOG("Sample of %zu bytes exceeds publish queue slot size!\n", len);
+        return PICOROS_ERROR;
+    }
+
+    _PR_LOCK(&q->_mutex);
+    if (!q->_running) {
+        q->_stats.dropped++;
+        _PR_UNLOCK(&q->_mutex);
+        return PICOROS_DROPPED;
+    }
+    if (q->policy == PICOROS_QUEUE_CONFLATE && q->_stats.depth > 0) {
+        // replace unsent samples with newest, depth >= 2 leaves a slot beside the one being sent
+        q->_stats.dropped += q->_stats.depth;
+        q->_stats.depth = 0;
+    }
+    while (queue_free(q) == 0 || !q->_running) {
+        if (q->policy == PICOROS_QUEUE_BLOCK && q->_running) {
+            q->_waiters++;
+            z_condvar_wait(z_condvar_loan(&q->_cv_space), z_mutex_loan_mut(&q->_mutex));
+            q->_waiters--;
+            if (!q->_running) {
+                // queue_stop() waits for last blocked publisher
+                z_condvar_signal_all(z_condvar_loan(&q->_cv_space));
+            }
+        }
+        else {
+            q->_stats.dropped++;
+            _PR_UNLOCK(&q->_mutex);
+            return PICOROS_DROPPED;
+        }
+    }
+    // copy to tail slot, slot is owned by publisher until depth is increased
+    uint8_t* slot = queue_slot(q, q->_head + q->_stats.depth);
+    memcpy(slot, &len, sizeof(size_t));
+    memcpy(slot + PICOROS_QUEUE_SLOT_HDR, payload, len);
+    q->_stats.depth++;
+    z_condvar_signal(z_condvar_loan(&q->_cv_data));
+    _PR_UNLOCK(&q->_mutex);
+    return PICOROS_OK;
+}
+#endif
+
 /* Public functions ----------------------------------------------------------*/
 
 picoros_res_t picoros_interface_init(picoros_interface_t* ifx) {
@@ -312,47 +928,197 @@ picoros_res_t picoros_publisher_declare(picoros_node_t* node, picoros_publisher_
     }
 
     rmw_zenoh_gen_attachment_gid(&pub->attachment);
+    pub->_sequence = 0;
+
+    pub->on_change._hash = 0;
+    pub->on_change._last_ms = 0;
+    pub->on_change._suppressed = 0;
+    pub->on_change._epoch = z_clock_now();
+
+    if (pub->shaper != NULL) {
+        if (pub->shaper_class >= pub->shaper->n_classes) {
+            _PR_LOG("Invalid shaper class %u!\n", pub->shaper_class);
+            return PICOROS_ERROR;
+        }
+        bucket_reset(&pub->bucket);
+    }
 
     if ((res = z_declare_publisher(z_session_loan(&s_wrapper), &pub->zpub, z_view_keyexpr_loan(&ke), options)) != Z_OK) {
         _PR_LOG("Unable to declare node liveliness token! Error:%d\n", res);
         return PICOROS_ERROR;
     }
 
+    if (pub->queue != NULL) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        if (queue_start(pub) != PICOROS_OK) {
+            z_undeclare_publisher(z_publisher_move(&pub->zpub));
+            return PICOROS_ERROR;
+        }
+#else
+        _PR_LOG("Publish queue requires Z_FEATURE_MULTI_THREAD!\n");
+        z_undeclare_publisher(z_publisher_move(&pub->zpub));
+        return PICOROS_ERROR;
+#endif
+    }
+
     if (pub->topic.type != NULL) {
         z_view_keyexpr_t ke2;
         rmw_zenoh_topic_liveliness_keyexpr(node, &pub->topic, keyexpr, "MP");
         z_view_keyexpr_from_str(&ke2, keyexpr);
 
-        z_owned_liveliness_token_t token;
-        if ((res = z_liveliness_declare_token(z_session_loan(&s_wrapper), &token, z_view_keyexpr_loan(&ke2), NULL)) != Z_OK) {
+        if ((res = z_liveliness_declare_token(z_session_loan(&s_wrapper), &pub->_token, z_view_keyexpr_loan(&ke2), NULL)) != Z_OK) {
             _PR_LOG("Unable to declare publisher liveliness token! Error:%d\n", res);
+#if Z_FEATURE_MULTI_THREAD == 1
+            if (pub->queue != NULL) {
+                queue_stop(pub->queue);
+            }
+#endif
+            z_undeclare_publisher(z_publisher_move(&pub->zpub));
             return PICOROS_ERROR;
         }
     }
+    if (pub->shaper != NULL) {
+        _PR_LOCK(&pub->shaper->_mutex);
+        pub->shaper->_users++;
+        _PR_UNLOCK(&pub->shaper->_mutex);
+    }
     return PICOROS_OK;
 }
 
 // Publish to a topic
 picoros_res_t picoros_publish(picoros_publisher_t* pub, uint8_t* payload, size_t len) {
-    z_result_t res = Z_OK;
-    z_publisher_put_options_t options;
-    z_publisher_put_options_default(&options);
+    if (pub->on_change.enabled && on_change_suppress(&pub->on_change, payload, len)) {
+        return PICOROS_OK;
+    }
 
-    pub->attachment.sequence_number++;
-    pub->attachment.time = z_clock_now().tv_nsec;
+    picoros_res_t res = PICOROS_OK;
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (pub->queue != NULL) {
+        res = queue_push(pub->queue, payload, len);
+    }
+    else
+#endif
+    {
+        if (pub->shaper != NULL) {
+            res = shaper_admit(pub, len);
+        }
+        if (res == PICOROS_OK) {
+            res = publisher_put(pub, payload, len);
+        }
+    }
 
-    z_owned_bytes_t z_attachment;
-    z_bytes_from_static_buf(&z_attachment, (uint8_t*)&pub->attachment, sizeof(rmw_attachment_t));
+    if (res != PICOROS_OK && pub->on_change.enabled) {
+        // not sent, do not suppress next identical sample
+        _PR_ATOMIC_STORE(&pub->on_change._hash, 0);
+    }
+    return res;
+}
 
-    options.attachment = z_bytes_move(&z_attachment);
+// Publish one payload to all publishers in group
+picoros_res_t picoros_publish_group(picoros_pub_group_t* group, uint8_t* payload, size_t len) {
+    if (group == NULL || (group->pubs == NULL && group->n_pubs > 0)) { return PICOROS_ERROR; }
 
-    z_owned_bytes_t zbytes;
-    z_bytes_from_static_buf(&zbytes, payload, len);
+    picoros_res_t ret = PICOROS_OK;
+    z_owned_bytes_t shared;
+    if (z_bytes_from_static_buf(&shared, payload, len) != Z_OK) {
+        return PICOROS_ERROR;
+    }
+    for (size_t i = 0; i < group->n_pubs; i++) {
+        picoros_publisher_t* pub = group->pubs[i];
+        picoros_res_t res;
+        if (pub->queue != NULL || pub->shaper != NULL || pub->on_change.enabled) {
+            // needs per publisher handling of payload
+            res = picoros_publish(pub, payload, len);
+        }
+        else {
+            // put shares payload slice with other publishers, no copy
+            z_owned_bytes_t zbytes;
+            if (z_bytes_clone(&zbytes, z_bytes_loan(&shared)) != Z_OK) {
+                res = PICOROS_ERROR;
+            }
+            else {
+                res = publisher_put_bytes(pub, &zbytes);
+            }
+        }
+        if (res != PICOROS_OK) {
+            ret = res;
+        }
+    }
+    z_bytes_drop(z_bytes_move(&shared));
+    return ret;
+}
 
-    if ((res = z_publisher_put(z_publisher_loan(&pub->zpub), z_bytes_move(&zbytes), &options)) != Z_OK) {
-        _PR_LOG("Unable to publish payload! Error:%d\n", res);
+uint32_t picoros_publisher_suppressed(picoros_publisher_t* pub) {
+    return _PR_ATOMIC_LOAD(&pub->on_change._suppressed);
+}
+
+picoros_res_t picoros_publisher_undeclare(picoros_publisher_t* pub) {
+    // remove publisher from ROS graph before it stops publishing
+    if (pub->topic.type != NULL) {
+        z_liveliness_undeclare_token(z_liveliness_token_move(&pub->_token));
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (pub->queue != NULL && pub->queue->_running) {
+        queue_stop(pub->queue);
+    }
+#endif
+    if (pub->shaper != NULL) {
+        _PR_LOCK(&pub->shaper->_mutex);
+        if (pub->shaper->_users > 0) {
+            pub->shaper->_users--;
+        }
+        _PR_UNLOCK(&pub->shaper->_mutex);
+    }
+    return (z_undeclare_publisher(z_publisher_move(&pub->zpub)) == Z_OK) ? PICOROS_OK : PICOROS_ERROR;
+}
+
+picoros_res_t picoros_publisher_queue_stats(picoros_publisher_t* pub, picoros_queue_stats_t* stats) {
+    if (pub == NULL || pub->queue == NULL || stats == NULL) { return PICOROS_ERROR; }
+
+    _PR_LOCK(&pub->queue->_mutex);
+    *stats = pub->queue->_stats;
+    _PR_UNLOCK(&pub->queue->_mutex);
+    return PICOROS_OK;
+}
+
+picoros_res_t picoros_shaper_init(picoros_shaper_t* shaper) {
+    if (shaper == NULL || (shaper->classes == NULL && shaper->n_classes > 0)) { return PICOROS_ERROR; }
+
+    for (size_t i = 0; i < shaper->n_classes; i++) {
+        bucket_reset(&shaper->classes[i].bucket);
+        memset(&shaper->classes[i]._stats, 0, sizeof(picoros_shaper_stats_t));
+    }
+    shaper->_users = 0;
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (z_mutex_init(&shaper->_mutex) != Z_OK) {
+        _PR_LOG("Unable to init shaper mutex!\n");
         return PICOROS_ERROR;
     }
+#endif
+    return PICOROS_OK;
+}
+
+picoros_res_t picoros_shaper_deinit(picoros_shaper_t* shaper) {
+    if (shaper == NULL) { return PICOROS_ERROR; }
+
+    _PR_LOCK(&shaper->_mutex);
+    uint32_t users = shaper->_users;
+    _PR_UNLOCK(&shaper->_mutex);
+    if (users > 0) {
+        return PICOROS_NOT_READY;
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    z_mutex_drop(z_mutex_move(&shaper->_mutex));
+#endif
+    return PICOROS_OK;
+}
+
+picoros_res_t picoros_shaper_stats(picoros_shaper_t* shaper, size_t class_idx, picoros_shaper_stats_t* stats) {
+    if (shaper == NULL || class_idx >= shaper->n_classes || stats == NULL) { return PICOROS_ERROR; }
+
+    _PR_LOCK(&shaper->_mutex);
+    *stats = shaper->classes[class_idx]._stats;
+    _PR_UNLOCK(&shaper->_mutex);
     return PICOROS_OK;
 }
 
@@ -370,21 +1136,34 @@ picoros_res_t picoros_subscriber_declare(picoros_node_t* node, picoros_subscribe
     }
 
     z_owned_closure_sample_t callback;
-    z_closure_sample(&callback, sub_data_handler, NULL, NULL);
-    callback._val.context = sub->user_callback;
+    if (sub->batch != NULL) {
+        if (sub_batch_start(sub->batch) != PICOROS_OK) {
+            return PICOROS_ERROR;
+        }
+        z_closure_sample(&callback, sub_batch_handler, NULL, sub);
+    }
+    else {
+        z_closure_sample(&callback, sub_data_handler, NULL, sub);
+    }
 
     if ((res = z_declare_subscriber(z_session_loan(&s_wrapper), &sub->zsub, z_view_keyexpr_loan(&ke),
                                     z_closure_sample_move(&callback), NULL)) != Z_OK) {
         _PR_LOG("Unable to declare subscriber! Error:%d\n", res);
+        if (sub->batch != NULL) {
+            sub_batch_stop(sub->batch);
+        }
         return PICOROS_ERROR;
     }
 
     if (sub->topic.type != NULL) {
         rmw_zenoh_topic_liveliness_keyexpr(node, &sub->topic, keyexpr, "MS");
         z_view_keyexpr_from_str(&ke, keyexpr);
-        z_owned_liveliness_token_t token;
-        if ((res = z_liveliness_declare_token(z_session_loan(&s_wrapper), &token, z_view_keyexpr_loan(&ke), NULL)) != Z_OK) {
+        if ((res = z_liveliness_declare_token(z_session_loan(&s_wrapper), &sub->_token, z_view_keyexpr_loan(&ke), NULL)) != Z_OK) {
             _PR_LOG("Unable to declare subscriber liveliness token! Error:%d\n", res);
+            z_undeclare_subscriber(z_subscriber_move(&sub->zsub));
+            if (sub->batch != NULL) {
+                sub_batch_stop(sub->batch);
+            }
             return PICOROS_ERROR;
         }
     }
@@ -418,17 +1197,24 @@ picoros_res_t picoros_service_declare(picoros_node_t* node, picoros_srv_server_t
     }
     if (srv->topic.type != NULL) {
         z_view_keyexpr_t ke2;
-        z_owned_liveliness_token_t token;
         rmw_zenoh_topic_liveliness_keyexpr(node, &srv->topic, keyexpr, "SS");
         z_view_keyexpr_from_str(&ke2, keyexpr);
-        if ((res = z_liveliness_declare_token(z_session_loan(&s_wrapper), &token, z_view_keyexpr_loan(&ke2), NULL)) != Z_OK) {
+        if ((res = z_liveliness_declare_token(z_session_loan(&s_wrapper), &srv->_token, z_view_keyexpr_loan(&ke2), NULL)) != Z_OK) {
             _PR_LOG("Unable to declare service liveliness token! Error:%d\n", res);
+            z_undeclare_queryable(z_queryable_move(&srv->zqable));
             return PICOROS_ERROR;
         }
     }
     return PICOROS_OK;
 }
 
+picoros_res_t picoros_service_undeclare(picoros_srv_server_t* srv) {
+    // remove service from ROS graph before it stops answering
+    if (srv->topic.type != NULL) {
+        z_liveliness_undeclare_token(z_liveliness_token_move(&srv->_token));
+    }
+    return (z_undeclare_queryable(z_queryable_move(&srv->zqable)) == Z_OK) ? PICOROS_OK : PICOROS_ERROR;
+}
 
 picoros_res_t picoros_service_client_init(picoros_srv_client_t * client){
     if (client->_key_buf == NULL){
@@ -502,10 +1288,122 @@ picoros_res_t picoros_service_call(picoros_srv_client_t * client, uint8_t* paylo
     return PICOROS_OK;
 }
 
+picoros_res_t picoros_service_call_async(picoros_srv_client_t* client, picoros_srv_call_t* call, uint8_t* payload, size_t len){
+    if (call == NULL) { return PICOROS_ERROR;}
+    if (client == NULL) {
+        if (call->drop_callback != NULL) { call->drop_callback(call); }
+        return PICOROS_ERROR;
+    }
+
+    z_result_t res;
+
+    // create key expression if not done before
+    if (client->_key_buf == NULL){
+        picoros_service_client_init(client);
+    }
+
+    // Per call copy of options
+    z_get_options_t opts;
+    z_get_options_default(&opts);
+    if (client->opts != NULL){
+        opts = *client->opts;
+    }
+    if (call->timeout_ms != 0){
+        opts.timeout_ms = call->timeout_ms;
+    }
+
+    // Payload
+    z_owned_bytes_t zbytes;
+    z_bytes_copy_from_buf(&zbytes, payload, len);
+    opts.payload = z_bytes_move(&zbytes);
+
+    // RMW attachment
+    rmw_attachment_t attachment = {
+        .rmw_gid_size = RMW_GID_SIZE,
+        .sequence_number = 1,
+        .time = z_clock_now().tv_nsec,
+    };
+    z_owned_bytes_t tx_attachment;
+    z_bytes_copy_from_buf(&tx_attachment, (uint8_t*)&attachment, sizeof(rmw_attachment_t));
+    opts.attachment = z_bytes_move(&tx_attachment);
+
+    // Closure
+    z_owned_closure_reply_t callback = {
+        ._val.call = call_data_handler,
+        ._val.drop = call_drop_handler,
+        ._val.context = call,
+    };
+
+    call->_state = CALL_SENDING;
+    res = z_get(z_session_loan(&s_wrapper), z_view_keyexpr_loan(&client->ke), "", z_closure_reply_move(&callback), &opts);
+    if (res != Z_OK) {
+        _PR_LOG("Error calling %s service! Error:%d\n", client->topic.name, res);
+        z_bytes_drop(opts.attachment);
+        z_bytes_drop(opts.payload);
+    }
+    // Finish drop that happened during z_get(), or end failed call
+    int state = _PR_ATOMIC_XCHG(&call->_state, (res == Z_OK) ? CALL_SENT : CALL_DROPPED);
+    if ((state == CALL_DROPPED || res != Z_OK) && call->drop_callback != NULL){
+        call->drop_callback(call);
+    }
+    return (res == Z_OK) ? PICOROS_OK : PICOROS_ERROR;
+}
+
 bool picoros_service_call_in_progress(picoros_srv_client_t* client){
     return client->_in_progress;
 }
 
+picoros_res_t picoros_service_client_undeclare(picoros_srv_client_t* client){
+    if (client->_in_progress) { return PICOROS_NOT_READY;}
+
+    if (client->_key_buf != NULL){
+        z_free(client->_key_buf);
+        client->_key_buf = NULL;
+    }
+    return PICOROS_OK;
+}
+
 picoros_res_t picoros_unsubscribe(picoros_subscriber_t* sub) {
-    return (z_undeclare_subscriber(z_subscriber_move(&sub->zsub)) == Z_OK) ? PICOROS_OK : PICOROS_ERROR;
+    // remove subscriber from ROS graph before it stops receiving
+    if (sub->topic.type != NULL) {
+        z_liveliness_undeclare_token(z_liveliness_token_move(&sub->_token));
+    }
+    picoros_res_t ret = (z_undeclare_subscriber(z_subscriber_move(&sub->zsub)) == Z_OK) ? PICOROS_OK : PICOROS_ERROR;
+    if (sub->batch != NULL) {
+        sub_batch_stop(sub->batch);
+    }
+    return ret;
+}
+
+picoros_res_t picoros_subscriber_poll(picoros_subscriber_t* sub) {
+    if (sub == NULL || sub->batch == NULL) { return PICOROS_ERROR; }
+    picoros_sub_batch_t* batch = sub->batch;
+    picoros_sample_t* taken = NULL;
+    size_t n_taken = 0;
+
+    _PR_LOCK(&batch->_mutex);
+    if (batch->_n_samples > 0 && batch->period_us != 0
+    && z_clock_elapsed_us(&batch->_first) >= batch->period_us) {
+        sub_batch_take(batch, &taken, &n_taken);
+    }
+    _PR_UNLOCK(&batch->_mutex);
+    if (taken != NULL) {
+        sub_batch_deliver(batch, taken, n_taken);
+    }
+    return PICOROS_OK;
+}
+
+picoros_res_t picoros_subscriber_flush(picoros_subscriber_t* sub) {
+    if (sub == NULL || sub->batch == NULL) { return PICOROS_ERROR; }
+
+    picoros_sample_t* taken = NULL;
+    size_t n_taken = 0;
+
+    _PR_LOCK(&sub->batch->_mutex);
+    sub_batch_take(sub->batch, &taken, &n_taken);
+    _PR_UNLOCK(&sub->batch->_mutex);
+    if (taken != NULL) {
+        sub_batch_deliver(sub->batch, taken, n_taken);
+    }
+    return PICOROS_OK;
 }
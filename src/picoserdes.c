@@ -13,12 +13,63 @@
 /* Private includes ----------------------------------------------------------*/
 #include "picoserdes.h"
 #include <string.h>
+#include <stdlib.h>
 #include <stdio.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#ifdef PS_PARALLEL
+#include <pthread.h>
+#endif
 /* Private typedef -----------------------------------------------------------*/
+#ifdef PS_PARALLEL
+// Thread pool of plain copies, one block is copied at a time in chunks taken by all threads
+typedef struct {
+    pthread_mutex_t mutex;          // guards generation, active and stop
+    pthread_cond_t  start;          // new block or stop for workers
+    pthread_cond_t  done;           // last worker finished block
+    pthread_mutex_t job;            // held by thread copying block
+    pthread_t       threads[PS_PARALLEL_MAX_THREADS];
+    unsigned        n_threads;      // 0 when pool is stopped
+    size_t          threshold;
+    unsigned        generation;     // incremented for each block
+    unsigned        active;         // workers still copying block
+    bool            stop;
+    // current block
+    uint8_t*        dst;
+    const uint8_t*  src;
+    size_t          size;
+    size_t          align;
+    size_t          chunk;
+    size_t          next;           // start of next free chunk
+    bool            swap;
+} ps_pool_t;
+#endif
 /* Private define ------------------------------------------------------------*/
+// Fixed layout prefix is serialized with constant offsets, set 0 to always use per field calls
+#ifndef PS_FIXED_LAYOUT
+#define PS_FIXED_LAYOUT 1
+#endif
+#ifdef PS_PARALLEL
+// Parallel chunks are multiples of cache line, several chunks per thread balance uneven cores
+#define PS_PARALLEL_CHUNK_ALIGN 64u
+#define PS_PARALLEL_CHUNKS_PER_THREAD 4u
+#endif
 /* Private macro -------------------------------------------------------------*/
+// CDR padding before SIZE byte primitive at OFF, constant for constant OFF
+#define PS_FIX_PAD(OFF, SIZE) (((SIZE) - ((OFF) % (SIZE))) & ((SIZE) - 1))
 /* Private constants ---------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#ifdef PS_PARALLEL
+static ps_pool_t ps_pool = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+    .job = PTHREAD_MUTEX_INITIALIZER,
+};
+#endif
 
 // type name constants list
 #define TYPE_NAME(TYPE, NAME, HASH, ...) char TYPE##_name[] = NAME;
@@ -40,6 +91,10 @@ bool ps_ser_##TYPE(ucdrBuffer* writer, TYPE* msg) {
     return ucdr_serialize_##TYPE(writer, *msg);                                        \
 }                                                                                      \
 bool ps_ser_sequence_##TYPE(ucdrBuffer* writer, TYPE##_sequence* msg) {                \
+    if (PS_IS_PLAIN(ps_leaf_##TYPE) && writer->endianness == UCDR_MACHINE_ENDIANNESS){ \
+        return ucdr_serialize_uint32_t(writer, msg->n_elements)                        \
+            && ps_ser_plain(writer, msg->data, msg->n_elements * sizeof(TYPE), sizeof(TYPE)); \
+    }                                                                                  \
     return ucdr_serialize_sequence_##TYPE(writer, msg->data, msg->n_elements);         \
 }                                                                                      \
 bool ps_ser_array_##TYPE(ucdrBuffer* writer, TYPE* msg, uint32_t number) {             \
@@ -52,22 +107,831 @@ bool ps_des_##TYPE(ucdrBuffer* reader, TYPE* msg) {
 }                                                                                      \
 bool ps_des_sequence_##TYPE(ucdrBuffer* reader, TYPE##_sequence* msg) {                \
     uint32_t len = 0;                                                                  \
-    return ucdr_deserialize_sequence_##TYPE(reader, msg->data, msg->n_elements, &len); \
+    if (msg->data == NULL){                                                            \
+        if (ucdr_deserialize_uint32_t(reader, &len) == false){ return false; }         \
+        if (len == 0){ msg->n_elements = 0; return true; } /* no storage needed */      \
+        if (PS_IS_PLAIN(ps_leaf_##TYPE) && ps_des_view(reader, (void**)&msg->data,     \
+                &msg->n_elements, len, sizeof(TYPE), sizeof(TYPE))){ return true; }    \
+        msg->data = (TYPE*)ps_des_alloc(reader, len, sizeof(TYPE), _Alignof(TYPE));   \
+        if (msg->data == NULL){ return false; }                                        \
+        msg->n_elements = len;                                                         \
+    }                                                                                  \
+    else if (PS_IS_PLAIN(ps_leaf_##TYPE)){                                             \
+        if (ucdr_deserialize_uint32_t(reader, &len) == false){ return false; }         \
+        if (len > msg->n_elements){ return false; }                                    \
+        msg->n_elements = len;                                                         \
+    }                                                                                  \
+    else{                                                                              \
+        bool ret = ucdr_deserialize_sequence_##TYPE(reader, msg->data, msg->n_elements, &len); \
+        if (ret){                                                                      \
+            msg->n_elements = len;                                                     \
+        }                                                                              \
+        return ret;                                                                    \
+    }                                                                                  \
+    if (PS_IS_PLAIN(ps_leaf_##TYPE)){                                                  \
+        return ps_des_plain(reader, msg->data, len * sizeof(TYPE), sizeof(TYPE));      \
+    }                                                                                  \
+    for (uint32_t i = 0; i < len; i++){                                                \
+        if (ucdr_deserialize_##TYPE(reader, &msg->data[i]) == false){ return false; }  \
+    }                                                                                  \
+    return true;                                                                       \
 }                                                                                      \
 bool ps_des_array_##TYPE(ucdrBuffer* reader, TYPE* msg, uint32_t max_number) {         \
+    if (PS_IS_PLAIN(ps_leaf_##TYPE) && reader->endianness != UCDR_MACHINE_ENDIANNESS){ \
+        return ps_des_plain(reader, msg, max_number * sizeof(TYPE), sizeof(TYPE));     \
+    }                                                                                  \
     return ucdr_deserialize_array_##TYPE(reader, msg, max_number);                     \
 }
 
+// Base types serialized size, plain elements are copied at once so empty sequences have no padding
+#define PS_SIZE_BASE(TYPE)                                                             \
+size_t ps_size_##TYPE(size_t offset, TYPE* msg) {                                      \
+    return ps_size_leaf(offset, ps_plain_size_##TYPE, msg);                            \
+}                                                                                      \
+static size_t ps_size_elements_##TYPE(size_t offset, TYPE* msg, uint32_t number) {     \
+    if (PS_IS_PLAIN(ps_leaf_##TYPE)){                                                  \
+        return (number > 0) ? ps_size_leaf(offset, sizeof(TYPE), msg)                  \
+                              + (number - 1) * sizeof(TYPE) : offset;                  \
+    }                                                                                  \
+    for (uint32_t i = 0; i < number; i++){                                             \
+        offset = ps_size_leaf(offset, ps_plain_size_##TYPE, &msg[i]);                  \
+    }                                                                                  \
+    return offset;                                                                     \
+}                                                                                      \
+size_t ps_size_sequence_##TYPE(size_t offset, TYPE##_sequence* msg) {                  \
+    offset = ps_size_leaf(offset, sizeof(uint32_t), NULL);                             \
+    return ps_size_elements_##TYPE(offset, msg->data, msg->n_elements);                \
+}                                                                                      \
+size_t ps_size_array_##TYPE(size_t offset, TYPE* msg, uint32_t number) {               \
+    if (ps_plain_size_##TYPE == 0){                                                    \
+        offset = ps_size_leaf(offset, sizeof(uint32_t), NULL); /* string arrays carry count */ \
+    }                                                                                  \
+    return ps_size_elements_##TYPE(offset, msg, number);                               \
+}
+
+// Base types validation, mirrors deserialization of base types
+#define PS_VAL_BASE(TYPE)                                                              \
+size_t ps_val_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {                  \
+    return ps_val_leaf(cdr, len, offset, ps_plain_size_##TYPE);                        \
+}                                                                                      \
+static size_t ps_val_elements_##TYPE(const uint8_t* cdr, size_t len, size_t offset, uint32_t n) { \
+    if (ps_plain_size_##TYPE > 0){                                                     \
+        return ps_val_block(len, offset, sizeof(TYPE), sizeof(TYPE), n);               \
+    }                                                                                  \
+    for (uint32_t i = 0; i < n && offset != PS_VAL_FAIL; i++){                         \
+        offset = ps_val_leaf(cdr, len, offset, 0);                                     \
+    }                                                                                  \
+    return offset;                                                                     \
+}                                                                                      \
+size_t ps_val_sequence_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {         \
+    uint32_t n = 0;                                                                    \
+    offset = ps_val_count(cdr, len, offset, &n);                                       \
+    return ps_val_elements_##TYPE(cdr, len, offset, n);                                \
+}                                                                                      \
+static inline size_t ps_val_array_##TYPE(const uint8_t* cdr, size_t len, size_t offset, uint32_t number) { \
+    uint32_t n = number;                                                               \
+    if (ps_plain_size_##TYPE == 0){ /* string arrays carry count */                    \
+        offset = ps_val_count(cdr, len, offset, &n);                                   \
+        if (n > number){ return PS_VAL_FAIL; }                                         \
+    }                                                                                  \
+    return ps_val_elements_##TYPE(cdr, len, offset, n);                                \
+}
+
+// Point sequence data into reader buffer, possible only for aligned data in host endianness
+static bool ps_des_view(ucdrBuffer* reader, void** data, uint32_t* n_elements, uint32_t len, size_t size, size_t align){
+    if (len == 0){ // nothing to point at, no padding or alignment applies
+        *n_elements = 0;
+        return !reader->error;
+    }
+    if (reader->endianness != UCDR_MACHINE_ENDIANNESS){
+        return false;
+    }
+    size_t pad = ucdr_buffer_alignment(reader, align);
+    uint8_t* p = reader->iterator + pad;
+    if (p > reader->final || (size_t)(reader->final - p) / size < len){
+        reader->error = true;
+        return false;
+    }
+    if (((uintptr_t)p % align) != 0){
+        return false;
+    }
+    ucdr_advance_buffer(reader, pad + (size_t)len * size);
+    reader->last_data_size = (uint8_t)align;
+    *data = p;
+    *n_elements = len;
+    return !reader->error;
+}
+
+// Allocate sequence storage from arena given to ps_deserialize_arena(), NULL without arena
+static void* ps_des_alloc(ucdrBuffer* reader, uint32_t n, size_t size, size_t align){
+    if (reader->on_full_buffer != NULL || reader->args == NULL || reader->error){
+        return NULL;
+    }
+    // every element takes at least one byte of buffer, reject corrupted lengths early
+    if (n > (size_t)(reader->final - reader->iterator)){
+        reader->error = true;
+        return NULL;
+    }
+    return ps_arena_alloc((ps_arena_t*)reader->args, n, size, align);
+}
+
+
+#ifdef PS_PARALLEL
+// Copy chunks of current block until none is left, run by workers and by copying thread
+static void ps_pool_run(ps_pool_t* pool){
+    for (;;){
+        size_t start = __atomic_fetch_add(&pool->next, pool->chunk, __ATOMIC_RELAXED);
+        if (start >= pool->size){
+            return;
+        }
+        size_t n = (pool->size - start < pool->chunk) ? pool->size - start : pool->chunk;
+        memcpy(&pool->dst[start], &pool->src[start], n);
+        if (pool->swap){
+            ps_bswap(&pool->dst[start], n / pool->align, pool->align);
+        }
+    }
+}
+
+static void* ps_pool_worker(void* arg){
+    ps_pool_t* pool = (ps_pool_t*)arg;
+    unsigned seen = 0; // generation is reset by ps_parallel_init()
+    pthread_mutex_lock(&pool->mutex);
+    for (;;){
+        while (!pool->stop && pool->generation == seen){
+            pthread_cond_wait(&pool->start, &pool->mutex);
+        }
+        if (pool->stop){
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+        ps_pool_run(pool);
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->active == 0){
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+// Copy block with pool threads, false if pool is stopped, busy or block is small
+static bool ps_pool_copy(ps_pool_t* pool, void* dst, const void* src, size_t size, size_t align, bool swap){
+    unsigned n_threads = __atomic_load_n(&pool->n_threads, __ATOMIC_ACQUIRE);
+    if (n_threads == 0 || size < pool->threshold || pthread_mutex_trylock(&pool->job) != 0){
+        return false;
+    }
+    if (__atomic_load_n(&pool->n_threads, __ATOMIC_RELAXED) == 0){ // stopped before job lock was taken
+        pthread_mutex_unlock(&pool->job);
+        return false;
+    }
+    size_t chunk = size / ((n_threads + 1) * PS_PARALLEL_CHUNKS_PER_THREAD);
+    pthread_mutex_lock(&pool->mutex);
+    pool->dst = (uint8_t*)dst;
+    pool->src = (const uint8_t*)src;
+    pool->size = size;
+    pool->align = align;
+    pool->swap = swap;
+    pool->chunk = (chunk + PS_PARALLEL_CHUNK_ALIGN - 1) & ~(size_t)(PS_PARALLEL_CHUNK_ALIGN - 1);
+    pool->next = 0;
+    pool->active = n_threads;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+
+    ps_pool_run(pool);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->active > 0){
+        pthread_cond_wait(&pool->done, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->job);
+    return true;
+}
+
+// Contiguous CDR block of large plain copy, advanced past. NULL if copy is left to ucdr.
+static uint8_t* ps_parallel_block(ucdrBuffer* ub, size_t size){
+    uint8_t* block = ub->iterator;
+    if (__atomic_load_n(&ps_pool.n_threads, __ATOMIC_ACQUIRE) == 0 || size < ps_pool.threshold
+        || ucdr_buffer_remaining(ub) < size || ucdr_advance_buffer(ub, size) == false){
+        return NULL;
+    }
+    return block;
+}
+#else
+#define ps_parallel_block(UB, SIZE) ((uint8_t*)NULL)
+#endif
+
+// Plain types serialization with single copy, alignment and state match per member serialization
+// Plain type is written with single copy only in host byte order, reading swaps copied members
+#define PS_USE_PLAIN(TYPE, UB) (PS_IS_PLAIN(ps_leaf_##TYPE) && (UB)->endianness == UCDR_MACHINE_ENDIANNESS)
+
+static bool ps_ser_plain(ucdrBuffer* writer, const void* data, size_t size, size_t align){
+    if (size == 0){
+        return !writer->error;
+    }
+    size_t pad = ucdr_buffer_alignment(writer, align);
+    if (pad > 0 && ucdr_advance_buffer(writer, pad) == false){
+        return false;
+    }
+    bool ret = true;
+    uint8_t* block = ps_parallel_block(writer, size);
+    if (block != NULL){
+        ps_copy_plain(block, data, size, align, false);
+    }
+    else {
+        ret = ucdr_serialize_array_uint8_t(writer, (const uint8_t*)data, size);
+    }
+    writer->last_data_size = (uint8_t)align;
+    return ret;
+}
+
+static bool ps_des_plain(ucdrBuffer* reader, void* data, size_t size, size_t align){
+    if (size == 0){
+        return !reader->error;
+    }
+    size_t pad = ucdr_buffer_alignment(reader, align);
+    if (pad > 0 && ucdr_advance_buffer(reader, pad) == false){
+        return false;
+    }
+    // members of plain type have equal size, so foreign byte order is fixed by one swap pass
+    bool swap = align > 1 && reader->endianness != UCDR_MACHINE_ENDIANNESS;
+    bool ret = true;
+    uint8_t* block = ps_parallel_block(reader, size);
+    if (block != NULL){
+        ps_copy_plain(data, block, size, align, swap);
+    }
+    else {
+        ret = ucdr_deserialize_array_uint8_t(reader, (uint8_t*)data, size);
+        if (ret && swap){
+            ps_bswap(data, size / align, align);
+        }
+    }
+    reader->last_data_size = (uint8_t)align;
+    return ret;
+}
+
+// Serialized size of primitive, size 0 marks string
+static size_t ps_size_leaf(size_t offset, size_t size, const void* msg){
+    if (size == 0){
+        const char* str = *(char* const*)msg;
+        offset += ucdr_alignment(offset, sizeof(uint32_t)) + sizeof(uint32_t);
+        return offset + ((str != NULL) ? strlen(str) + 1 : 0);
+    }
+    return offset + ucdr_alignment(offset, size) + size;
+}
+
+// Check n elements of size bytes aligned to align fit into len, return offset after them
+static size_t ps_val_block(size_t len, size_t offset, size_t align, size_t size, uint32_t n){
+    if (offset == PS_VAL_FAIL || n == 0){
+        return offset;
+    }
+    offset += PS_FIX_PAD(offset, align);
+    if (offset > len || (len - offset) / size < n){
+        return PS_VAL_FAIL;
+    }
+    return offset + n * size;
+}
+
+// Check and read sequence length, lengths above remaining bytes can not be valid
+static size_t ps_val_count(const uint8_t* cdr, size_t len, size_t offset, uint32_t* n){
+    offset = ps_val_block(len, offset, sizeof(uint32_t), sizeof(uint32_t), 1);
+    if (offset == PS_VAL_FAIL){
+        return PS_VAL_FAIL;
+    }
+    memcpy(n, &cdr[offset - sizeof(uint32_t)], sizeof(uint32_t));
+    if (PS_CDR_ENDIANNESS(cdr - sizeof(uint32_t)) != UCDR_MACHINE_ENDIANNESS){
+        ps_bswap(n, 1, sizeof(uint32_t));
+    }
+    return (*n <= len - offset) ? offset : PS_VAL_FAIL;
+}
+
+// Validate primitive, size 0 marks string which must be null terminated
+static size_t ps_val_leaf(const uint8_t* cdr, size_t len, size_t offset, size_t size){
+    if (size > 0){
+        return ps_val_block(len, offset, size, size, 1);
+    }
+    uint32_t n = 0;
+    offset = ps_val_count(cdr, len, offset, &n);
+    offset = ps_val_block(len, offset, 1, 1, n);
+    if (offset != PS_VAL_FAIL && n > 0 && cdr[offset - 1] != '\0'){
+        return PS_VAL_FAIL;
+    }
+    return offset;
+}
+
+// Bounded string stored inline as char[bound + 1], longer or unterminated string is an error
+static bool ps_ser_bstring(ucdrBuffer* writer, char* str, uint32_t bound){
+    if (strnlen(str, (size_t)bound + 1) > bound){
+        writer->error = true;
+        return false;
+    }
+    return ucdr_serialize_string(writer, str);
+}
+
+static bool ps_des_bstring(ucdrBuffer* reader, char* str, uint32_t bound){
+    bool ret = ucdr_deserialize_string(reader, str, (size_t)bound + 1);
+    str[bound] = '\0';
+    return ret;
+}
+
+static size_t ps_size_bstring(size_t offset, char* str){
+    return ps_size_leaf(offset, 0, &str);
+}
+
+static size_t ps_val_bstring(const uint8_t* cdr, size_t len, size_t offset, uint32_t bound){
+    uint32_t n = 0;
+    if (ps_val_count(cdr, len, offset, &n) == PS_VAL_FAIL || n > bound + 1){
+        return PS_VAL_FAIL;
+    }
+    return ps_val_leaf(cdr, len, offset, 0);
+}
+
+// Match first name of dot separated path, return rest of path or NULL
+static const char* ps_seek_match(const char* path, const char* name){
+    size_t n = strlen(name);
+    if (strncmp(path, name, n) != 0 || (path[n] != '\0' && path[n] != '.')){
+        return NULL;
+    }
+    return (path[n] == '.') ? &path[n + 1] : &path[n];
+}
+
 BASE_TYPES_LIST(PS_SER_BASE)
 BASE_TYPES_LIST(PS_DES_BASE)
+BASE_TYPES_LIST(PS_SIZE_BASE)
+BASE_TYPES_LIST(PS_VAL_BASE)
+
+// Base types have no fields to seek
+#define PS_SEEK_BASE(TYPE)                                                                      \
+size_t ps_seek_##TYPE(const uint8_t* cdr, size_t len, size_t offset, const char* path) {       \
+    (void)cdr; (void)len; (void)offset; (void)path;                                             \
+    return PS_VAL_FAIL;                                                                         \
+}
+
+BASE_TYPES_LIST(PS_SEEK_BASE)
+
+// Fixed layout block operations, offsets are relative to 8 byte aligned CDR position. Operation
+// is constant at each call site so inlined blocks reduce to copies at constant offsets.
+enum { PS_FIX_END, PS_FIX_PUT, PS_FIX_GET };
+
+// Base types fixed layout, returns offset after field and copies it for PUT / GET
+#define PS_FIX_BASE(TYPE)                                                                       \
+static inline size_t ps_fix_array_##TYPE(int op, uint8_t* p, size_t off, TYPE* msg, uint32_t n){ \
+    off += PS_FIX_PAD(off, sizeof(TYPE));                                                       \
+    if (op == PS_FIX_PUT){                                                                      \
+        memcpy(&p[off], msg, n * sizeof(TYPE));                                                 \
+    }                                                                                           \
+    else if (op == PS_FIX_GET && sizeof(TYPE) == 1 && ps_leaf_##TYPE == PS_LEAF_NOT_PLAIN){     \
+        for (uint32_t i = 0; i < n; i++){ ((uint8_t*)msg)[i] = (p[off + i] != 0); } /* bool */  \
+    }                                                                                           \
+    else if (op == PS_FIX_GET){                                                                 \
+        memcpy(msg, &p[off], n * sizeof(TYPE));                                                 \
+    }                                                                                           \
+    return off + n * sizeof(TYPE);                                                              \
+}                                                                                               \
+static inline size_t ps_fix_##TYPE(int op, uint8_t* p, size_t off, TYPE* msg){                 \
+    return ps_fix_array_##TYPE(op, p, off, msg, 1);                                             \
+}
+
+BASE_TYPES_LIST(PS_FIX_BASE)
+
+#ifdef PS_TABLE_DRIVEN
+// Sequence of any type, all TYPE_sequence structs share this layout
+typedef struct {
+    void* data;
+    uint32_t n_elements;
+} ps_any_sequence_t;
+
+// Base type members are handled by base type functions of matching kind
+#define PS_TBL_SER_BASE(TYPE) case PS_BASE_##TYPE:                                             \
+    return (kind == PS_KIND_FIELD) ? ps_ser_##TYPE(writer, (TYPE*)msg)                         \
+         : (kind == PS_KIND_ARRAY) ? ps_ser_array_##TYPE(writer, (TYPE*)msg, count)            \
+         : ps_ser_sequence_##TYPE(writer, (TYPE##_sequence*)msg);
+
+#define PS_TBL_DES_BASE(TYPE) case PS_BASE_##TYPE:                                             \
+    return (kind == PS_KIND_FIELD) ? ps_des_##TYPE(reader, (TYPE*)msg)                         \
+         : (kind == PS_KIND_ARRAY) ? ps_des_array_##TYPE(reader, (TYPE*)msg, count)            \
+         : ps_des_sequence_##TYPE(reader, (TYPE##_sequence*)msg);
+
+#define PS_TBL_SIZE_BASE(TYPE) case PS_BASE_##TYPE:                                            \
+    return (kind == PS_KIND_FIELD) ? ps_size_##TYPE(offset, (TYPE*)msg)                        \
+         : (kind == PS_KIND_ARRAY) ? ps_size_array_##TYPE(offset, (TYPE*)msg, count)           \
+         : ps_size_sequence_##TYPE(offset, (TYPE##_sequence*)msg);
+
+#define PS_TBL_VAL_BASE(TYPE) case PS_BASE_##TYPE:                                             \
+    return (kind == PS_KIND_FIELD) ? ps_val_##TYPE(cdr, len, offset)                           \
+         : (kind == PS_KIND_ARRAY) ? ps_val_array_##TYPE(cdr, len, offset, count)              \
+         : ps_val_sequence_##TYPE(cdr, len, offset);
+
+// Element count of inline bounded sequence, uint32_t following bound elements
+static inline uint32_t* ps_tbl_inline_count(const ps_type_desc_t* desc, uint8_t* msg, uint32_t bound){
+    size_t data = (size_t)bound * desc->size;
+    return (uint32_t*)(msg + data + PS_FIX_PAD(data, _Alignof(uint32_t)));
+}
+
+// Table driven serialization of count elements of type at msg, sequence kind reads count from msg
+static bool ps_tbl_ser(ucdrBuffer* writer, const ps_type_desc_t* desc, uint8_t* msg, uint16_t kind, uint32_t count){
+    if (kind == PS_KIND_BOUNDED_STRING){
+        return ps_ser_bstring(writer, (char*)msg, count);
+    }
+    if (kind == PS_KIND_BOUNDED_SEQUENCE){
+        ps_any_sequence_t seq = { msg, *ps_tbl_inline_count(desc, msg, count) };
+        if (seq.n_elements > count){
+            writer->error = true;
+            return false;
+        }
+        return ps_tbl_ser(writer, desc, (uint8_t*)&seq, PS_KIND_SEQUENCE, 0);
+    }
+    switch (desc->base){
+        BASE_TYPES_LIST(PS_TBL_SER_BASE)
+        default: break;
+    }
+    if (kind == PS_KIND_SEQUENCE){
+        ps_any_sequence_t* seq = (ps_any_sequence_t*)msg;
+        ucdr_serialize_uint32_t(writer, seq->n_elements);
+        msg = (uint8_t*)seq->data;
+        count = seq->n_elements;
+    }
+    if (PS_IS_PLAIN(desc->leaf) && writer->endianness == UCDR_MACHINE_ENDIANNESS){
+        return ps_ser_plain(writer, msg, count * desc->size, PS_PLAIN_ALIGN(desc->leaf));
+    }
+    for (uint32_t i = 0; i < count; i++, msg += desc->size){
+        for (uint16_t f = 0; f < desc->n_fields; f++){
+            const ps_field_desc_t* field = &desc->fields[f];
+            if (ps_tbl_ser(writer, field->type(), msg + field->offset, field->kind, field->count) == false){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Table driven deserialization, sequences follow generated code: view, arena or given storage
+static bool ps_tbl_des(ucdrBuffer* reader, const ps_type_desc_t* desc, uint8_t* msg, uint16_t kind, uint32_t count){
+    if (kind == PS_KIND_BOUNDED_STRING){
+        return ps_des_bstring(reader, (char*)msg, count);
+    }
+    if (kind == PS_KIND_BOUNDED_SEQUENCE){
+        ps_any_sequence_t seq = { msg, count };
+        bool ret = ps_tbl_des(reader, desc, (uint8_t*)&seq, PS_KIND_SEQUENCE, 0);
+        *ps_tbl_inline_count(desc, msg, count) = ret ? seq.n_elements : 0;
+        return ret;
+    }
+    switch (desc->base){
+        BASE_TYPES_LIST(PS_TBL_DES_BASE)
+        default: break;
+    }
+    if (kind == PS_KIND_SEQUENCE){
+        ps_any_sequence_t* seq = (ps_any_sequence_t*)msg;
+        uint32_t elements = 0;
+        ucdr_deserialize_uint32_t(reader, &elements);
+        if (reader->on_full_buffer == NULL && elements > (size_t)(reader->final - reader->iterator)){
+            reader->error = true; // every element takes at least one byte
+            return false;
+        }
+        if (seq->data == NULL){
+            if (elements == 0){ // no storage needed
+                seq->n_elements = 0;
+                return !reader->error;
+            }
+            if (PS_IS_PLAIN(desc->leaf) && ps_des_view(reader, &seq->data, &seq->n_elements,
+                    elements, desc->size, PS_PLAIN_ALIGN(desc->leaf))){
+                return true;
+            }
+            seq->data = ps_des_alloc(reader, elements, desc->size, desc->align);
+            if (seq->data == NULL){
+                return false;
+            }
+            seq->n_elements = elements;
+        }
+        if (elements > seq->n_elements){
+            return false;
+        }
+        seq->n_elements = elements;
+        msg = (uint8_t*)seq->data;
+        count = elements;
+    }
+    if (PS_IS_PLAIN(desc->leaf)){
+        return ps_des_plain(reader, msg, count * desc->size, PS_PLAIN_ALIGN(desc->leaf));
+    }
+    for (uint32_t i = 0; i < count; i++, msg += desc->size){
+        for (uint16_t f = 0; f < desc->n_fields; f++){
+            const ps_field_desc_t* field = &desc->fields[f];
+            if (ps_tbl_des(reader, field->type(), msg + field->offset, field->kind, field->count) == false){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Table driven serialized size
+static size_t ps_tbl_size(size_t offset, const ps_type_desc_t* desc, uint8_t* msg, uint16_t kind, uint32_t count){
+    if (kind == PS_KIND_BOUNDED_STRING){
+        return ps_size_bstring(offset, (char*)msg);
+    }
+    if (kind == PS_KIND_BOUNDED_SEQUENCE){
+        ps_any_sequence_t seq = { msg, *ps_tbl_inline_count(desc, msg, count) };
+        return ps_tbl_size(offset, desc, (uint8_t*)&seq, PS_KIND_SEQUENCE, 0);
+    }
+    switch (desc->base){
+        BASE_TYPES_LIST(PS_TBL_SIZE_BASE)
+        default: break;
+    }
+    if (kind == PS_KIND_SEQUENCE){
+        ps_any_sequence_t* seq = (ps_any_sequence_t*)msg;
+        offset = ps_size_leaf(offset, sizeof(uint32_t), NULL);
+        msg = (uint8_t*)seq->data;
+        count = seq->n_elements;
+    }
+    if (PS_IS_PLAIN(desc->leaf)){
+        return (count > 0) ? offset + ucdr_alignment(offset, PS_PLAIN_ALIGN(desc->leaf))
+                             + count * desc->size : offset;
+    }
+    for (uint32_t i = 0; i < count; i++, msg += desc->size){
+        for (uint16_t f = 0; f < desc->n_fields; f++){
+            const ps_field_desc_t* field = &desc->fields[f];
+            offset = ps_tbl_size(offset, field->type(), msg + field->offset, field->kind, field->count);
+        }
+    }
+    return offset;
+}
+
+// Table driven validation, failed offset stays PS_VAL_FAIL through remaining fields
+static size_t ps_tbl_val(const uint8_t* cdr, size_t len, size_t offset, const ps_type_desc_t* desc, uint16_t kind, uint32_t count){
+    if (kind == PS_KIND_BOUNDED_STRING){
+        return ps_val_bstring(cdr, len, offset, count);
+    }
+    if (kind == PS_KIND_BOUNDED_SEQUENCE){
+        uint32_t n = 0;
+        if (ps_val_count(cdr, len, offset, &n) == PS_VAL_FAIL || n > count){
+            return PS_VAL_FAIL;
+        }
+        kind = PS_KIND_SEQUENCE;
+    }
+    switch (desc->base){
+        BASE_TYPES_LIST(PS_TBL_VAL_BASE)
+        default: break;
+    }
+    if (kind == PS_KIND_SEQUENCE){
+        offset = ps_val_count(cdr, len, offset, &count);
+    }
+    if (PS_IS_PLAIN(desc->leaf)){
+        return ps_val_block(len, offset, PS_PLAIN_ALIGN(desc->leaf), desc->size, count);
+    }
+    for (uint32_t i = 0; i < count && offset != PS_VAL_FAIL; i++){
+        for (uint16_t f = 0; f < desc->n_fields; f++){
+            const ps_field_desc_t* field = &desc->fields[f];
+            offset = ps_tbl_val(cdr, len, offset, field->type(), field->kind, field->count);
+        }
+    }
+    return offset;
+}
+
+// Table driven view init, field offsets struct of view is array of uint32_t in field order
+static size_t ps_tbl_view(const uint8_t* cdr, size_t len, size_t offset, const ps_type_desc_t* desc, uint32_t* at){
+    for (uint16_t f = 0; f < desc->n_fields && offset != PS_VAL_FAIL; f++){
+        const ps_field_desc_t* field = &desc->fields[f];
+        at[f] = (uint32_t)offset;
+        offset = ps_tbl_val(cdr, len, offset, field->type(), field->kind, field->count);
+    }
+    return offset;
+}
+
+// Table driven field seek
+static size_t ps_tbl_seek(const uint8_t* cdr, size_t len, size_t offset, const ps_type_desc_t* desc, const char* path){
+    for (uint16_t f = 0; f < desc->n_fields && offset != PS_VAL_FAIL; f++){
+        const ps_field_desc_t* field = &desc->fields[f];
+        const char* rest = ps_seek_match(path, field->name);
+        if (rest != NULL && *rest == '\0'){
+            return offset;
+        }
+        if (rest != NULL){
+            return (field->kind == PS_KIND_FIELD) ? ps_tbl_seek(cdr, len, offset, field->type(), rest) : PS_VAL_FAIL;
+        }
+        offset = ps_tbl_val(cdr, len, offset, field->type(), field->kind, field->count);
+    }
+    return PS_VAL_FAIL;
+}
+#endif
+
 
 /* Public functions ----------------------------------------------------------*/
 
+/* ----- deserialization arena -----------------------------------------------*/
+void* ps_arena_alloc(ps_arena_t* arena, size_t n, size_t size, size_t align){
+    // align address, arena storage itself may be unaligned
+    uintptr_t base = (uintptr_t)arena->buf;
+    size_t start = (size_t)(((base + arena->used + align - 1) & ~(uintptr_t)(align - 1)) - base);
+    if (start > arena->size || (size != 0 && n > (arena->size - start) / size)){
+        return NULL;
+    }
+    void* p = &arena->buf[start];
+    memset(p, 0, n * size);
+    arena->used = start + n * size;
+    return p;
+}
+
+void ps_arena_reset(ps_arena_t* arena){
+    arena->used = 0;
+}
+
+/* ----- byte order ----------------------------------------------------------*/
+void ps_bswap(void* data, size_t n, size_t size){
+    uint8_t* p = (uint8_t*)data;
+    size_t i = 0;
+    if (size != 2 && size != 4 && size != 8){
+        return;
+    }
+#if defined(__SSSE3__)
+    // one shuffle reverses bytes of every element in 16 byte block
+    static const uint8_t masks[3][16] = {
+        {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+        {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+        {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8},
+    };
+    __m128i mask = _mm_loadu_si128((const __m128i*)masks[(size == 2) ? 0 : (size == 4) ? 1 : 2]);
+    for (; i + 16 <= n * size; i += 16){
+        __m128i v = _mm_loadu_si128((const __m128i*)&p[i]);
+        _mm_storeu_si128((__m128i*)&p[i], _mm_shuffle_epi8(v, mask));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= n * size; i += 16){
+        uint8x16_t v = vld1q_u8(&p[i]);
+        v = (size == 2) ? vrev16q_u8(v) : (size == 4) ? vrev32q_u8(v) : vrev64q_u8(v);
+        vst1q_u8(&p[i], v);
+    }
+#endif
+    // remaining elements, unaligned data is accessed through copies
+    for (; i < n * size; i += size){
+        if (size == 2){
+            uint16_t v;
+            memcpy(&v, &p[i], sizeof(v));
+            v = __builtin_bswap16(v);
+            memcpy(&p[i], &v, sizeof(v));
+        }
+        else if (size == 4){
+            uint32_t v;
+            memcpy(&v, &p[i], sizeof(v));
+            v = __builtin_bswap32(v);
+            memcpy(&p[i], &v, sizeof(v));
+        }
+        else {
+            uint64_t v;
+            memcpy(&v, &p[i], sizeof(v));
+            v = __builtin_bswap64(v);
+            memcpy(&p[i], &v, sizeof(v));
+        }
+    }
+}
+
+/* ----- parallel plain copies -----------------------------------------------*/
+void ps_copy_plain(void* dst, const void* src, size_t size, size_t align, bool swap){
+    swap = swap && align > 1;
+#ifdef PS_PARALLEL
+    if (ps_pool_copy(&ps_pool, dst, src, size, align, swap)){
+        return;
+    }
+#endif
+    memcpy(dst, src, size);
+    if (swap){
+        ps_bswap(dst, size / align, align);
+    }
+}
+
+#ifdef PS_PARALLEL
+bool ps_parallel_init(unsigned n_threads, size_t threshold){
+    if (ps_pool.n_threads > 0 || n_threads == 0 || n_threads > PS_PARALLEL_MAX_THREADS){
+        return false;
+    }
+    ps_pool.threshold = (threshold > 0) ? threshold : PS_PARALLEL_MIN_SIZE;
+    ps_pool.stop = false;
+    ps_pool.generation = 0;
+    for (unsigned i = 0; i < n_threads; i++){
+        if (pthread_create(&ps_pool.threads[i], NULL, ps_pool_worker, &ps_pool) != 0){
+            pthread_mutex_lock(&ps_pool.mutex);
+            ps_pool.stop = true;
+            pthread_cond_broadcast(&ps_pool.start);
+            pthread_mutex_unlock(&ps_pool.mutex);
+            while (i > 0){
+                pthread_join(ps_pool.threads[--i], NULL);
+            }
+            return false;
+        }
+    }
+    __atomic_store_n(&ps_pool.n_threads, n_threads, __ATOMIC_RELEASE);
+    return true;
+}
+
+void ps_parallel_deinit(void){
+    unsigned n_threads = ps_pool.n_threads;
+    if (n_threads == 0){
+        return;
+    }
+    __atomic_store_n(&ps_pool.n_threads, 0, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&ps_pool.job); // wait for running copy
+    pthread_mutex_lock(&ps_pool.mutex);
+    ps_pool.stop = true;
+    pthread_cond_broadcast(&ps_pool.start);
+    pthread_mutex_unlock(&ps_pool.mutex);
+    for (unsigned i = 0; i < n_threads; i++){
+        pthread_join(ps_pool.threads[i], NULL);
+    }
+    pthread_mutex_unlock(&ps_pool.job);
+}
+#endif
+
+/* ----- message views -------------------------------------------------------*/
+size_t ps_view_count(const uint8_t* buf, size_t len, size_t offset, uint32_t* n){
+    if (len < sizeof(uint32_t)){
+        return PS_VAL_FAIL;
+    }
+    return ps_val_count(buf + sizeof(uint32_t), len - sizeof(uint32_t), offset, n);
+}
+
+/* ----- serialized message templates ----------------------------------------*/
+// Element index of path ending in [N], path is cut before index
+static bool ps_template_index(char* path, uint32_t* idx){
+    size_t n = strlen(path);
+    char* open = strrchr(path, '[');
+    if (open == NULL || path[n - 1] != ']'){
+        *idx = 0;
+        return false;
+    }
+    *idx = (uint32_t)strtoul(open + 1, NULL, 10);
+    *open = '\0';
+    return true;
+}
+
+// CDR offset of field in serialized template, element paths name array or sequence (x.data[N])
+static size_t ps_template_locate(const ps_template_t* tpl, ps_seek_t seek, const ps_template_field_t* field){
+    char path[PS_TEMPLATE_MAX_PATH];
+    if (strlen(field->path) >= sizeof(path)){
+        return PS_VAL_FAIL;
+    }
+    strcpy(path, field->path);
+    const uint8_t* cdr = tpl->buf + sizeof(uint32_t);
+    size_t len = tpl->len - sizeof(uint32_t);
+    uint32_t idx = 0;
+    bool element = ps_template_index(path, &idx);
+    size_t offset = (seek != NULL) ? seek(cdr, len, 0, path) : PS_VAL_FAIL;
+    size_t n = strlen(path);
+    bool sequence = offset == PS_VAL_FAIL && element && n >= 4 && strcmp(&path[n - 4], "data") == 0
+                    && (n == 4 || path[n - 5] == '.');
+    if (sequence){
+        path[(n == 4) ? 0 : n - 5] = '\0';
+        offset = (path[0] == '\0') ? 0 : (seek != NULL) ? seek(cdr, len, 0, path) : PS_VAL_FAIL;
+        uint32_t count = 0;
+        offset = (offset != PS_VAL_FAIL) ? ps_val_count(cdr, len, offset, &count) : PS_VAL_FAIL;
+        if (idx >= count){
+            return PS_VAL_FAIL;
+        }
+    }
+    offset = ps_val_block(len, offset, field->size, field->size, idx + 1);
+    return (offset != PS_VAL_FAIL) ? offset - field->size + sizeof(uint32_t) : PS_VAL_FAIL;
+}
+
+bool ps_template_record(ps_template_t* tpl, ps_seek_t seek, const ps_template_field_t* fields, size_t n){
+    tpl->n_fields = 0;
+    if (tpl->len <= sizeof(uint32_t) || n > PS_TEMPLATE_MAX_FIELDS){
+        return false; // 0 on serialization error
+    }
+    for (size_t i = 0; i < n; i++){
+        size_t offset = (fields[i].size > 0) ? ps_template_locate(tpl, seek, &fields[i]) : PS_VAL_FAIL;
+        if (offset == PS_VAL_FAIL){
+            return false;
+        }
+        tpl->fields[tpl->n_fields] = fields[i];
+        tpl->fields[tpl->n_fields++].offset = (uint32_t)offset;
+    }
+    return true;
+}
+
+void ps_template_update(ps_template_t* tpl){
+    for (size_t i = 0; i < tpl->n_fields; i++){
+        ps_template_field_t* f = &tpl->fields[i];
+        memcpy(&tpl->buf[f->offset], f->src, f->size);
+    }
+}
+
+bool ps_template_patch(ps_template_t* tpl, size_t idx, const void* value, size_t size){
+    if (idx >= tpl->n_fields || tpl->fields[idx].size != size){
+        return false;
+    }
+    memcpy(&tpl->buf[tpl->fields[idx].offset], value, size);
+    return true;
+}
+
 /* ----- ucdr helper functions -----------------------------------------------*/
 // Deserialize string without copy
 bool ucdr_deserialize_rstring(ucdrBuffer* ub, char** pstring){
     uint32_t len = 0;
     bool ret = ucdr_deserialize_endian_uint32_t(ub, ub->endianness, &len);
+    if (ret && len > (size_t)(ub->final - ub->iterator)){
+        ub->error = true;
+        return false;
+    }
     if (ret){
         *pstring = (char*)ub->iterator;
         ub->iterator += len;
@@ -152,23 +1016,186 @@ void ucdr_seq_end(ucdr_writer_t* writer){
 
 // User message and service serdes implementation
 #define EXP_TOKEN(...) __VA_ARGS__
-#define PS_SER_TYPE(TYPE, FIELD)                                                                \
-    if( ps_ser_##TYPE(writer, &msg->FIELD) != true){ return false; }
+
+// Field operations, optional bound selects bounded string or sequence stored inline. Inline
+// sequences reuse sequence functions through TYPE_sequence pointing to their data. Function
+// and sequence type names are pasted by caller, so FUNC and SEQ are never macro expanded.
+#define PS_FIELD_SER(FUNC, ...) PS_BOUNDED(PS_FIELD_SER_TYPE, PS_FIELD_SER_STRING, __VA_ARGS__)(FUNC, __VA_ARGS__)
+#define PS_FIELD_SER_TYPE(FUNC, FIELD) FUNC(writer, &msg->FIELD)
+#define PS_FIELD_SER_STRING(FUNC, FIELD, BOUND) ps_ser_bstring(writer, msg->FIELD, BOUND)
+
+#define PS_FIELD_DES(FUNC, ...) PS_BOUNDED(PS_FIELD_DES_TYPE, PS_FIELD_DES_STRING, __VA_ARGS__)(FUNC, __VA_ARGS__)
+#define PS_FIELD_DES_TYPE(FUNC, FIELD) FUNC(reader, &msg->FIELD)
+#define PS_FIELD_DES_STRING(FUNC, FIELD, BOUND) ps_des_bstring(reader, msg->FIELD, BOUND)
+
+#define PS_FIELD_SIZE(FUNC, ...) PS_BOUNDED(PS_FIELD_SIZE_TYPE, PS_FIELD_SIZE_STRING, __VA_ARGS__)(FUNC, __VA_ARGS__)
+#define PS_FIELD_SIZE_TYPE(FUNC, FIELD) FUNC(offset, &msg->FIELD)
+#define PS_FIELD_SIZE_STRING(FUNC, FIELD, BOUND) ps_size_bstring(offset, msg->FIELD)
+
+#define PS_FIELD_VAL(FUNC, ...) PS_BOUNDED(PS_FIELD_VAL_TYPE, PS_FIELD_VAL_STRING, __VA_ARGS__)(FUNC, __VA_ARGS__)
+#define PS_FIELD_VAL_TYPE(FUNC, FIELD) FUNC(cdr, len, offset)
+#define PS_FIELD_VAL_STRING(FUNC, FIELD, BOUND) ps_val_bstring(cdr, len, offset, BOUND)
+
+#define PS_FIELD_FIX(FUNC, ...) PS_BOUNDED(PS_FIELD_FIX_TYPE, PS_FIELD_FIX_STRING, __VA_ARGS__)(FUNC, __VA_ARGS__)
+#define PS_FIELD_FIX_TYPE(FUNC, FIELD) FUNC(op, p, off, (op == PS_FIX_END) ? NULL : &msg->FIELD)
+#define PS_FIELD_FIX_STRING(FUNC, FIELD, BOUND) off
+
+#define PS_SEQ_SER(FUNC, SEQ, ...) PS_BOUNDED(PS_SEQ_SER_POINTER, PS_SEQ_SER_INLINE, __VA_ARGS__)(FUNC, SEQ, __VA_ARGS__)
+#define PS_SEQ_SER_POINTER(FUNC, SEQ, FIELD) FUNC(writer, &msg->FIELD)
+#define PS_SEQ_SER_INLINE(FUNC, SEQ, FIELD, BOUND)                                              \
+    ({                                                                                          \
+        SEQ _seq = { msg->FIELD.data, msg->FIELD.n_elements };                                  \
+        if (_seq.n_elements > (BOUND)){ writer->error = true; }                                 \
+        !writer->error && FUNC(writer, &_seq);                                                  \
+    })
+
+#define PS_SEQ_DES(FUNC, SEQ, ...) PS_BOUNDED(PS_SEQ_DES_POINTER, PS_SEQ_DES_INLINE, __VA_ARGS__)(FUNC, SEQ, __VA_ARGS__)
+#define PS_SEQ_DES_POINTER(FUNC, SEQ, FIELD) FUNC(reader, &msg->FIELD)
+#define PS_SEQ_DES_INLINE(FUNC, SEQ, FIELD, BOUND)                                              \
+    ({                                                                                          \
+        SEQ _seq = { msg->FIELD.data, BOUND };                                                  \
+        bool _ok = FUNC(reader, &_seq);                                                         \
+        msg->FIELD.n_elements = _ok ? _seq.n_elements : 0;                                      \
+        _ok;                                                                                    \
+    })
+
+#define PS_SEQ_SIZE(FUNC, SEQ, ...) PS_BOUNDED(PS_SEQ_SIZE_POINTER, PS_SEQ_SIZE_INLINE, __VA_ARGS__)(FUNC, SEQ, __VA_ARGS__)
+#define PS_SEQ_SIZE_POINTER(FUNC, SEQ, FIELD) FUNC(offset, &msg->FIELD)
+#define PS_SEQ_SIZE_INLINE(FUNC, SEQ, FIELD, BOUND)                                             \
+    FUNC(offset, &(SEQ){ msg->FIELD.data, msg->FIELD.n_elements })
+
+#define PS_SEQ_VAL(FUNC, SEQ, ...) PS_BOUNDED(PS_SEQ_VAL_POINTER, PS_SEQ_VAL_INLINE, __VA_ARGS__)(FUNC, SEQ, __VA_ARGS__)
+#define PS_SEQ_VAL_POINTER(FUNC, SEQ, FIELD) FUNC(cdr, len, offset)
+#define PS_SEQ_VAL_INLINE(FUNC, SEQ, FIELD, BOUND)                                              \
+    ({                                                                                          \
+        uint32_t _n = 0;                                                                        \
+        (ps_val_count(cdr, len, offset, &_n) == PS_VAL_FAIL || _n > (BOUND))                    \
+            ? PS_VAL_FAIL : FUNC(cdr, len, offset);                                             \
+    })
+
+#define PS_SER_TYPE(TYPE, FIELD, ...)                                                           \
+    if( PS_FIELD_SER(ps_ser_##TYPE, FIELD, ##__VA_ARGS__) != true){ return false; }
 
 #define PS_SER_ARRAY(TYPE, FIELD, NUMBER)                                                       \
     if( ps_ser_array_##TYPE(writer, msg->FIELD, NUMBER) != true){ return false; }
 
-#define PS_SER_SEQUENCE(TYPE, FIELD)                                                            \
-    if( ps_ser_sequence_##TYPE(writer, &msg->FIELD) != true){ return false; }
+#define PS_SER_SEQUENCE(TYPE, FIELD, ...)                                                       \
+    if( PS_SEQ_SER(ps_ser_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__) != true){ return false; }
 
-#define PS_DES_TYPE(TYPE, FIELD)                                                                \
-    if( ps_des_##TYPE(reader, &msg->FIELD) != true){ return false; }
+#define PS_DES_TYPE(TYPE, FIELD, ...)                                                           \
+    if( PS_FIELD_DES(ps_des_##TYPE, FIELD, ##__VA_ARGS__) != true){ return false; }
 
 #define PS_DES_ARRAY(TYPE, FIELD, NUMBER)  \
     if( ps_des_array_##TYPE(reader, msg->FIELD, NUMBER) != true){ return false; }
     
-#define PS_DES_SEQUENCE(TYPE, FIELD)  \
-    if( ps_des_sequence_##TYPE(reader, &msg->FIELD) != true){ return false; }
+#define PS_DES_SEQUENCE(TYPE, FIELD, ...)  \
+    if( PS_SEQ_DES(ps_des_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__) != true){ return false; }
+
+// Fields of fixed layout prefix, the prefix ends at first string or sequence
+#define PS_FIX_TYPE(TYPE, FIELD, ...)                                                           \
+    prefix = prefix && !ps_unbounded_##TYPE;                                                    \
+    if (prefix){ off = PS_FIELD_FIX(ps_fix_##TYPE, FIELD, ##__VA_ARGS__); }
+
+#define PS_FIX_ARRAY(TYPE, FIELD, NUMBER)                                                       \
+    prefix = prefix && !ps_unbounded_##TYPE;                                                    \
+    if (prefix){ off = ps_fix_array_##TYPE(op, p, off, (op == PS_FIX_END) ? NULL : msg->FIELD, NUMBER); }
+
+#define PS_FIX_SEQUENCE(TYPE, FIELD, ...) prefix = false;
+
+// Tail fields, skipped if already handled by fixed layout prefix
+#define PS_SER_TAIL_TYPE(TYPE, FIELD, ...)                                                      \
+    prefix = prefix && !ps_unbounded_##TYPE;                                                    \
+    if (!(fixed && prefix) && PS_FIELD_SER(ps_ser_##TYPE, FIELD, ##__VA_ARGS__) != true){ return false; }
+
+#define PS_SER_TAIL_ARRAY(TYPE, FIELD, NUMBER)                                                  \
+    prefix = prefix && !ps_unbounded_##TYPE;                                                    \
+    if (!(fixed && prefix) && ps_ser_array_##TYPE(writer, msg->FIELD, NUMBER) != true){ return false; }
+
+#define PS_SER_TAIL_SEQUENCE(TYPE, FIELD, ...)                                                  \
+    prefix = false;                                                                             \
+    if (PS_SEQ_SER(ps_ser_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__) != true){ return false; }
+
+#define PS_DES_TAIL_TYPE(TYPE, FIELD, ...)                                                      \
+    prefix = prefix && !ps_unbounded_##TYPE;                                                    \
+    if (!(fixed && prefix) && PS_FIELD_DES(ps_des_##TYPE, FIELD, ##__VA_ARGS__) != true){ return false; }
+
+#define PS_DES_TAIL_ARRAY(TYPE, FIELD, NUMBER)                                                  \
+    prefix = prefix && !ps_unbounded_##TYPE;                                                    \
+    if (!(fixed && prefix) && ps_des_array_##TYPE(reader, msg->FIELD, NUMBER) != true){ return false; }
+
+#define PS_DES_TAIL_SEQUENCE(TYPE, FIELD, ...)                                                  \
+    prefix = false;                                                                             \
+    if (PS_SEQ_DES(ps_des_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__) != true){ return false; }
+
+#define PS_FIX_MSG_BIMPL(TYPE, NAME, HASH, TYPE2, ...)                                          \
+    static inline size_t ps_fix_##TYPE(int op, uint8_t* p, size_t off, TYPE* msg){             \
+        return ps_fix_##TYPE2(op, p, off, msg);                                                 \
+    }
+
+#define PS_FIX_MSG_CIMPL(TYPE, NAME, HASH, ...)                                                 \
+    static inline size_t ps_fix_##TYPE(int op, uint8_t* p, size_t off, TYPE* msg){             \
+        bool prefix = true; (void)prefix; (void)op; (void)p; (void)msg;                         \
+        __VA_ARGS__ return off;                                                                 \
+    }
+
+// Copy fixed layout prefix of msg at misalignment MIS from 8 bytes, one bounds check per block
+#define PS_FIX_BLOCK(OP, TYPE, UB, MIS)                                                         \
+    ({                                                                                          \
+        size_t _len = ps_fix_##TYPE(PS_FIX_END, NULL, MIS, NULL) - (MIS);                       \
+        bool _ok = _len > 0 && (size_t)((UB)->final - (UB)->iterator) >= _len;                  \
+        if (_ok){                                                                               \
+            ps_fix_##TYPE(OP, (UB)->iterator - (MIS), MIS, msg);                                \
+            (UB)->iterator += _len;                                                             \
+            (UB)->offset += _len;                                                               \
+            (UB)->last_data_size = 1;                                                           \
+        }                                                                                       \
+        _ok;                                                                                    \
+    })
+
+// Fixed layout prefix for buffers in host endianness, constant offsets when aligned to 8 bytes
+#define PS_FIX_RUN(OP, TYPE, UB)                                                                \
+    ({                                                                                          \
+        size_t _mis = ((UB)->offset - (UB)->origin) & 7u;                                       \
+        PS_FIXED_LAYOUT && (UB)->endianness == UCDR_MACHINE_ENDIANNESS && (_mis == 0            \
+            ? PS_FIX_BLOCK(OP, TYPE, UB, 0) : PS_FIX_BLOCK(OP, TYPE, UB, _mis));                \
+    })
+
+#define PS_VAL_TYPE(TYPE, FIELD, ...)                                                           \
+    offset = PS_FIELD_VAL(ps_val_##TYPE, FIELD, ##__VA_ARGS__);
+
+#define PS_VAL_ARRAY(TYPE, FIELD, NUMBER)                                                       \
+    offset = ps_val_array_##TYPE(cdr, len, offset, NUMBER);
+
+#define PS_VAL_SEQUENCE(TYPE, FIELD, ...)                                                       \
+    offset = PS_SEQ_VAL(ps_val_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__);
+
+// Field seek, matching field ends search, preceding fields are skipped
+#define PS_SEEK_TYPE(TYPE, FIELD, ...)                                                          \
+    if ((rest = ps_seek_match(path, #FIELD)) != NULL){                                          \
+        return (*rest == '\0') ? offset : ps_seek_##TYPE(cdr, len, offset, rest);               \
+    }                                                                                           \
+    offset = PS_FIELD_VAL(ps_val_##TYPE, FIELD, ##__VA_ARGS__);
+
+#define PS_SEEK_ARRAY(TYPE, FIELD, NUMBER)                                                      \
+    if ((rest = ps_seek_match(path, #FIELD)) != NULL){                                          \
+        return (*rest == '\0') ? offset : PS_VAL_FAIL;                                          \
+    }                                                                                           \
+    offset = ps_val_array_##TYPE(cdr, len, offset, NUMBER);
+
+#define PS_SEEK_SEQUENCE(TYPE, FIELD, ...)                                                      \
+    if ((rest = ps_seek_match(path, #FIELD)) != NULL){                                          \
+        return (*rest == '\0') ? offset : PS_VAL_FAIL;                                          \
+    }                                                                                           \
+    offset = PS_SEQ_VAL(ps_val_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__);
+
+#define PS_SIZE_TYPE(TYPE, FIELD, ...)                                                          \
+    offset = PS_FIELD_SIZE(ps_size_##TYPE, FIELD, ##__VA_ARGS__);
+
+#define PS_SIZE_ARRAY(TYPE, FIELD, NUMBER)                                                      \
+    offset = ps_size_array_##TYPE(offset, msg->FIELD, NUMBER);
+
+#define PS_SIZE_SEQUENCE(TYPE, FIELD, ...)                                                      \
+    offset = PS_SEQ_SIZE(ps_size_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__);
 
 #define PS_SER_MSG_BIMPL(TYPE, NAME, HASH, TYPE2 ...)                                           \
     bool ps_ser_##TYPE(ucdrBuffer* writer, TYPE* msg) { return ps_ser_##TYPE2(writer, msg); }   \
@@ -177,9 +1204,20 @@ void ucdr_seq_end(ucdr_writer_t* writer){
     }
     
     #define PS_SER_MSG_CIMPL(TYPE, NAME, HASH, ...)                                             \
-    bool ps_ser_##TYPE(ucdrBuffer* writer, TYPE* msg) { __VA_ARGS__ return true; }              \
+    bool ps_ser_##TYPE(ucdrBuffer* writer, TYPE* msg) {                                         \
+        if (PS_USE_PLAIN(TYPE, writer)){                                                        \
+            return ps_ser_plain(writer, msg, sizeof(TYPE), PS_PLAIN_ALIGN(ps_leaf_##TYPE));     \
+        }                                                                                       \
+        bool fixed = PS_FIX_RUN(PS_FIX_PUT, TYPE, writer);                                      \
+        bool prefix = true; (void)prefix; (void)fixed;                                          \
+        __VA_ARGS__ return true;                                                                \
+    }                                                                                           \
     bool ps_ser_sequence_##TYPE(ucdrBuffer* writer, TYPE##_sequence* msg) {                     \
         ucdr_serialize_uint32_t(writer, msg->n_elements);                                       \
+        if (PS_USE_PLAIN(TYPE, writer)){                                                        \
+            return ps_ser_plain(writer, msg->data, msg->n_elements * sizeof(TYPE),              \
+                                PS_PLAIN_ALIGN(ps_leaf_##TYPE));                                \
+        }                                                                                       \
         for (int i = 0; i < msg->n_elements; i++){if (ps_ser_##TYPE(writer, &msg->data[i]) == false) {return false;}} \
         return true;                                                                            \
     }
@@ -191,15 +1229,64 @@ void ucdr_seq_end(ucdr_writer_t* writer){
     }
 
 #define PS_DES_MSG_CIMPL(TYPE, NAME, HASH, ...)                                                 \
-    bool ps_des_##TYPE(ucdrBuffer* reader, TYPE* msg) { __VA_ARGS__ return true; }              \
+    bool ps_des_##TYPE(ucdrBuffer* reader, TYPE* msg) {                                         \
+        if (PS_IS_PLAIN(ps_leaf_##TYPE)){                                                       \
+            return ps_des_plain(reader, msg, sizeof(TYPE), PS_PLAIN_ALIGN(ps_leaf_##TYPE));     \
+        }                                                                                       \
+        bool fixed = PS_FIX_RUN(PS_FIX_GET, TYPE, reader);                                      \
+        bool prefix = true; (void)prefix; (void)fixed;                                          \
+        __VA_ARGS__ return true;                                                                \
+    }                                                                                           \
     bool ps_des_sequence_##TYPE(ucdrBuffer*reader, TYPE##_sequence* msg) {                      \
         uint32_t elements = 0;                                                                  \
         ucdr_deserialize_uint32_t(reader, &elements);                                           \
+        if (reader->on_full_buffer == NULL && elements > (size_t)(reader->final - reader->iterator)){ \
+            reader->error = true; /* every element takes at least one byte */                   \
+            return false;                                                                       \
+        }                                                                                       \
+        if (msg->data == NULL){                                                                 \
+            if (elements == 0){ /* no storage needed */                                         \
+                msg->n_elements = 0;                                                            \
+                return !reader->error;                                                          \
+            }                                                                                   \
+            if (PS_IS_PLAIN(ps_leaf_##TYPE) && ps_des_view(reader, (void**)&msg->data,          \
+                &msg->n_elements, elements, sizeof(TYPE), PS_PLAIN_ALIGN(ps_leaf_##TYPE))){     \
+                return true;                                                                    \
+            }                                                                                   \
+            msg->data = (TYPE*)ps_des_alloc(reader, elements, sizeof(TYPE), _Alignof(TYPE));    \
+            if (msg->data == NULL){return false;}                                               \
+            msg->n_elements = elements;                                                         \
+        }                                                                                       \
         if (elements > msg->n_elements){return false;}                                          \
+        msg->n_elements = elements;                                                             \
+        if (PS_IS_PLAIN(ps_leaf_##TYPE)){                                                       \
+            return ps_des_plain(reader, msg->data, elements * sizeof(TYPE),                     \
+                                PS_PLAIN_ALIGN(ps_leaf_##TYPE));                                \
+        }                                                                                       \
         for (int i = 0; i < elements; i++){if (ps_des_##TYPE(reader, &msg->data[i]) == false){return false;}} \
         return true;                                                                            \
     }
 
+#define PS_SIZE_MSG_BIMPL(TYPE, NAME, HASH, TYPE2 ...)                                          \
+    size_t ps_size_##TYPE(size_t offset, TYPE* msg) { return ps_size_##TYPE2(offset, msg); }    \
+    size_t ps_size_sequence_##TYPE(size_t offset, TYPE##_sequence* msg) {                       \
+        return ps_size_sequence_##TYPE2(offset, (TYPE2##_sequence*)msg);                        \
+    }
+
+#define PS_SIZE_MSG_CIMPL(TYPE, NAME, HASH, ...)                                                \
+    size_t ps_size_##TYPE(size_t offset, TYPE* msg) {                                           \
+        __VA_ARGS__ return offset;                                                              \
+    }                                                                                           \
+    size_t ps_size_sequence_##TYPE(size_t offset, TYPE##_sequence* msg) {                       \
+        offset = ps_size_leaf(offset, sizeof(uint32_t), NULL);                                  \
+        if (PS_IS_PLAIN(ps_leaf_##TYPE)){                                                       \
+            return (msg->n_elements > 0) ? offset + ucdr_alignment(offset,                      \
+                PS_PLAIN_ALIGN(ps_leaf_##TYPE)) + msg->n_elements * sizeof(TYPE) : offset;      \
+        }                                                                                       \
+        for (int i = 0; i < msg->n_elements; i++){offset = ps_size_##TYPE(offset, &msg->data[i]);} \
+        return offset;                                                                          \
+    }
+
 #define PS_SER_SRV(TYPE, NAME, HASH, REQ, REP)                                                  \
     bool ps_ser_##TYPE##_request(ucdrBuffer* writer, request_##TYPE* msg) { REQ return true; }  \
     bool ps_ser_##TYPE##_reply(ucdrBuffer* writer, reply_##TYPE* msg) { REP return true; }
@@ -208,7 +1295,227 @@ void ucdr_seq_end(ucdr_writer_t* writer){
     bool ps_des_##TYPE##_request(ucdrBuffer* reader, request_##TYPE* msg){ REQ return true; }   \
     bool ps_des_##TYPE##_reply(ucdrBuffer* reader, reply_##TYPE* msg) { REP return true; }
 
-MSG_LIST(PS_SER_MSG_BIMPL, PS_SER_MSG_CIMPL, PS_SER_MSG_BIMPL, PS_SER_TYPE, PS_SER_ARRAY, PS_SER_SEQUENCE)
-MSG_LIST(PS_DES_MSG_BIMPL, PS_DES_MSG_CIMPL, PS_DES_MSG_BIMPL, PS_DES_TYPE, PS_DES_ARRAY, PS_DES_SEQUENCE)
+#define PS_VAL_MSG_BIMPL(TYPE, NAME, HASH, TYPE2 ...)                                           \
+    size_t ps_val_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {                       \
+        return ps_val_##TYPE2(cdr, len, offset);                                                \
+    }                                                                                           \
+    size_t ps_val_sequence_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {              \
+        return ps_val_sequence_##TYPE2(cdr, len, offset);                                       \
+    }
+
+// Failed offset stays PS_VAL_FAIL through remaining fields
+#define PS_VAL_MSG_CIMPL(TYPE, NAME, HASH, ...)                                                 \
+    size_t ps_val_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {                       \
+        __VA_ARGS__ return offset;                                                              \
+    }                                                                                           \
+    size_t ps_val_sequence_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {              \
+        uint32_t n = 0;                                                                         \
+        offset = ps_val_count(cdr, len, offset, &n);                                            \
+        if (PS_IS_PLAIN(ps_leaf_##TYPE)){                                                       \
+            return ps_val_block(len, offset, PS_PLAIN_ALIGN(ps_leaf_##TYPE), sizeof(TYPE), n);  \
+        }                                                                                       \
+        for (uint32_t i = 0; i < n && offset != PS_VAL_FAIL; i++){                              \
+            offset = ps_val_##TYPE(cdr, len, offset);                                           \
+        }                                                                                       \
+        return offset;                                                                          \
+    }
+
+#define PS_VAL_SRV(TYPE, NAME, HASH, REQ, REP)                                                  \
+    size_t ps_val_##TYPE##_request(const uint8_t* cdr, size_t len, size_t offset) {             \
+        REQ return offset;                                                                      \
+    }                                                                                           \
+    size_t ps_val_##TYPE##_reply(const uint8_t* cdr, size_t len, size_t offset) {               \
+        REP return offset;                                                                      \
+    }
+
+#define PS_SIZE_SRV(TYPE, NAME, HASH, REQ, REP)                                                 \
+    size_t ps_size_##TYPE##_request(size_t offset, request_##TYPE* msg) { REQ return offset; }  \
+    size_t ps_size_##TYPE##_reply(size_t offset, reply_##TYPE* msg) { REP return offset; }
+
+// View init caches CDR offset of every field while skipping it
+#define PS_VIEW_TYPE(TYPE, FIELD, ...)                                                          \
+    view->at.FIELD = (uint32_t)offset;                                                          \
+    offset = PS_FIELD_VAL(ps_val_##TYPE, FIELD, ##__VA_ARGS__);
+
+#define PS_VIEW_ARRAY(TYPE, FIELD, NUMBER)                                                      \
+    view->at.FIELD = (uint32_t)offset;                                                          \
+    offset = ps_val_array_##TYPE(cdr, len, offset, NUMBER);
+
+#define PS_VIEW_SEQUENCE(TYPE, FIELD, ...)                                                      \
+    view->at.FIELD = (uint32_t)offset;                                                          \
+    offset = PS_SEQ_VAL(ps_val_sequence_##TYPE, TYPE##_sequence, FIELD, ##__VA_ARGS__);
+
+#define PS_VIEW_MSG_CIMPL(TYPE, NAME, HASH, ...)                                                \
+    size_t ps_view_init_##TYPE(TYPE##_view* view, uint8_t* buf, size_t len, size_t offset) {    \
+        if (len < sizeof(uint32_t)){ return PS_VAL_FAIL; }                                      \
+        const uint8_t* cdr = buf + sizeof(uint32_t);                                            \
+        view->buf = buf;                                                                        \
+        view->len = len;                                                                        \
+        len -= sizeof(uint32_t);                                                                \
+        __VA_ARGS__                                                                             \
+        view->end = offset;                                                                     \
+        return offset;                                                                          \
+    }
+
+#define PS_VIEW_TBL_CIMPL(TYPE, NAME, HASH, ...)                                                \
+    size_t ps_view_init_##TYPE(TYPE##_view* view, uint8_t* buf, size_t len, size_t offset) {    \
+        if (len < sizeof(uint32_t)){ return PS_VAL_FAIL; }                                      \
+        view->buf = buf;                                                                        \
+        view->len = len;                                                                        \
+        view->end = ps_tbl_view(buf + sizeof(uint32_t), len - sizeof(uint32_t), offset,         \
+                                ps_desc_##TYPE(), (uint32_t*)&view->at);                        \
+        return view->end;                                                                       \
+    }
+
+// Sequence iterator decodes element at its offset and skips it
+#define PS_ITER_IMPL(TYPE, ...)                                                                 \
+    bool ps_iter_next_##TYPE(TYPE##_iter* iter, TYPE* out) {                                    \
+        if (iter->i >= iter->n){ return false; }                                                \
+        size_t end = ps_val_##TYPE(iter->buf + sizeof(uint32_t), iter->len - sizeof(uint32_t), iter->offset); \
+        if (end == PS_VAL_FAIL){ return false; }                                                \
+        ucdrBuffer reader = {0};                                                                \
+        ucdr_init_buffer_origin_offset_endian(&reader, iter->buf + sizeof(uint32_t),            \
+                iter->len - sizeof(uint32_t), 0, iter->offset, PS_CDR_ENDIANNESS(iter->buf));   \
+        if (ps_des_##TYPE(&reader, out) == false){ return false; }                              \
+        iter->offset = end;                                                                     \
+        iter->i++;                                                                              \
+        return true;                                                                            \
+    }
+
+#define PS_SEEK_MSG_BIMPL(TYPE, NAME, HASH, TYPE2, ...)                                         \
+    size_t ps_seek_##TYPE(const uint8_t* cdr, size_t len, size_t offset, const char* path) {    \
+        return ps_seek_##TYPE2(cdr, len, offset, path);                                         \
+    }
+
+#define PS_SEEK_MSG_CIMPL(TYPE, NAME, HASH, ...)                                                \
+    size_t ps_seek_##TYPE(const uint8_t* cdr, size_t len, size_t offset, const char* path) {    \
+        const char* rest = NULL;                                                                \
+        __VA_ARGS__ return PS_VAL_FAIL;                                                         \
+    }
+
+// Plain types must have C layout identical to CDR layout
+#define PS_PLAIN_ASSERT(TYPE, ...)                                                              \
+    _Static_assert(!PS_IS_PLAIN(ps_leaf_##TYPE) || sizeof(TYPE) == ps_plain_size_##TYPE,        \
+                   #TYPE " is plain but its C layout differs from CDR layout");
+
+// Type descriptors, fields offsets are taken from owner type typedef in getter scope
+#define PS_DESC_FIELD(TYPE, ...) PS_BOUNDED(PS_DESC_TYPE, PS_DESC_STRING, __VA_ARGS__)(ps_desc_##TYPE, __VA_ARGS__)
+#define PS_DESC_TYPE(DESC, NAME) { #NAME, DESC, offsetof(ps_owner_t, NAME), PS_KIND_FIELD, 1 },
+#define PS_DESC_STRING(DESC, NAME, BOUND) { #NAME, DESC, offsetof(ps_owner_t, NAME), PS_KIND_BOUNDED_STRING, BOUND },
+#define PS_DESC_ARRAY(TYPE, NAME, SIZE) { #NAME, ps_desc_##TYPE, offsetof(ps_owner_t, NAME), PS_KIND_ARRAY, SIZE },
+#define PS_DESC_SEQUENCE(TYPE, ...) PS_BOUNDED(PS_DESC_POINTER, PS_DESC_INLINE, __VA_ARGS__)(ps_desc_##TYPE, __VA_ARGS__)
+#define PS_DESC_POINTER(DESC, NAME) { #NAME, DESC, offsetof(ps_owner_t, NAME), PS_KIND_SEQUENCE, 0 },
+#define PS_DESC_INLINE(DESC, NAME, BOUND) { #NAME, DESC, offsetof(ps_owner_t, NAME), PS_KIND_BOUNDED_SEQUENCE, BOUND },
+
+#define PS_DESC_DEFINE(FUNC, TYPE, LEAF, ...)                                                   \
+    const ps_type_desc_t* FUNC(void) {                                                          \
+        typedef TYPE ps_owner_t; (void)sizeof(ps_owner_t);                                      \
+        static const ps_field_desc_t fields[] = { __VA_ARGS__ };                                \
+        static const ps_type_desc_t desc = { #TYPE, fields, sizeof(TYPE), _Alignof(TYPE),       \
+            sizeof(fields) / sizeof(fields[0]), PS_BASE_NONE, LEAF };                           \
+        return &desc;                                                                           \
+    }
+
+#define PS_DESC_BASE(TYPE)                                                                      \
+    const ps_type_desc_t* ps_desc_##TYPE(void) {                                                \
+        static const ps_type_desc_t desc = { #TYPE, NULL, sizeof(TYPE), _Alignof(TYPE), 0,      \
+            PS_BASE_##TYPE, ps_leaf_##TYPE };                                                   \
+        return &desc;                                                                           \
+    }
+
+#define PS_DESC_BTYPE(TYPE, NAME, HASH, TYPE2, ...)                                             \
+    const ps_type_desc_t* ps_desc_##TYPE(void) { return ps_desc_##TYPE2(); }
+
+#define PS_DESC_CTYPE(TYPE, NAME, HASH, ...) PS_DESC_DEFINE(ps_desc_##TYPE, TYPE, ps_leaf_##TYPE, __VA_ARGS__)
+
+#define PS_DESC_SRV(TYPE, NAME, HASH, REQ, REP)                                                 \
+    PS_DESC_DEFINE(ps_desc_##TYPE##_request, request_##TYPE, PS_LEAF_NOT_PLAIN, REQ)            \
+    PS_DESC_DEFINE(ps_desc_##TYPE##_reply, reply_##TYPE, PS_LEAF_NOT_PLAIN, REP)
+
+// Table driven implementation, thin wrappers of interpreter over type descriptors
+#define PS_TBL_MSG_CIMPL(TYPE, NAME, HASH, ...)                                                 \
+    bool ps_ser_##TYPE(ucdrBuffer* writer, TYPE* msg) {                                         \
+        return ps_tbl_ser(writer, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_FIELD, 1);           \
+    }                                                                                           \
+    bool ps_ser_sequence_##TYPE(ucdrBuffer* writer, TYPE##_sequence* msg) {                     \
+        return ps_tbl_ser(writer, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_SEQUENCE, 0);        \
+    }                                                                                           \
+    bool ps_des_##TYPE(ucdrBuffer* reader, TYPE* msg) {                                         \
+        return ps_tbl_des(reader, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_FIELD, 1);           \
+    }                                                                                           \
+    bool ps_des_sequence_##TYPE(ucdrBuffer* reader, TYPE##_sequence* msg) {                     \
+        return ps_tbl_des(reader, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_SEQUENCE, 0);        \
+    }                                                                                           \
+    size_t ps_size_##TYPE(size_t offset, TYPE* msg) {                                           \
+        return ps_tbl_size(offset, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_FIELD, 1);          \
+    }                                                                                           \
+    size_t ps_size_sequence_##TYPE(size_t offset, TYPE##_sequence* msg) {                       \
+        return ps_tbl_size(offset, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_SEQUENCE, 0);       \
+    }                                                                                           \
+    size_t ps_val_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {                       \
+        return ps_tbl_val(cdr, len, offset, ps_desc_##TYPE(), PS_KIND_FIELD, 1);                \
+    }                                                                                           \
+    size_t ps_val_sequence_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {              \
+        return ps_tbl_val(cdr, len, offset, ps_desc_##TYPE(), PS_KIND_SEQUENCE, 0);             \
+    }                                                                                           \
+    size_t ps_seek_##TYPE(const uint8_t* cdr, size_t len, size_t offset, const char* path) {    \
+        return ps_tbl_seek(cdr, len, offset, ps_desc_##TYPE(), path);                           \
+    }
+
+#define PS_TBL_SRV_IMPL(TYPE, DESC)                                                             \
+    bool ps_ser_##TYPE(ucdrBuffer* writer, DESC* msg) {                                         \
+        return ps_tbl_ser(writer, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_FIELD, 1);           \
+    }                                                                                           \
+    bool ps_des_##TYPE(ucdrBuffer* reader, DESC* msg) {                                         \
+        return ps_tbl_des(reader, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_FIELD, 1);           \
+    }                                                                                           \
+    size_t ps_size_##TYPE(size_t offset, DESC* msg) {                                           \
+        return ps_tbl_size(offset, ps_desc_##TYPE(), (uint8_t*)msg, PS_KIND_FIELD, 1);          \
+    }                                                                                           \
+    size_t ps_val_##TYPE(const uint8_t* cdr, size_t len, size_t offset) {                       \
+        return ps_tbl_val(cdr, len, offset, ps_desc_##TYPE(), PS_KIND_FIELD, 1);                \
+    }
+
+#define PS_TBL_SRV(TYPE, NAME, HASH, REQ, REP)                                                  \
+    PS_TBL_SRV_IMPL(TYPE##_request, request_##TYPE)                                             \
+    PS_TBL_SRV_IMPL(TYPE##_reply, reply_##TYPE)
+
+MSG_LIST(PS_UNUSED, PS_PLAIN_ASSERT, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+#ifdef PS_TABLE_DRIVEN
+MSG_LIST(PS_SER_MSG_BIMPL, PS_TBL_MSG_CIMPL, PS_SER_MSG_BIMPL, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+MSG_LIST(PS_DES_MSG_BIMPL, PS_UNUSED, PS_DES_MSG_BIMPL, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+MSG_LIST(PS_SIZE_MSG_BIMPL, PS_UNUSED, PS_SIZE_MSG_BIMPL, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+MSG_LIST(PS_VAL_MSG_BIMPL, PS_UNUSED, PS_VAL_MSG_BIMPL, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+MSG_LIST(PS_SEEK_MSG_BIMPL, PS_UNUSED, PS_SEEK_MSG_BIMPL, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+MSG_LIST(PS_UNUSED, PS_VIEW_TBL_CIMPL, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+SRV_LIST(PS_TBL_SRV, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+#else
+MSG_LIST(PS_FIX_MSG_BIMPL, PS_FIX_MSG_CIMPL, PS_FIX_MSG_BIMPL, PS_FIX_TYPE, PS_FIX_ARRAY, PS_FIX_SEQUENCE)
+MSG_LIST(PS_SER_MSG_BIMPL, PS_SER_MSG_CIMPL, PS_SER_MSG_BIMPL, PS_SER_TAIL_TYPE, PS_SER_TAIL_ARRAY, PS_SER_TAIL_SEQUENCE)
+MSG_LIST(PS_DES_MSG_BIMPL, PS_DES_MSG_CIMPL, PS_DES_MSG_BIMPL, PS_DES_TAIL_TYPE, PS_DES_TAIL_ARRAY, PS_DES_TAIL_SEQUENCE)
 SRV_LIST(PS_SER_SRV, EXP_TOKEN, EXP_TOKEN, PS_SER_TYPE, PS_SER_ARRAY, PS_SER_SEQUENCE)
 SRV_LIST(PS_DES_SRV, EXP_TOKEN, EXP_TOKEN, PS_DES_TYPE, PS_DES_ARRAY, PS_DES_SEQUENCE)
+MSG_LIST(PS_SIZE_MSG_BIMPL, PS_SIZE_MSG_CIMPL, PS_SIZE_MSG_BIMPL, PS_SIZE_TYPE, PS_SIZE_ARRAY, PS_SIZE_SEQUENCE)
+SRV_LIST(PS_SIZE_SRV, EXP_TOKEN, EXP_TOKEN, PS_SIZE_TYPE, PS_SIZE_ARRAY, PS_SIZE_SEQUENCE)
+MSG_LIST(PS_VAL_MSG_BIMPL, PS_VAL_MSG_CIMPL, PS_VAL_MSG_BIMPL, PS_VAL_TYPE, PS_VAL_ARRAY, PS_VAL_SEQUENCE)
+SRV_LIST(PS_VAL_SRV, EXP_TOKEN, EXP_TOKEN, PS_VAL_TYPE, PS_VAL_ARRAY, PS_VAL_SEQUENCE)
+MSG_LIST(PS_SEEK_MSG_BIMPL, PS_SEEK_MSG_CIMPL, PS_SEEK_MSG_BIMPL, PS_SEEK_TYPE, PS_SEEK_ARRAY, PS_SEEK_SEQUENCE)
+MSG_LIST(PS_UNUSED, PS_VIEW_MSG_CIMPL, PS_UNUSED, PS_VIEW_TYPE, PS_VIEW_ARRAY, PS_VIEW_SEQUENCE)
+#endif
+MSG_LIST(PS_ITER_IMPL, PS_ITER_IMPL, PS_ITER_IMPL, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+BASE_TYPES_LIST(PS_ITER_IMPL)
+
+#ifdef PS_REFLECTION
+BASE_TYPES_LIST(PS_DESC_BASE)
+MSG_LIST(PS_DESC_BTYPE, PS_DESC_CTYPE, PS_DESC_BTYPE, PS_DESC_FIELD, PS_DESC_ARRAY, PS_DESC_SEQUENCE)
+SRV_LIST(PS_DESC_SRV, EXP_TOKEN, EXP_TOKEN, PS_DESC_FIELD, PS_DESC_ARRAY, PS_DESC_SEQUENCE)
+
+const ps_field_desc_t* ps_desc_field(const ps_type_desc_t* desc, const char* name){
+    for (uint16_t i = 0; i < desc->n_fields; i++){
+        if (strcmp(desc->fields[i].name, name) == 0){
+            return &desc->fields[i];
+        }
+    }
+    return NULL;
+}
+#endif
@@ -0,0 +1,144 @@
+/**
+ ******************************************************************************
+ * @file    bench_picoserdes.c
+ * @brief   Serialization/deserialization timing of picoserdes
+ * @details Prints ns/message of ps_serialize and ps_deserialize for a set of
+ *          example types. Build with PS_FIXED_LAYOUT=0 for per field baseline or with
+ *          PS_TABLE_DRIVEN for descriptor table interpreter. Build with PS_PARALLEL to copy
+ *          large point cloud by thread pool.
+ ******************************************************************************
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../src/picoserdes.h"
+
+#ifndef PS_FIXED_LAYOUT
+#define PS_FIXED_LAYOUT 1
+#endif
+
+#if defined(PS_TABLE_DRIVEN)
+#define BENCH_MODE "table driven"
+#elif PS_FIXED_LAYOUT
+#define BENCH_MODE "fixed layout"
+#else
+#define BENCH_MODE "per field"
+#endif
+
+// Buffer size and number of iterations of each measurement
+#define BENCH_BUFFER_SIZE 1024
+#define BENCH_ITERATIONS  2000000
+
+// Number of points and iterations of large point cloud measurement, pool threads with PS_PARALLEL
+#define BENCH_CLOUD_POINTS      (1u << 20)
+#define BENCH_CLOUD_ITERATIONS  50
+#ifndef BENCH_THREADS
+#define BENCH_THREADS 7
+#endif
+
+// Keep results alive so loops are not optimized away
+volatile size_t bench_sink;
+
+static double bench_now_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#define BENCH_TYPE(type, pMSG) \
+    do { \
+        uint8_t buffer[BENCH_BUFFER_SIZE] __attribute__((aligned(8))) = {}; \
+        type copy = *(pMSG); \
+        size_t len = 0; \
+        double start = bench_now_ns(); \
+        for (int i = 0; i < BENCH_ITERATIONS; i++){ \
+            len += ps_serialize(buffer, (pMSG), BENCH_BUFFER_SIZE); \
+        } \
+        double ser_ns = (bench_now_ns() - start) / BENCH_ITERATIONS; \
+        start = bench_now_ns(); \
+        for (int i = 0; i < BENCH_ITERATIONS; i++){ \
+            len += ps_deserialize(buffer, &copy, BENCH_BUFFER_SIZE); \
+        } \
+        double des_ns = (bench_now_ns() - start) / BENCH_ITERATIONS; \
+        bench_sink = len; \
+        printf("    %-24s ser %7.1f ns  des %7.1f ns\n", #type, ser_ns, des_ns); \
+    } while (0)
+
+// Large point cloud, deserialized into preallocated points so both directions copy whole block
+static void bench_cloud(void){
+    size_t size = 64 + BENCH_CLOUD_POINTS * sizeof(ros_Point32);
+    uint8_t* buffer = malloc(size);
+    ros_Point32* points = calloc(BENCH_CLOUD_POINTS, sizeof(ros_Point32));
+    ros_Point32* copy_points = malloc(BENCH_CLOUD_POINTS * sizeof(ros_Point32));
+    ros_PointCloud cloud = {
+        .header.frame_id = "cloud",
+        .points = {.data = points, .n_elements = BENCH_CLOUD_POINTS},
+    };
+    ros_ChannelFloat32 no_channels[1];
+    ros_PointCloud copy = {
+        .points = {.data = copy_points, .n_elements = BENCH_CLOUD_POINTS},
+        .channels = {.data = no_channels, .n_elements = 0},
+    };
+    size_t len = 0;
+    double start = bench_now_ns();
+    for (int i = 0; i < BENCH_CLOUD_ITERATIONS; i++){
+        len += ps_serialize(buffer, &cloud, size);
+    }
+    double ser_us = (bench_now_ns() - start) / BENCH_CLOUD_ITERATIONS / 1e3;
+    start = bench_now_ns();
+    for (int i = 0; i < BENCH_CLOUD_ITERATIONS; i++){
+        copy.points.n_elements = BENCH_CLOUD_POINTS;
+        len += ps_deserialize(buffer, &copy, size);
+    }
+    double des_us = (bench_now_ns() - start) / BENCH_CLOUD_ITERATIONS / 1e3;
+    bench_sink = len;
+    printf("    %-24s ser %7.1f us  des %7.1f us\n", "ros_PointCloud 12 MB", ser_us, des_us);
+    free(buffer);
+    free(points);
+    free(copy_points);
+}
+
+int main() {
+    printf("PICOSERDES BENCHMARK (%s)\n", BENCH_MODE);
+
+    ros_RegionOfInterest roi = {
+        .x_offset = 1, .y_offset = 2, .height = 480, .width = 640, .do_rectify = true,
+    };
+    ros_MapMetaData map = {
+        .map_load_time = {.sec = 100, .nanosec = 200},
+        .resolution = 0.05f, .width = 400, .height = 300,
+        .origin.orientation.w = 1.0,
+    };
+    ros_Imu imu = {
+        .header.frame_id = "imu",
+        .orientation.w = 1.0,
+        .angular_velocity.z = 0.1,
+        .linear_acceleration.z = 9.81,
+    };
+    ros_Odometry odo = {
+        .header.frame_id = "odom",
+        .child_frame_id = "base_link",
+        .pose.pose.orientation.w = 1.0,
+        .twist.twist.linear.x = 0.5,
+    };
+
+    BENCH_TYPE(ros_RegionOfInterest, &roi);
+    BENCH_TYPE(ros_MapMetaData, &map);
+    BENCH_TYPE(ros_Imu, &imu);
+    BENCH_TYPE(ros_Odometry, &odo);
+
+#ifdef PS_PARALLEL
+    if (!ps_parallel_init(BENCH_THREADS, 0)){
+        printf("    thread pool not started\n");
+    }
+    printf("    %d pool threads\n", BENCH_THREADS);
+#endif
+    bench_cloud();
+#ifdef PS_PARALLEL
+    ps_parallel_deinit();
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file    bench_picoserdes_hpp.cpp
+ * @brief   Timing of C++ picoserdes front end against C picoserdes
+ * @details Prints ns/message of C ps_serialize/ps_deserialize and C++
+ *          picoserdes::serialize/deserialize for a set of example types
+ *          and checks that both produce identical bytes.
+ ******************************************************************************
+ */
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include "../src/picoserdes.hpp"
+
+// Buffer size and number of iterations of each measurement
+#define BENCH_BUFFER_SIZE 1024
+#define BENCH_ITERATIONS  2000000
+
+// Keep results alive so loops are not optimized away
+volatile size_t bench_sink;
+
+static double bench_now_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+template<class F>
+static double bench_ns(F&& f){
+    size_t len = 0;
+    double start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++){
+        len += f();
+        __asm__ __volatile__("" ::: "memory"); // inputs and outputs are not loop invariant
+    }
+    bench_sink = len;
+    return (bench_now_ns() - start) / BENCH_ITERATIONS;
+}
+
+template<class T>
+static bool bench_type(const char* name, T& msg){
+    uint8_t c_buffer[BENCH_BUFFER_SIZE] __attribute__((aligned(8))) = {};
+    uint8_t cpp_buffer[BENCH_BUFFER_SIZE] __attribute__((aligned(8))) = {};
+    T copy = msg;
+
+    double c_ser = bench_ns([&]{ return ps_serialize(c_buffer, &msg, BENCH_BUFFER_SIZE); });
+    double cpp_ser = bench_ns([&]{ return picoserdes::serialize(cpp_buffer, msg, BENCH_BUFFER_SIZE); });
+    double c_des = bench_ns([&]{ return (size_t)ps_deserialize(c_buffer, &copy, BENCH_BUFFER_SIZE); });
+    double cpp_des = bench_ns([&]{ return (size_t)picoserdes::deserialize(cpp_buffer, copy, BENCH_BUFFER_SIZE); });
+
+    size_t len = ps_serialize(c_buffer, &msg, BENCH_BUFFER_SIZE);
+    bool same = len == picoserdes::serialize(cpp_buffer, msg, BENCH_BUFFER_SIZE)
+        && memcmp(c_buffer, cpp_buffer, len) == 0;
+    printf("    %-24s ser C %7.1f ns  C++ %7.1f ns  des C %7.1f ns  C++ %7.1f ns  %s\n",
+           name, c_ser, cpp_ser, c_des, cpp_des, same ? "identical" : "MISMATCH");
+    return same;
+}
+
+int main() {
+    printf("PICOSERDES C/C++ BENCHMARK\n");
+
+    ros_RegionOfInterest roi = {};
+    roi.x_offset = 1; roi.y_offset = 2; roi.height = 480; roi.width = 640; roi.do_rectify = true;
+    ros_MapMetaData map = {};
+    map.map_load_time.sec = 100; map.map_load_time.nanosec = 200;
+    map.resolution = 0.05f; map.width = 400; map.height = 300;
+    map.origin.orientation.w = 1.0;
+    ros_Imu imu = {};
+    imu.header.frame_id = (rstring)"imu";
+    imu.orientation.w = 1.0;
+    imu.angular_velocity.z = 0.1;
+    imu.linear_acceleration.z = 9.81;
+    ros_Odometry odo = {};
+    odo.header.frame_id = (rstring)"odom";
+    odo.child_frame_id = (rstring)"base_link";
+    odo.pose.pose.orientation.w = 1.0;
+    odo.twist.twist.linear.x = 0.5;
+
+    bool same = bench_type("ros_RegionOfInterest", roi);
+    same = bench_type("ros_MapMetaData", map) && same;
+    same = bench_type("ros_Imu", imu) && same;
+    same = bench_type("ros_Odometry", odo) && same;
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,216 @@
+/**
+ ******************************************************************************
+ * @file    test_picocloud.c
+ * @brief   Unit tests for picocloud PointCloud2 packing helpers
+ * @details Packed data must match scalar reference interleave serialized by
+ *          ps_serialize() byte for byte, unpacking must restore channels.
+ ******************************************************************************
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../src/picocloud.h"
+
+#undef NDEBUG
+
+// Number of points of tests, not multiple of vector widths so scalar tails run too
+#define TEST_POINTS 1037
+#define TEST_MAX_FIELDS 8
+#define TEST_MAX_STEP 64
+#define TEST_BUFFER_SIZE (256 + TEST_POINTS * TEST_MAX_STEP)
+
+// Formatting constants
+#define TEST_INDENT "    "
+#define GREEN_TEXT "\033[0;32m"
+#define RED_TEXT   "\033[0;31m"
+#define RESET_TEXT "\033[0m"
+#define BOLD_TEXT  "\033[1m"
+
+// Helper functions for formatting
+void print_header(const char* title) {
+    printf("%s", BOLD_TEXT);
+    printf("  %s\n", title);
+    printf("%s", RESET_TEXT);
+}
+
+void print_test_result(const char* type_name, bool passed) {
+    printf("%s%s[%s] Test %s: %s%s\n",
+           TEST_INDENT,
+           passed ? GREEN_TEXT : RED_TEXT,
+           passed ? "✓" : "✗",
+           type_name,
+           passed ? "PASSED" : "FAILED",
+           RESET_TEXT);
+}
+
+/* ----- test clouds ---------------------------------------------------------*/
+
+// Point layouts, offset UINT32_MAX assigns consecutive offsets with pc_fields_init()
+typedef struct {
+    const char*     name;
+    uint32_t        n_fields;
+    uint32_t        point_step;
+    ros_PointField  fields[TEST_MAX_FIELDS];
+} test_layout_t;
+
+static const test_layout_t layouts[] = {
+    {"xyzi float32", 4, 0, {
+        {"x", UINT32_MAX, PC_FLOAT32, 1}, {"y", UINT32_MAX, PC_FLOAT32, 1},
+        {"z", UINT32_MAX, PC_FLOAT32, 1}, {"intensity", UINT32_MAX, PC_FLOAT32, 1}}},
+    {"xyz padded", 3, 16, {
+        {"z", 8, PC_FLOAT32, 1}, {"x", 0, PC_FLOAT32, 1}, {"y", 4, PC_FLOAT32, 1}}},
+    {"pcl xyzi ring time", 6, 32, {
+        {"x", 0, PC_FLOAT32, 1}, {"y", 4, PC_FLOAT32, 1}, {"z", 8, PC_FLOAT32, 1},
+        {"intensity", 16, PC_FLOAT32, 1}, {"ring", 20, PC_UINT16, 1}, {"time", 24, PC_FLOAT64, 1}}},
+    {"mixed counts", 5, 0, {
+        {"rgb", UINT32_MAX, PC_UINT8, 3}, {"x", UINT32_MAX, PC_INT32, 1}, {"y", UINT32_MAX, PC_UINT32, 1},
+        {"normal", UINT32_MAX, PC_FLOAT32, 3}, {"label", UINT32_MAX, PC_INT8, 1}}},
+};
+
+static uint8_t channel_data[TEST_MAX_FIELDS][TEST_POINTS * 16];
+static uint8_t unpacked[TEST_MAX_FIELDS][TEST_POINTS * 16];
+static uint8_t reference[TEST_POINTS * TEST_MAX_STEP];
+static uint8_t expected[TEST_BUFFER_SIZE];
+static uint8_t buffer[TEST_BUFFER_SIZE];
+
+// Cloud of layout with fields, channels of generated data and scalar reference interleave
+static void test_cloud(const test_layout_t* layout, ros_PointField* fields, ros_PointCloud2* cloud,
+                       pc_channel_t* channels){
+    memcpy(fields, layout->fields, sizeof(layout->fields));
+    uint32_t step = (layout->point_step > 0) ? layout->point_step : pc_fields_init(fields, layout->n_fields);
+    *cloud = (ros_PointCloud2){
+        .header = {.stamp = {.sec = 12, .nanosec = 34}, .frame_id = "lidar"},
+        .height = 1, .width = TEST_POINTS,
+        .fields = {.data = fields, .n_elements = layout->n_fields},
+        .point_step = step,
+        .is_dense = true,
+    };
+    memset(reference, 0, sizeof(reference));
+    for (uint32_t f = 0; f < layout->n_fields; f++){
+        uint32_t size = pc_datatype_size(fields[f].datatype) * fields[f].count;
+        for (uint32_t i = 0; i < TEST_POINTS * size; i++){
+            channel_data[f][i] = (uint8_t)(i * 31 + f * 7 + 1);
+        }
+        for (uint32_t p = 0; p < TEST_POINTS; p++){
+            memcpy(&reference[p * step + fields[f].offset], &channel_data[f][p * size], size);
+        }
+        channels[f] = (pc_channel_t){.name = fields[f].name, .data = channel_data[f]};
+    }
+}
+
+// Unpacked channels must equal packed ones, with swapped elements when cloud is foreign
+static bool test_unpacked(const ros_PointCloud2* cloud, bool swapped){
+    for (uint32_t f = 0; f < cloud->fields.n_elements; f++){
+        uint32_t elem = pc_datatype_size(cloud->fields.data[f].datatype);
+        uint32_t n = TEST_POINTS * cloud->fields.data[f].count;
+        for (uint32_t e = 0; e < n; e++){
+            for (uint32_t b = 0; b < elem; b++){
+                uint32_t src = e * elem + (swapped ? elem - 1 - b : b);
+                if (unpacked[f][e * elem + b] != channel_data[f][src]){
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* Test steps:
+ *      1. pc_serialize() output must match ps_serialize() of reference interleave
+ *      2. Unpacking deserialized data view must restore channels
+ *      3. Unpacking data marked with foreign byte order must swap elements
+ */
+static bool test_layout(const test_layout_t* layout){
+    ros_PointField fields[TEST_MAX_FIELDS];
+    ros_PointCloud2 cloud;
+    pc_channel_t channels[TEST_MAX_FIELDS];
+    test_cloud(layout, fields, &cloud, channels);
+
+    size_t len = pc_serialize(buffer, &cloud, channels, layout->n_fields, sizeof(buffer));
+    cloud.data = (uint8_t_sequence){.data = reference, .n_elements = cloud.point_step * TEST_POINTS};
+    size_t expected_len = ps_serialize(expected, &cloud, sizeof(expected));
+    bool passed = len > 0 && len == expected_len && memcmp(buffer, expected, len) == 0
+        && cloud.row_step == cloud.point_step * TEST_POINTS;
+
+    static uint8_t storage[1024];
+    ps_arena_t arena = {.buf = storage, .size = sizeof(storage)};
+    ros_PointCloud2 received = {};
+    pc_channel_t out[TEST_MAX_FIELDS];
+    for (uint32_t f = 0; f < layout->n_fields; f++){
+        out[f] = (pc_channel_t){.name = fields[f].name, .data = unpacked[f]};
+    }
+    memset(unpacked, 0, sizeof(unpacked));
+    passed = passed && ps_deserialize_arena(buffer, &received, len, &arena)
+        && received.data.data >= buffer && received.data.data < buffer + len
+        && pc_unpack(&received, out, layout->n_fields) && test_unpacked(&received, false);
+
+    received.is_bigendian = !received.is_bigendian;
+    memset(unpacked, 0, sizeof(unpacked));
+    passed = passed && pc_unpack(&received, out, layout->n_fields) && test_unpacked(&received, true);
+    return passed;
+}
+
+#define TEST_CLOUD(pLAYOUT) \
+    do { \
+        bool test_passed = test_layout(pLAYOUT); \
+        print_test_result((pLAYOUT)->name, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+int main() {
+    print_header("PICOCLOUD UNIT TESTS");
+    bool some_test_failed = false;
+
+    print_header("Pack and Unpack Tests:");
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++){
+        TEST_CLOUD(&layouts[l])
+    }
+
+    print_header("Layout Tests:");
+    {
+        ros_PointField fields[TEST_MAX_FIELDS];
+        ros_PointCloud2 cloud;
+        pc_channel_t channels[TEST_MAX_FIELDS];
+        test_cloud(&layouts[3], fields, &cloud, channels);
+        // rgb 0, x 4, y 8, normal 12, label 24, step rounded to 28
+        bool test_passed = fields[0].offset == 0 && fields[1].offset == 4 && fields[2].offset == 8
+            && fields[3].offset == 12 && fields[4].offset == 24 && cloud.point_step == 28;
+        print_test_result("pc_fields_init offsets", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+
+        pc_channel_t unknown = {.name = "w", .data = channel_data[0]};
+        test_passed = !pc_pack(&cloud, &unknown, 1, reference)
+            && pc_serialize(buffer, &cloud, &unknown, 1, sizeof(buffer)) == 0;
+        fields[2].offset = 6;
+        test_passed = test_passed && !pc_pack(&cloud, channels, layouts[3].n_fields, reference);
+        fields[2].offset = 8;
+        fields[4].offset = 28;
+        test_passed = test_passed && !pc_pack(&cloud, channels, layouts[3].n_fields, reference);
+        fields[4].offset = 24;
+        test_passed = test_passed && pc_pack(&cloud, channels, layouts[3].n_fields, reference)
+            && pc_serialize(buffer, &cloud, channels, layouts[3].n_fields, 100) == 0;
+        cloud.data = (uint8_t_sequence){.data = reference, .n_elements = cloud.point_step * TEST_POINTS - 1};
+        test_passed = test_passed && !pc_unpack(&cloud, channels, layouts[3].n_fields);
+        print_test_result("invalid layouts rejected", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+
+    if(some_test_failed){
+        printf("\n%s%s Some tests failed! %s\n\n",
+               BOLD_TEXT, RED_TEXT, RESET_TEXT);
+        return EXIT_FAILURE;
+    }
+    else{
+        printf("\n%s%s All tests completed successfully! %s\n\n",
+               BOLD_TEXT, GREEN_TEXT, RESET_TEXT);
+        return EXIT_SUCCESS;
+    }
+}
@@ -0,0 +1,369 @@
+/**
+ ******************************************************************************
+ * @file    test_picodyn.c
+ * @brief   Unit tests for picodyn runtime dynamic types
+ * @details Type description JSON of every example type is generated from picoserdes
+ *          type descriptors (build with PS_REFLECTION), dynamic serialization must
+ *          match compiled serializers byte for byte.
+ ******************************************************************************
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../src/picodyn.h"
+
+#undef NDEBUG
+
+// Buffer sizes of tests
+#define TEST_BUFFER_SIZE 4096
+#define TEST_JSON_SIZE 65536
+#define TEST_ARENA_SIZE 65536
+#define TEST_MAX_TYPES 64
+#define TEST_MAX_EVENTS 1024
+
+// Formatting constants
+#define TEST_INDENT "    "
+#define GREEN_TEXT "\033[0;32m"
+#define RED_TEXT   "\033[0;31m"
+#define RESET_TEXT "\033[0m"
+#define BOLD_TEXT  "\033[1m"
+
+// Helper functions for formatting
+void print_header(const char* title) {
+    printf("%s", BOLD_TEXT);
+    printf("  %s\n", title);
+    printf("%s", RESET_TEXT);
+}
+
+void print_test_result(const char* type_name, bool passed) {
+    printf("%s%s[%s] Test %s: %s%s\n",
+           TEST_INDENT,
+           passed ? GREEN_TEXT : RED_TEXT,
+           passed ? "✓" : "✗",
+           type_name,
+           passed ? "PASSED" : "FAILED",
+           RESET_TEXT);
+}
+
+/* ----- JSON generation from type descriptors ------------------------------*/
+
+// rosidl FIELD_TYPE_* of base types in BASE_TYPES_LIST order
+static const uint8_t base_ids[] = {
+    [PS_BASE_bool] = 15, [PS_BASE_char] = 13, [PS_BASE_int8_t] = 2, [PS_BASE_uint8_t] = 3,
+    [PS_BASE_int16_t] = 4, [PS_BASE_uint16_t] = 5, [PS_BASE_int32_t] = 6, [PS_BASE_uint32_t] = 7,
+    [PS_BASE_int64_t] = 8, [PS_BASE_uint64_t] = 9, [PS_BASE_float] = 10, [PS_BASE_double] = 11,
+    [PS_BASE_rstring] = 17,
+};
+
+typedef struct {
+    char* out;
+    size_t len;
+    const ps_type_desc_t* types[TEST_MAX_TYPES];
+    size_t n_types;
+} json_gen_t;
+
+#define JSON_PRINT(g, ...) ((g)->len += snprintf(&(g)->out[(g)->len], TEST_JSON_SIZE - (g)->len, __VA_ARGS__))
+
+// Collect referenced compound types depth first
+static void json_collect(json_gen_t* g, const ps_type_desc_t* desc){
+    for (size_t i = 0; i < g->n_types; i++){
+        if (g->types[i] == desc){
+            return;
+        }
+    }
+    g->types[g->n_types++] = desc;
+    for (uint16_t f = 0; f < desc->n_fields; f++){
+        const ps_type_desc_t* type = desc->fields[f].type();
+        if (type->base == PS_BASE_NONE){
+            json_collect(g, type);
+        }
+    }
+}
+
+static void json_description(json_gen_t* g, const ps_type_desc_t* desc){
+    JSON_PRINT(g, "{\"type_name\": \"test/msg/%s\", \"fields\": [", desc->name);
+    for (uint16_t f = 0; f < desc->n_fields; f++){
+        const ps_field_desc_t* field = &desc->fields[f];
+        const ps_type_desc_t* type = field->type();
+        uint32_t id = (type->base == PS_BASE_NONE) ? 1 : base_ids[type->base];
+        id += (field->kind == PS_KIND_ARRAY) ? 48 : (field->kind == PS_KIND_BOUNDED_SEQUENCE) ? 96
+            : (field->kind == PS_KIND_SEQUENCE) ? 144 : (field->kind == PS_KIND_BOUNDED_STRING) ? 4 : 0;
+        bool capacity = field->kind == PS_KIND_ARRAY || field->kind == PS_KIND_BOUNDED_SEQUENCE;
+        JSON_PRINT(g, "%s\n  {\"name\": \"%s\", \"type\": {\"type_id\": %u, \"capacity\": %u, "
+                   "\"string_capacity\": %u, \"nested_type_name\": \"",
+                   (f > 0) ? "," : "", field->name, (unsigned)id, (unsigned)(capacity ? field->count : 0),
+                   (unsigned)((field->kind == PS_KIND_BOUNDED_STRING) ? field->count : 0));
+        if (type->base == PS_BASE_NONE){
+            JSON_PRINT(g, "test/msg/%s", type->name);
+        }
+        JSON_PRINT(g, "\"}, \"default_value\": \"\"}");
+    }
+    JSON_PRINT(g, "]}");
+}
+
+// Build rosidl_generator_type_description style document of type
+static size_t json_generate(char* out, const ps_type_desc_t* desc){
+    json_gen_t g = {.out = out};
+    json_collect(&g, desc);
+    JSON_PRINT(&g, "{\"type_description_msg\": {\"type_description\": ");
+    json_description(&g, desc);
+    JSON_PRINT(&g, ", \"referenced_type_descriptions\": [");
+    for (size_t i = 1; i < g.n_types; i++){
+        JSON_PRINT(&g, (i > 1) ? ", " : "");
+        json_description(&g, g.types[i]);
+    }
+    JSON_PRINT(&g, "]}, \"type_hashes\": []}");
+    return g.len;
+}
+
+/* ----- generic message fill through descriptors ---------------------------*/
+
+static void fill_value(const ps_type_desc_t* desc, uint8_t* p, ps_arena_t* arena, unsigned* seed){
+    unsigned v = (*seed)++ * 37 + 11;
+    switch (desc->base){
+        case PS_BASE_bool:     *(bool*)p = v & 1; return;
+        case PS_BASE_char:     *(char*)p = 'a' + v % 26; return;
+        case PS_BASE_int8_t:   *(int8_t*)p = -(int8_t)v; return;
+        case PS_BASE_uint8_t:  *(uint8_t*)p = (uint8_t)v; return;
+        case PS_BASE_int16_t:  *(int16_t*)p = -(int16_t)v; return;
+        case PS_BASE_uint16_t: *(uint16_t*)p = (uint16_t)v; return;
+        case PS_BASE_int32_t:  *(int32_t*)p = -(int32_t)v * 1000; return;
+        case PS_BASE_uint32_t: *(uint32_t*)p = v * 1000; return;
+        case PS_BASE_int64_t:  *(int64_t*)p = -(int64_t)((uint64_t)v << 33); return;
+        case PS_BASE_uint64_t: *(uint64_t*)p = (uint64_t)v << 33; return;
+        case PS_BASE_float:    *(float*)p = v * 0.25f; return;
+        case PS_BASE_double:   *(double*)p = v * 0.125; return;
+        case PS_BASE_rstring:  *(char**)p = (v & 2) ? "dynamic string" : "x"; return;
+        default: break;
+    }
+    for (uint16_t f = 0; f < desc->n_fields; f++){
+        const ps_field_desc_t* field = &desc->fields[f];
+        const ps_type_desc_t* type = field->type();
+        uint8_t* member = p + field->offset;
+        uint32_t n = field->count;
+        if (field->kind == PS_KIND_BOUNDED_STRING){
+            snprintf((char*)member, n + 1, "%s", (*seed)++ & 1 ? "bounded string" : "b");
+            continue;
+        }
+        if (field->kind == PS_KIND_BOUNDED_SEQUENCE){
+            // Elements inline followed by uint32_t count
+            size_t data = (size_t)n * type->size;
+            n = *seed % (n + 1);
+            memcpy(member + ((data + 3) & ~(size_t)3), &n, sizeof(n));
+        }
+        else if (field->kind == PS_KIND_SEQUENCE){
+            n = *seed % 3;
+            uint8_t* data = ps_arena_alloc(arena, n, type->size, type->align);
+            memcpy(member, &data, sizeof(data));
+            memcpy(member + sizeof(data), &n, sizeof(n));
+            member = data;
+        }
+        for (uint32_t i = 0; i < n; i++){
+            fill_value(type, member + i * type->size, arena, seed);
+        }
+    }
+}
+
+/* ----- field callback recording -------------------------------------------*/
+
+typedef struct {
+    char path[PD_PATH_MAX];
+    pd_value_t value;
+} test_event_t;
+
+typedef struct {
+    test_event_t events[TEST_MAX_EVENTS];
+    size_t n;
+    size_t at;
+} test_events_t;
+
+static bool record_cb(void* ctx, const char* path, const pd_field_t* field, pd_value_t* value){
+    test_events_t* rec = ctx;
+    if (rec->n == TEST_MAX_EVENTS){
+        return false;
+    }
+    strcpy(rec->events[rec->n].path, path);
+    rec->events[rec->n++].value = *value;
+    return true;
+}
+
+static bool replay_cb(void* ctx, const char* path, const pd_field_t* field, pd_value_t* value){
+    test_events_t* rec = ctx;
+    if (rec->at == rec->n || strcmp(rec->events[rec->at].path, path) != 0){
+        return false;
+    }
+    *value = rec->events[rec->at++].value;
+    return true;
+}
+
+/* Test of compiled type against its generated type description:
+ *      1. Serialize generically filled message with compiled serializer
+ *      2. Deserialize to value tree and serialize it back, compare buffers
+ *      3. Deserialize to callbacks and serialize from recorded events, compare buffers
+ *      4. Truncated message must fail
+ */
+static bool test_dyn(const ps_type_desc_t* desc, uint8_t* buffer, size_t len){
+    static char json[TEST_JSON_SIZE];
+    static uint8_t schema_storage[TEST_ARENA_SIZE];
+    static uint8_t storage[TEST_ARENA_SIZE];
+    static test_events_t rec;
+    uint8_t buffer2[TEST_BUFFER_SIZE] = {};
+    ps_arena_t schema = {.buf = schema_storage, .size = sizeof(schema_storage)};
+    ps_arena_t arena = {.buf = storage, .size = sizeof(storage)};
+    size_t json_len = json_generate(json, desc);
+    const pd_type_t* type = pd_load_json(json, json_len, &schema);
+    pd_value_t value = {0};
+    bool passed = type != NULL && len > 0
+        && pd_deserialize(buffer, type, &value, len, &arena)
+        && pd_serialize(buffer2, type, &value, TEST_BUFFER_SIZE) == len
+        && memcmp(buffer, buffer2, len) == 0;
+    memset(buffer2, 0, sizeof(buffer2));
+    rec.n = rec.at = 0;
+    passed = passed && pd_deserialize_cb(buffer, type, record_cb, &rec, len)
+        && pd_serialize_cb(buffer2, type, replay_cb, &rec, TEST_BUFFER_SIZE) == len
+        && rec.at == rec.n && memcmp(buffer, buffer2, len) == 0;
+    ps_arena_reset(&arena);
+    rec.n = 0;
+    passed = passed && (len == 4 || !pd_deserialize(buffer, type, &value, len - 1, &arena))
+        && (len == 4 || !pd_deserialize_cb(buffer, type, record_cb, &rec, len - 1))
+        && pd_serialize(buffer2, type, pd_value_new(type, &arena), 3) == 0;
+    return passed;
+}
+
+#define TEST_DYN(TYPE, ...) \
+    do { \
+        static uint8_t storage[TEST_ARENA_SIZE]; \
+        ps_arena_t arena = {.buf = storage, .size = sizeof(storage)}; \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        TYPE msg; \
+        unsigned seed = 1; \
+        memset(&msg, 0, sizeof(msg)); \
+        fill_value(PS_DESC(TYPE), (uint8_t*)&msg, &arena, &seed); \
+        size_t len = _ps_serialize(buffer, &msg, TEST_BUFFER_SIZE); \
+        bool test_passed = test_dyn(PS_DESC(TYPE), buffer, len); \
+        print_test_result("dynamic " #TYPE, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+#define TEST_DYN_SRV(TYPE, ...) \
+    TEST_DYN(request_##TYPE) \
+    TEST_DYN(reply_##TYPE)
+
+// Descriptor getters of service types follow ps_desc_<SRV>_request naming
+#define PS_DESC_SRV_ALIAS(TYPE, ...) \
+    static inline const ps_type_desc_t* ps_desc_request_##TYPE(void) { return ps_desc_##TYPE##_request(); } \
+    static inline const ps_type_desc_t* ps_desc_reply_##TYPE(void) { return ps_desc_##TYPE##_reply(); }
+SRV_LIST(PS_DESC_SRV_ALIAS, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+// Handwritten type description with hashes, string array and bounded sequence
+static const char header_json[] =
+    "{\"type_description_msg\": {\n"
+    "  \"type_description\": {\"type_name\": \"test_msgs/msg/Tagged\", \"fields\": [\n"
+    "    {\"name\": \"header\", \"type\": {\"type_id\": 1, \"capacity\": 0, \"string_capacity\": 0,\n"
+    "      \"nested_type_name\": \"std_msgs/msg/Header\"}, \"default_value\": \"\"},\n"
+    "    {\"name\": \"tags\", \"type\": {\"type_id\": 65, \"capacity\": 2, \"string_capacity\": 0,\n"
+    "      \"nested_type_name\": \"\"}, \"default_value\": \"\"},\n"
+    "    {\"name\": \"codes\", \"type\": {\"type_id\": 101, \"capacity\": 3, \"string_capacity\": 0,\n"
+    "      \"nested_type_name\": \"\"}, \"default_value\": \"\"}]},\n"
+    "  \"referenced_type_descriptions\": [\n"
+    "    {\"type_name\": \"builtin_interfaces/msg/Time\", \"fields\": [\n"
+    "      {\"name\": \"sec\", \"type\": {\"type_id\": 6, \"capacity\": 0, \"string_capacity\": 0, \"nested_type_name\": \"\"}},\n"
+    "      {\"name\": \"nanosec\", \"type\": {\"type_id\": 7, \"capacity\": 0, \"string_capacity\": 0, \"nested_type_name\": \"\"}}]},\n"
+    "    {\"type_name\": \"std_msgs/msg/Header\", \"fields\": [\n"
+    "      {\"name\": \"stamp\", \"type\": {\"type_id\": 1, \"capacity\": 0, \"string_capacity\": 0,\n"
+    "        \"nested_type_name\": \"builtin_interfaces/msg/Time\"}},\n"
+    "      {\"name\": \"frame_id\", \"type\": {\"type_id\": 17, \"capacity\": 0, \"string_capacity\": 0, \"nested_type_name\": \"\"}}]}]},\n"
+    " \"type_hashes\": [\n"
+    "  {\"type_name\": \"std_msgs/msg/Header\", \"hash_string\": \"RIHS01_f49fb3ae2cf070f793645ff749683ac6b06203e41c891e17701b1cb597ce6a01\"}]}\n";
+
+int main() {
+    print_header("PICODYN UNIT TESTS");
+    bool some_test_failed = false;
+
+    print_header("Message Types Tests:");
+    MSG_LIST_EXPAND(PS_UNUSED, TEST_DYN, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Service Types Tests:");
+    SRV_LIST_EXPAND(TEST_DYN_SRV, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Type Description Tests:");
+    {
+        static uint8_t storage[TEST_ARENA_SIZE];
+        ps_arena_t arena = {.buf = storage, .size = sizeof(storage)};
+        uint8_t buffer[TEST_BUFFER_SIZE] = {};
+        uint8_t buffer2[TEST_BUFFER_SIZE] = {};
+        const pd_type_t* tagged = pd_load_json(header_json, strlen(header_json), &arena);
+        const pd_type_t* header = pd_find_type(tagged, "std_msgs/msg/Header");
+        bool test_passed = tagged != NULL && header != NULL
+            && strcmp(tagged->name, "test_msgs/msg/Tagged") == 0
+            && strcmp(header->rmw_name, "std_msgs::msg::dds_::Header") == 0
+            && strcmp(header->hash, "f49fb3ae2cf070f793645ff749683ac6b06203e41c891e17701b1cb597ce6a01") == 0
+            && tagged->hash == NULL && pd_find_field(header, "frame_id") != NULL;
+        // header built dynamically must match compiled ros_Header
+        pd_value_t* value = test_passed ? pd_value_new(header, &arena) : NULL;
+        test_passed = test_passed && value != NULL;
+        if (test_passed){
+            pd_value_t* stamp = pd_member(header, value, "stamp");
+            pd_member(header->fields[0].nested, stamp, "sec")->i = 1234;
+            pd_member(header->fields[0].nested, stamp, "nanosec")->u = 5678;
+            pd_member(header, value, "frame_id")->s = "base_link";
+            ros_Header compiled = {.stamp = {1234, 5678}, .frame_id = "base_link"};
+            size_t len = ps_serialize(buffer, &compiled, TEST_BUFFER_SIZE);
+            test_passed = pd_serialize(buffer2, header, value, TEST_BUFFER_SIZE) == len
+                && memcmp(buffer, buffer2, len) == 0;
+        }
+        // string array carries count like picoserdes, bounded sequence is checked
+        value = test_passed ? pd_value_new(tagged, &arena) : NULL;
+        test_passed = test_passed && value != NULL;
+        if (test_passed){
+            const pd_field_t* codes = pd_find_field(tagged, "codes");
+            pd_value_t* tags = pd_member(tagged, value, "tags");
+            tags->items[0].s = "a";
+            tags->items[1].s = "bc";
+            test_passed = tags->n == 2 && codes->kind == PD_KIND_SEQUENCE && codes->capacity == 3
+                && !pd_value_resize(codes, pd_member(tagged, value, "codes"), 4, &arena)
+                && pd_value_resize(codes, pd_member(tagged, value, "codes"), 3, &arena);
+            pd_member(tagged, value, "codes")->items[2].u = 0xABCD;
+            ros_Header compiled = {};
+            size_t len = ps_serialize(buffer, &compiled, TEST_BUFFER_SIZE);
+            static const uint8_t tail[] = {
+                2, 0, 0, 0, 2, 0, 0, 0, 'a', 0, 0, 0, 3, 0, 0, 0, 'b', 'c', 0, 0,
+                3, 0, 0, 0, 0, 0, 0, 0, 0xCD, 0xAB };
+            size_t len2 = pd_serialize(buffer2, tagged, value, TEST_BUFFER_SIZE);
+            pd_value_t read = {0};
+            test_passed = test_passed && len2 == len + sizeof(tail)
+                && memcmp(buffer, buffer2, len) == 0 && memcmp(buffer2 + len, tail, sizeof(tail)) == 0
+                && pd_deserialize(buffer2, tagged, &read, len2, &arena)
+                && strcmp(read.items[1].items[1].s, "bc") == 0 && read.items[2].items[2].u == 0xABCD;
+            buffer2[len + 20] = 4; // sequence count over bound
+            test_passed = test_passed && !pd_deserialize(buffer2, tagged, &read, len2, &arena);
+        }
+        // unknown nested type and unsupported field type are rejected
+        static const char missing[] = "{\"type_description\": {\"type_name\": \"a/msg/A\", \"fields\": ["
+            "{\"name\": \"b\", \"type\": {\"type_id\": 1, \"nested_type_name\": \"a/msg/B\"}}]}}";
+        static const char wstring[] = "{\"type_description\": {\"type_name\": \"a/msg/A\", \"fields\": ["
+            "{\"name\": \"w\", \"type\": {\"type_id\": 18}}]}}";
+        test_passed = test_passed && pd_load_json(missing, strlen(missing), &arena) == NULL
+            && pd_load_json(wstring, strlen(wstring), &arena) == NULL
+            && pd_load_json(header_json, strlen(header_json) / 2, &arena) == NULL;
+        print_test_result("type description std_msgs/msg/Header", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+
+    if(some_test_failed){
+        printf("\n%s%s Some tests failed! %s\n\n",
+               BOLD_TEXT, RED_TEXT, RESET_TEXT);
+        return EXIT_FAILURE;
+    }
+    else{
+        printf("\n%s%s All tests completed successfully! %s\n\n",
+               BOLD_TEXT, GREEN_TEXT, RESET_TEXT);
+        return EXIT_SUCCESS;
+    }
+}
@@ -84,6 +84,246 @@ void print_test_result(const char* type_name, bool passed) {
         } \
     } while (0);
 
+/* Arena deserialization into zero initialized message, all sequences come from arena,
+ * allocations from unaligned storage must still be aligned */
+#define TEST_ARENA(type, ...) \
+    do { \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        uint8_t buffer2[TEST_BUFFER_SIZE] = {}; \
+        uint8_t storage[TEST_BUFFER_SIZE]; \
+        ps_arena_t arena = {.buf = storage, .size = sizeof(storage)}; \
+        type msg = {}; \
+        size_t len = _ps_serialize(buffer, &test_##type, TEST_BUFFER_SIZE); \
+        bool test_passed = _ps_deserialize_arena(buffer, &msg, TEST_BUFFER_SIZE, &arena); \
+        test_passed = test_passed && arena.used <= arena.size \
+            && _ps_serialize(buffer2, &msg, TEST_BUFFER_SIZE) == len \
+            && memcmp(buffer, buffer2, len) == 0; \
+        ps_arena_reset(&arena); \
+        test_passed = test_passed && arena.used == 0; \
+        ps_arena_t odd = {.buf = storage + 1, .size = sizeof(storage) - 1}; \
+        test_passed = test_passed && ((uintptr_t)ps_arena_alloc(&odd, 1, 8, 8) & 7) == 0; \
+        print_test_result("arena " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+/* Zero initialized message has empty sequences without storage, it must deserialize
+ * into zero initialized message without arena */
+#define TEST_EMPTY(type, ...) \
+    do { \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        type zero = {}; \
+        type msg = {}; \
+        size_t len = _ps_serialize(buffer, &zero, TEST_BUFFER_SIZE); \
+        bool test_passed = len > 0 && _ps_deserialize(buffer, &msg, len); \
+        print_test_result("empty " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+/* Message in foreign byte order must deserialize to the same message:
+ *      1. Serialize with writer in byte order opposite to host and matching header
+ *      2. Validate and deserialize foreign buffer
+ *      3. Serialize deserialized message in host order and compare with direct serialization
+ */
+#define TEST_BYTE_ORDER(type, ...) \
+    do { \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        uint8_t foreign[TEST_BUFFER_SIZE] = {}; \
+        uint8_t buffer2[TEST_BUFFER_SIZE] = {}; \
+        uint8_t storage[TEST_BUFFER_SIZE]; \
+        ps_arena_t arena = {.buf = storage, .size = sizeof(storage)}; \
+        ucdrEndianness order = (UCDR_MACHINE_ENDIANNESS == UCDR_LITTLE_ENDIANNESS) \
+            ? UCDR_BIG_ENDIANNESS : UCDR_LITTLE_ENDIANNESS; \
+        ucdrBuffer writer = {}; \
+        type msg = {}; \
+        size_t len = _ps_serialize(buffer, &test_##type, TEST_BUFFER_SIZE); \
+        foreign[1] = (uint8_t)order; \
+        ucdr_init_buffer_origin_offset_endian(&writer, foreign + 4, TEST_BUFFER_SIZE - 4, 0, 0, order); \
+        bool test_passed = ps_ser_##type(&writer, &test_##type) \
+            && ucdr_buffer_length(&writer) + 4 == len \
+            && _ps_validate(foreign, &msg, len) \
+            && _ps_deserialize_arena(foreign, &msg, len, &arena) \
+            && _ps_serialize(buffer2, &msg, TEST_BUFFER_SIZE) == len \
+            && memcmp(buffer, buffer2, len) == 0; \
+        print_test_result("byte order " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+/* Vectorized byte swap must match scalar reversal for unaligned data and partial blocks */
+#define TEST_BSWAP(size) \
+    do { \
+        uint8_t data[1 + 37 * size]; \
+        uint8_t expected[1 + 37 * size]; \
+        for (size_t i = 0; i < sizeof(data); i++){ data[i] = (uint8_t)(i * 7 + 3); } \
+        memcpy(expected, data, sizeof(data)); \
+        for (size_t e = 0; e < 37; e++){ \
+            for (size_t b = 0; b < size; b++){ expected[1 + e * size + b] = data[1 + e * size + size - 1 - b]; } \
+        } \
+        ps_bswap(data + 1, 37, size); \
+        bool test_passed = memcmp(data, expected, sizeof(data)) == 0; \
+        print_test_result("bswap " #size " byte", test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+/* Large plain sequences copied by pool threads must match single thread output in both byte orders */
+#define TEST_PARALLEL_ELEMENTS 100003
+#ifdef PS_PARALLEL
+#define TEST_PARALLEL_START() ps_parallel_init(3, 4096)
+#define TEST_PARALLEL_STOP() ps_parallel_deinit()
+#else
+#define TEST_PARALLEL_START() true
+#define TEST_PARALLEL_STOP()
+#endif
+#define TEST_PARALLEL(type) \
+    do { \
+        size_t size = 2 * sizeof(uint64_t) + TEST_PARALLEL_ELEMENTS * sizeof(type); \
+        type* values = malloc(TEST_PARALLEL_ELEMENTS * sizeof(type)); \
+        type* copy = malloc(TEST_PARALLEL_ELEMENTS * sizeof(type)); \
+        uint8_t* single[2] = {calloc(1, size), calloc(1, size)}; \
+        uint8_t* parallel = calloc(1, size); \
+        ucdrEndianness orders[2] = {UCDR_MACHINE_ENDIANNESS, \
+            (UCDR_MACHINE_ENDIANNESS == UCDR_LITTLE_ENDIANNESS) ? UCDR_BIG_ENDIANNESS : UCDR_LITTLE_ENDIANNESS}; \
+        for (size_t i = 0; i < TEST_PARALLEL_ELEMENTS; i++){ values[i] = (type)(i * 7 + 3); } \
+        type##_sequence seq = {.data = values, .n_elements = TEST_PARALLEL_ELEMENTS}; \
+        type##_sequence out = {.data = copy, .n_elements = TEST_PARALLEL_ELEMENTS}; \
+        ucdrBuffer ub = {}; \
+        bool test_passed = true; \
+        for (int o = 0; o < 2 && test_passed; o++){ \
+            ucdr_init_buffer_origin_offset_endian(&ub, single[o], size, 0, 0, orders[o]); \
+            test_passed = ps_ser_sequence_##type(&ub, &seq); \
+        } \
+        test_passed = test_passed && TEST_PARALLEL_START(); \
+        ucdr_init_buffer_origin_offset_endian(&ub, parallel, size, 0, 0, UCDR_MACHINE_ENDIANNESS); \
+        test_passed = test_passed && ps_ser_sequence_##type(&ub, &seq) \
+            && memcmp(single[0], parallel, size) == 0; \
+        for (int o = 0; o < 2 && test_passed; o++){ \
+            memset(copy, 0, TEST_PARALLEL_ELEMENTS * sizeof(type)); \
+            ucdr_init_buffer_origin_offset_endian(&ub, single[o], size, 0, 0, orders[o]); \
+            test_passed = ps_des_sequence_##type(&ub, &out) \
+                && out.n_elements == TEST_PARALLEL_ELEMENTS \
+                && memcmp(values, copy, TEST_PARALLEL_ELEMENTS * sizeof(type)) == 0; \
+        } \
+        TEST_PARALLEL_STOP(); \
+        print_test_result("parallel " #type "_sequence", test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+        free(values); free(copy); free(single[0]); free(single[1]); free(parallel); \
+    } while (0);
+
+/* Computed size must equal serialized size and fit maximum size of bounded types */
+#define TEST_SIZE(type, ...) \
+    do { \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        size_t len = _ps_serialize(buffer, &test_##type, TEST_BUFFER_SIZE); \
+        bool test_passed = _ps_serialized_size(&test_##type) == len \
+            && (PS_MAX_SIZE(type) < 0 || (size_t)PS_MAX_SIZE(type) >= len); \
+        print_test_result("size " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+#define TEST_SRV_SIZE(TYPE, ...) \
+    TEST_SIZE(request_##TYPE) \
+    TEST_SIZE(reply_##TYPE)
+
+/* Fuzzing: validator must accept serialized value, reject its truncations and every mutated
+ * buffer it accepts must deserialize successfully */
+#define TEST_FUZZ_ROUNDS 2000
+static uint8_t fuzz_storage[TEST_BUFFER_SIZE * 64];
+static uint32_t fuzz_state = 0x12345678;
+static uint32_t fuzz_random(void){
+    fuzz_state ^= fuzz_state << 13;
+    fuzz_state ^= fuzz_state >> 17;
+    fuzz_state ^= fuzz_state << 5;
+    return fuzz_state;
+}
+#define TEST_FUZZ(type, ...) \
+    do { \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        uint8_t fuzzed[TEST_BUFFER_SIZE]; \
+        size_t len = _ps_serialize(buffer, &test_##type, TEST_BUFFER_SIZE); \
+        bool test_passed = _ps_validate(buffer, &test_##type, len); \
+        for (size_t t = 0; t < len && test_passed; t++){ \
+            test_passed = !_ps_validate(buffer, &test_##type, t); \
+        } \
+        for (int round = 0; round < TEST_FUZZ_ROUNDS && test_passed; round++){ \
+            memcpy(fuzzed, buffer, len); \
+            for (int m = fuzz_random() % 4; m >= 0; m--){ \
+                fuzzed[4 + fuzz_random() % (len - 4)] = (uint8_t)fuzz_random(); \
+            } \
+            size_t fuzzed_len = len - fuzz_random() % 4; \
+            if (_ps_validate(fuzzed, &test_##type, fuzzed_len)){ \
+                ps_arena_t arena = {.buf = fuzz_storage, .size = sizeof(fuzz_storage)}; \
+                type msg = {}; \
+                test_passed = _ps_deserialize_arena(fuzzed, &msg, fuzzed_len, &arena); \
+            } \
+        } \
+        print_test_result("fuzz " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+#ifdef PS_REFLECTION
+/* Type descriptor must list all fields with C offsets and field types */
+#define TEST_DESC_MEMBER(NAME, DESC, KIND, COUNT) \
+    n_fields++; \
+    field = ps_desc_field(desc, #NAME); \
+    test_passed = test_passed && field != NULL && field->type == DESC \
+        && field->offset == offsetof(desc_owner_t, NAME) && field->kind == KIND && field->count == COUNT;
+#define TEST_DESC_FIELD(TYPE, ...) PS_BOUNDED(TEST_DESC_TYPE, TEST_DESC_STRING, __VA_ARGS__)(ps_desc_##TYPE, __VA_ARGS__)
+#define TEST_DESC_TYPE(DESC, NAME) TEST_DESC_MEMBER(NAME, DESC, PS_KIND_FIELD, 1)
+#define TEST_DESC_STRING(DESC, NAME, BOUND) TEST_DESC_MEMBER(NAME, DESC, PS_KIND_BOUNDED_STRING, BOUND)
+#define TEST_DESC_ARRAY(TYPE, NAME, SIZE) TEST_DESC_MEMBER(NAME, ps_desc_##TYPE, PS_KIND_ARRAY, SIZE)
+#define TEST_DESC_SEQUENCE(TYPE, ...) PS_BOUNDED(TEST_DESC_POINTER, TEST_DESC_INLINE, __VA_ARGS__)(ps_desc_##TYPE, __VA_ARGS__)
+#define TEST_DESC_POINTER(DESC, NAME) TEST_DESC_MEMBER(NAME, DESC, PS_KIND_SEQUENCE, 0)
+#define TEST_DESC_INLINE(DESC, NAME, BOUND) TEST_DESC_MEMBER(NAME, DESC, PS_KIND_BOUNDED_SEQUENCE, BOUND)
+#define TEST_DESC(type, NAME, HASH, ...) \
+    do { \
+        typedef type desc_owner_t; \
+        const ps_type_desc_t* desc = PS_DESC(type); \
+        const ps_field_desc_t* field = NULL; \
+        size_t n_fields = 0; \
+        bool test_passed = desc->size == sizeof(type) && desc->base == PS_BASE_NONE; \
+        __VA_ARGS__ \
+        test_passed = test_passed && n_fields == desc->n_fields && ps_desc_field(desc, "?") == NULL; \
+        print_test_result("descriptor " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+#endif
+
+/* Peek must read the same value as full deserialization and fail on truncated prefix */
+#define TEST_PEEK(type, PATH, field_type) \
+    do { \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        size_t len = _ps_serialize(buffer, &test_##type, TEST_BUFFER_SIZE); \
+        uint8_t storage[TEST_BUFFER_SIZE]; \
+        ps_arena_t arena = {.buf = storage, .size = sizeof(storage)}; \
+        type msg = {}; \
+        field_type out; \
+        memset(&out, 0, sizeof(out)); \
+        bool test_passed = _ps_deserialize_arena(buffer, &msg, len, &arena) \
+            && _ps_peek(buffer, len, type, PATH, &out) \
+            && memcmp(&out, &msg.PATH, sizeof(out)) == 0; \
+        size_t offset = ps_seek_##type(buffer + 4, len - 4, 0, #PATH); \
+        test_passed = test_passed && !_ps_peek(buffer, offset + 4, type, PATH, &out) \
+            && ps_seek_##type(buffer + 4, len - 4, 0, #PATH ".none") == PS_VAL_FAIL; \
+        print_test_result("peek " #type "." #PATH, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
 /* Helper macros for test values generation */
 #define MAKE_TEST_SEQUENCE_DATA(TYPE, ...) \
     TYPE##_sequence test_sequence_##TYPE = {.data = &test_##TYPE, .n_elements = 1};
@@ -92,14 +332,20 @@ void print_test_result(const char* type_name, bool passed) {
     TYPE test_##TYPE = test_##TYPE2; \
     MAKE_TEST_SEQUENCE_DATA(TYPE)
 
-#define MAKE_TEST_FIELD(TYPE, NAME) \
-    .NAME = test_##TYPE,
+#define MAKE_TEST_FIELD(TYPE, ...) PS_BOUNDED(MAKE_TEST_TYPE, MAKE_TEST_STRING, __VA_ARGS__)(test_##TYPE, __VA_ARGS__)
+#define MAKE_TEST_TYPE(VALUE, NAME) \
+    .NAME = VALUE,
+#define MAKE_TEST_STRING(VALUE, NAME, BOUND) \
+    .NAME = "bounded",
 
 #define MAKE_TEST_ARRAY(TYPE, NAME, SIZE) \
     .NAME = {1, 2},
 
-#define MAKE_TEST_SEQUENCE(TYPE, NAME) \
-    .NAME = test_sequence_##TYPE,
+#define MAKE_TEST_SEQUENCE(TYPE, ...) PS_BOUNDED(MAKE_TEST_POINTER, MAKE_TEST_INLINE, __VA_ARGS__)(test_##TYPE, test_sequence_##TYPE, __VA_ARGS__)
+#define MAKE_TEST_POINTER(VALUE, SEQ, NAME) \
+    .NAME = SEQ,
+#define MAKE_TEST_INLINE(VALUE, SEQ, NAME, BOUND) \
+    .NAME = {.data = {VALUE}, .n_elements = 1},
 
 #define MAKE_TEST_CTYPE(TYPE, NAME, HASH, ...)  \
     TYPE test_##TYPE = {  __VA_ARGS__ };        \
@@ -109,11 +355,14 @@ void print_test_result(const char* type_name, bool passed) {
 #define MAKE_TEST_SEQUENCE_DATA_BUF(TYPE, ...) \
     TYPE##_sequence deserialized_sequence_##TYPE = {.data = &deserialized_##TYPE, .n_elements = 1};
 
-#define MAKE_TEST_SEQUENCE_BUF(TYPE, NAME)          \
-    .NAME = deserialized_sequence_##TYPE,
+// Bounded strings and sequences have inline storage
+#define MAKE_TEST_SEQUENCE_BUF(TYPE, ...) PS_BOUNDED(MAKE_TEST_POINTER_BUF, PS_UNUSED, __VA_ARGS__)(deserialized_sequence_##TYPE, __VA_ARGS__)
+#define MAKE_TEST_POINTER_BUF(SEQ, NAME)           \
+    .NAME = SEQ,
 
-#define MAKE_TEST_FIELD_BUF(TYPE, NAME) \
-    .NAME = deserialized_##TYPE,
+#define MAKE_TEST_FIELD_BUF(TYPE, ...) PS_BOUNDED(MAKE_TEST_TYPE_BUF, PS_UNUSED, __VA_ARGS__)(deserialized_##TYPE, __VA_ARGS__)
+#define MAKE_TEST_TYPE_BUF(VALUE, NAME) \
+    .NAME = VALUE,
 
 #define MAKE_TEST_CTYPE_BUF(TYPE, NAME, HASH, ...)  \
     TYPE deserialized_##TYPE = {  __VA_ARGS__ }; \
@@ -138,6 +387,59 @@ void print_test_result(const char* type_name, bool passed) {
     TEST_TYPE(request_##TYPE) \
     TEST_TYPE(reply_##TYPE)
 
+/* Test macro for serialized templates of numeric types.
+ *      1. Build template of sequence with two elements, recording second element,
+ *         init into buffer too small for message and of element out of range must fail
+ *      2. Change element value and update template
+ *      3. Compare template with fresh serialization
+ */
+#define NUMERIC_TYPES_LIST(TYPE) \
+    TYPE(int8_t) TYPE(uint8_t) TYPE(int16_t) TYPE(uint16_t) TYPE(int32_t) \
+    TYPE(uint32_t) TYPE(int64_t) TYPE(uint64_t) TYPE(float) TYPE(double)
+
+#define TEST_TEMPLATE(type) \
+    do { \
+        uint8_t buffer[TEST_BUFFER_SIZE] = {}; \
+        uint8_t buffer2[TEST_BUFFER_SIZE] = {}; \
+        type values[2] = {test_##type, test_##type}; \
+        type##_sequence seq = {.data = values, .n_elements = 2}; \
+        ps_template_t tpl = {.buf = buffer, .size = TEST_BUFFER_SIZE}; \
+        ps_template_t small = {.buf = buffer, .size = 4}; \
+        bool test_passed = !ps_template_init(&small, &seq, PS_FIELD(&seq, data[1])) \
+            && !ps_template_init(&tpl, &seq, PS_FIELD(&seq, data[2])); \
+        test_passed = ps_template_init(&tpl, &seq, PS_FIELD(&seq, data[1])) && test_passed; \
+        values[1] = (type)(values[1] + 1); \
+        ps_template_update(&tpl); \
+        size_t len = _ps_serialize(buffer2, &seq, TEST_BUFFER_SIZE); \
+        test_passed = test_passed && len == tpl.len && memcmp(buffer, buffer2, len) == 0; \
+        print_test_result("template " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+/* Test macro for zero copy sequence views of numeric types.
+ *      1. Serialize sequence to buffer with 8 byte aligned CDR origin
+ *      2. Deserialize to sequence without data storage
+ *      3. Check that data points into buffer and holds original values
+ */
+#define TEST_VIEW(type) \
+    do { \
+        uint8_t aligned[TEST_BUFFER_SIZE] __attribute__((aligned(8))) = {}; \
+        uint8_t* buffer = aligned + 4; \
+        type values[3] = {test_##type, (type)(test_##type + 1), (type)(test_##type + 2)}; \
+        type##_sequence seq = {.data = values, .n_elements = 3}; \
+        type##_sequence view = {.data = NULL, .n_elements = 0}; \
+        size_t len = _ps_serialize(buffer, &seq, TEST_BUFFER_SIZE - 4); \
+        bool test_passed = _ps_deserialize(buffer, &view, len); \
+        test_passed = test_passed && view.n_elements == 3 \
+            && (uint8_t*)view.data > buffer && (uint8_t*)view.data < buffer + len \
+            && memcmp(view.data, values, sizeof(values)) == 0; \
+        print_test_result("view " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
 
 int main() {
     print_header("PICOSERDES UNIT TESTS");
@@ -179,6 +481,192 @@ int main() {
     print_header("Service Types Tests:");
     SRV_LIST_EXPAND(TEST_SRV, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
 
+    print_header("Template Tests:");
+    PS_EXPAND(NUMERIC_TYPES_LIST(TEST_TEMPLATE))
+#ifdef GENERATED_TYPES_H
+    {
+        // Nested field, sequence and array elements are located, string field is rejected
+        uint8_t buffer[TEST_BUFFER_SIZE] = {};
+        uint8_t buffer2[TEST_BUFFER_SIZE] = {};
+        double position[1] = {test_ros_JointState.position.data[0]};
+        ros_JointState js = test_ros_JointState;
+        js.position.data = position;
+        ros_Odometry odo = test_ros_Odometry;
+        ps_template_t tpl = {.buf = buffer, .size = TEST_BUFFER_SIZE};
+        bool test_passed = ps_template_init(&tpl, &js, PS_FIELD(&js, header.stamp.sec),
+                                            PS_FIELD(&js, position.data[0]))
+            && !ps_template_init(&tpl, &js, PS_FIELD(&js, header.frame_id));
+        test_passed = ps_template_init(&tpl, &js, PS_FIELD(&js, header.stamp.sec),
+                                       PS_FIELD(&js, position.data[0])) && test_passed;
+        js.header.stamp.sec += 1;
+        position[0] += 1.0;
+        ps_template_update(&tpl);
+        size_t len = ps_serialize(buffer2, &js, TEST_BUFFER_SIZE);
+        test_passed = test_passed && len == tpl.len && memcmp(buffer, buffer2, len) == 0;
+        test_passed = test_passed && ps_template_init(&tpl, &odo, PS_FIELD(&odo, pose.covariance[3]));
+        odo.pose.covariance[3] += 1.0;
+        ps_template_update(&tpl);
+        memset(buffer2, 0, sizeof(buffer2));
+        len = ps_serialize(buffer2, &odo, TEST_BUFFER_SIZE);
+        test_passed = test_passed && len == tpl.len && memcmp(buffer, buffer2, len) == 0;
+        print_test_result("template message fields", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+#endif
+
+    print_header("View Tests:");
+    PS_EXPAND(NUMERIC_TYPES_LIST(TEST_VIEW))
+
+    print_header("Arena Tests:");
+    MSG_LIST_EXPAND(PS_UNUSED, TEST_ARENA, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Empty Sequence Tests:");
+    MSG_LIST_EXPAND(PS_UNUSED, TEST_EMPTY, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Byte Order Tests:");
+    PS_EXPAND(TEST_BSWAP(2) TEST_BSWAP(4) TEST_BSWAP(8))
+    MSG_LIST_EXPAND(PS_UNUSED, TEST_BYTE_ORDER, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Parallel Copy Tests:");
+    PS_EXPAND(TEST_PARALLEL(uint16_t) TEST_PARALLEL(float) TEST_PARALLEL(double))
+
+    print_header("Size Tests:");
+    MSG_LIST_EXPAND(PS_UNUSED, TEST_SIZE, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+    SRV_LIST_EXPAND(TEST_SRV_SIZE, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Validation Fuzz Tests:");
+    MSG_LIST_EXPAND(PS_UNUSED, TEST_FUZZ, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Peek Tests:");
+#ifdef GENERATED_TYPES_H
+    PS_EXPAND(TEST_PEEK(ros_Odometry, header.stamp, ros_Time))
+    PS_EXPAND(TEST_PEEK(ros_Odometry, header.frame_id, rstring))
+    PS_EXPAND(TEST_PEEK(ros_Odometry, child_frame_id, rstring))
+    PS_EXPAND(TEST_PEEK(ros_Odometry, twist.twist.angular, ros_Vector3))
+#endif
+    PS_EXPAND(TEST_PEEK(ros_DiagnosticStatus, hardware_id, rstring))
+
+    print_header("Message View Tests:");
+#ifdef GENERATED_TYPES_H
+    {
+        uint8_t buffer[TEST_BUFFER_SIZE] = {};
+        size_t len = ps_serialize(buffer, &test_ros_Odometry, TEST_BUFFER_SIZE);
+        ros_Odometry_view odo;
+        ros_Header_view header;
+        ros_PoseWithCovariance_view pose;
+        ros_Time stamp = {};
+        rstring child = NULL;
+        double covariance[36] = {};
+        bool test_passed = ps_view(buffer, len, &odo) && odo.end + 4 == len
+            && ps_view_sub(&odo, header, &header) && ps_view_get(&header, stamp, &stamp)
+            && ps_view_get(&odo, child_frame_id, &child) && ps_view_sub(&odo, pose, &pose)
+            && ps_view_array(&pose, covariance, &covariance)
+            && memcmp(&stamp, &test_ros_Odometry.header.stamp, sizeof(stamp)) == 0
+            && strcmp(child, test_ros_Odometry.child_frame_id) == 0
+            && memcmp(covariance, test_ros_Odometry.pose.covariance, sizeof(covariance)) == 0
+            && !ps_view(buffer, len - 1, &odo);
+        print_test_result("view ros_Odometry", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+#endif
+    {
+        uint8_t buffer[TEST_BUFFER_SIZE] = {};
+        size_t len = ps_serialize(buffer, &test_ros_DiagnosticStatus, TEST_BUFFER_SIZE);
+        ros_DiagnosticStatus_view status;
+        ros_KeyValue_iter iter;
+        ros_KeyValue_view key_value;
+        ros_KeyValue value = {};
+        rstring key = NULL;
+        bool test_passed = ps_view(buffer, len, &status) && ps_view_seq(&status, values, &iter)
+            && iter.n == test_ros_DiagnosticStatus.values.n_elements
+            && ps_iter_view(&iter, &key_value) && ps_view_get(&key_value, key, &key)
+            && strcmp(key, test_ros_DiagnosticStatus.values.data[0].key) == 0
+            && !ps_iter_view(&iter, &key_value)
+            && ps_view_seq(&status, values, &iter) && ps_iter_next(&iter, &value)
+            && strcmp(value.value, test_ros_DiagnosticStatus.values.data[0].value) == 0
+            && !ps_iter_next(&iter, &value);
+        print_test_result("view ros_DiagnosticStatus", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+
+#ifdef TEST_TYPES_H
+    print_header("Bounded Field Tests:");
+    {
+        // Inline storage: bounded size, plain copy is complete message
+        uint8_t buffer[TEST_BUFFER_SIZE] = {};
+        uint8_t buffer2[TEST_BUFFER_SIZE] = {};
+        ros_FieldType copy;
+        ros_FieldType received;
+        memcpy(&copy, &test_ros_FieldType, sizeof(copy));
+        memset(copy.nested_type_name, 'n', sizeof(copy.nested_type_name) - 1);
+        size_t len = ps_serialize(buffer, &copy, TEST_BUFFER_SIZE);
+        memset(&received, 0, sizeof(received));
+        bool test_passed = PS_MAX_SIZE(ros_FieldType) > 0 && len > 0
+            && (size_t)PS_MAX_SIZE(ros_FieldType) >= len
+            && ps_validate(buffer, &received, len) && ps_deserialize(buffer, &received, len)
+            && memcmp(&copy, &received, sizeof(copy)) == 0;
+        memset(buffer2, 0, sizeof(buffer2));
+        test_passed = test_passed && ps_serialize(buffer2, &received, TEST_BUFFER_SIZE) == len
+            && memcmp(buffer, buffer2, len) == 0;
+        print_test_result("inline ros_FieldType", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+
+        // String over its bound is rejected on both sides, length is patched to bound + 2
+        size_t at = ps_seek_ros_FieldType(buffer + 4, len - 4, 0, "nested_type_name");
+        uint32_t n = sizeof(copy.nested_type_name) + 1;
+        memcpy(&buffer[4 + at], &n, sizeof(n));
+        copy.nested_type_name[sizeof(copy.nested_type_name) - 1] = 'n';
+        test_passed = at != PS_VAL_FAIL && !ps_validate(buffer, &received, len + 1)
+            && !ps_deserialize(buffer, &received, len + 1)
+            && ps_serialize(buffer2, &copy, TEST_BUFFER_SIZE) == 0;
+        print_test_result("bounded string limit", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+    {
+        // Sequence over its bound is rejected on both sides
+        uint8_t buffer[TEST_BUFFER_SIZE] = {};
+        uint8_t buffer2[TEST_BUFFER_SIZE] = {};
+        ros_ParameterDescriptor desc = test_ros_ParameterDescriptor;
+        ros_ParameterDescriptor received = {};
+        size_t len = ps_serialize(buffer, &desc, TEST_BUFFER_SIZE);
+        ros_ParameterDescriptor_view view;
+        ros_IntegerRange_iter iter;
+        ros_IntegerRange range = {};
+        bool test_passed = ps_deserialize(buffer, &received, len)
+            && received.integer_range.n_elements == 1
+            && received.integer_range.data[0].step == desc.integer_range.data[0].step
+            && ps_view(buffer, len, &view) && ps_view_seq(&view, integer_range, &iter)
+            && ps_iter_next(&iter, &range) && range.step == desc.integer_range.data[0].step;
+        size_t at = ps_seek_ros_ParameterDescriptor(buffer + 4, len - 4, 0, "integer_range");
+        at = (at + 3) & ~(size_t)3;
+        uint32_t n = 2;
+        memcpy(&buffer[4 + at], &n, sizeof(n));
+        desc.floating_point_range.n_elements = 2;
+        test_passed = test_passed && !ps_validate(buffer, &received, len)
+            && !ps_deserialize(buffer, &received, len) && received.integer_range.n_elements == 0
+            && ps_serialize(buffer2, &desc, TEST_BUFFER_SIZE) == 0;
+        print_test_result("bounded sequence limit", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+#endif
+
+#ifdef PS_REFLECTION
+    print_header("Type Descriptor Tests:");
+    MSG_LIST_EXPAND(PS_UNUSED, TEST_DESC, PS_UNUSED, TEST_DESC_FIELD, TEST_DESC_ARRAY, TEST_DESC_SEQUENCE)
+#endif
+
     if(some_test_failed){
         printf("\n%s%s Some tests failed! %s\n\n",
                BOLD_TEXT, RED_TEXT, RESET_TEXT);
@@ -0,0 +1,207 @@
+/**
+ ******************************************************************************
+ * @file    test_picoserdes_hpp.cpp
+ * @brief   Unit tests for C++ picoserdes front end
+ * @details Every user type is filled with generated values, serialized with
+ *          C ps_serialize() and picoserdes::serialize() and compared byte by byte.
+ ******************************************************************************
+ */
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "../src/picoserdes.hpp"
+
+// Buffer size for serialization tests allocated on stack
+#define TEST_BUFFER_SIZE 4096
+
+// Formatting constants
+#define TEST_INDENT "    "
+#define GREEN_TEXT "\033[0;32m"
+#define RED_TEXT   "\033[0;31m"
+#define RESET_TEXT "\033[0m"
+#define BOLD_TEXT  "\033[1m"
+
+// Helper functions for formatting
+void print_header(const char* title) {
+    printf("%s  %s\n%s", BOLD_TEXT, title, RESET_TEXT);
+}
+
+void print_test_result(const char* type_name, bool passed) {
+    printf("%s%s[%s] Test %s: %s%s\n",
+           TEST_INDENT,
+           passed ? GREEN_TEXT : RED_TEXT,
+           passed ? "✓" : "✗",
+           type_name,
+           passed ? "PASSED" : "FAILED",
+           RESET_TEXT);
+}
+
+// Generated test values, sequences get 0 to 3 elements from static storage
+static unsigned test_seed = 1;
+static const char* test_strings[] = {"a", "", "test string", "ros"};
+
+template<class T>
+static void test_fill(T& v) {
+    if constexpr (std::is_same<T, bool>::value) {
+        v = (test_seed++ & 1) != 0;
+    }
+    else if constexpr (std::is_arithmetic<T>::value) {
+        v = (T)(test_seed++ * 37 % 113 + 1);
+    }
+    else if constexpr (std::is_same<T, rstring>::value) {
+        v = (rstring)test_strings[test_seed++ % 4];
+    }
+    else if constexpr (std::is_same<T, picoserdes::bounded_string<sizeof(T)>>::value) {
+        snprintf(v.data, sizeof(v.data), "%s", test_strings[test_seed++ % 4]);
+    }
+    else if constexpr (std::is_array<T>::value) {
+        for (auto& e : v) { test_fill(e); }
+    }
+    else if constexpr (picoserdes::is_inline_sequence<T>::value) {
+        v.n_elements = test_seed++ % (std::extent<decltype(T::data)>::value + 1);
+        for (uint32_t i = 0; i < v.n_elements; i++) { test_fill(v.data[i]); }
+    }
+    else if constexpr (picoserdes::is_sequence<T>::value) {
+        using E = std::remove_pointer_t<decltype(T::data)>;
+        static E storage[3];
+        v.data = storage;
+        v.n_elements = test_seed++ % 4;
+        for (uint32_t i = 0; i < v.n_elements; i++) { test_fill(storage[i]); }
+    }
+    else {
+        picoserdes::traits<T>::visit(v, [](auto& m) { test_fill(m); });
+    }
+}
+
+/* Test steps:
+ *      1. Serializing generated value with C and C++ serializer, outputs must match
+ *      2. Deserializing C++ output with C++ deserializer into arena
+ *      3. Serializing deserialized value with C serializer, output must match 1.
+ *      4. Serializing into and deserializing from truncated buffer must fail
+ *      5. Zero initialized value with empty sequences must deserialize without arena
+ */
+template<class T>
+static bool test_type() {
+    uint8_t c_buffer[TEST_BUFFER_SIZE] = {};
+    uint8_t cpp_buffer[TEST_BUFFER_SIZE] = {};
+    uint8_t buffer2[TEST_BUFFER_SIZE] = {};
+    uint8_t storage[TEST_BUFFER_SIZE] __attribute__((aligned(8)));
+    ps_arena_t arena = {storage, sizeof(storage), 0};
+    T msg, copy, copy2;
+    memset(&msg, 0, sizeof(T));
+    memset(&copy, 0, sizeof(T));
+    memset(&copy2, 0, sizeof(T));
+    test_fill(msg);
+
+    size_t c_len = ps_serialize(c_buffer, &msg, TEST_BUFFER_SIZE);
+    size_t cpp_len = picoserdes::serialize(cpp_buffer, msg, TEST_BUFFER_SIZE);
+    bool passed = c_len == cpp_len && memcmp(c_buffer, cpp_buffer, c_len) == 0;
+
+    passed = passed && picoserdes::deserialize(cpp_buffer, copy, cpp_len, &arena)
+        && ps_serialize(buffer2, &copy, TEST_BUFFER_SIZE) == c_len
+        && memcmp(c_buffer, buffer2, c_len) == 0;
+
+    passed = passed && picoserdes::serialize(buffer2, msg, c_len - 1) == 0
+        && !picoserdes::deserialize(cpp_buffer, copy2, c_len - 1, &arena);
+
+    memset(&msg, 0, sizeof(T));
+    memset(&copy2, 0, sizeof(T));
+    size_t zero_len = picoserdes::serialize(cpp_buffer, msg, TEST_BUFFER_SIZE);
+    passed = passed && zero_len > 0 && picoserdes::deserialize(cpp_buffer, copy2, zero_len);
+    return passed;
+}
+
+/* Byte order test: C serializer writes generated value in foreign byte order, C++
+ * deserializer output must serialize to the same bytes as host order C output.
+ */
+template<class T>
+static bool test_byte_order(bool (*ser)(ucdrBuffer*, T*)) {
+    uint8_t buffer[TEST_BUFFER_SIZE] = {};
+    uint8_t foreign[TEST_BUFFER_SIZE] = {};
+    uint8_t buffer2[TEST_BUFFER_SIZE] = {};
+    uint8_t storage[TEST_BUFFER_SIZE] __attribute__((aligned(8)));
+    ps_arena_t arena = {storage, sizeof(storage), 0};
+    ucdrEndianness order = (UCDR_MACHINE_ENDIANNESS == UCDR_LITTLE_ENDIANNESS)
+        ? UCDR_BIG_ENDIANNESS : UCDR_LITTLE_ENDIANNESS;
+    ucdrBuffer writer = {};
+    T msg, copy;
+    memset(&msg, 0, sizeof(T));
+    memset(&copy, 0, sizeof(T));
+    test_fill(msg);
+
+    size_t len = ps_serialize(buffer, &msg, TEST_BUFFER_SIZE);
+    foreign[1] = (uint8_t)order;
+    ucdr_init_buffer_origin_offset_endian(&writer, foreign + 4, TEST_BUFFER_SIZE - 4, 0, 0, order);
+    return ser(&writer, &msg)
+        && ucdr_buffer_length(&writer) + 4 == len
+        && picoserdes::deserialize(foreign, copy, len, &arena)
+        && ps_serialize(buffer2, &copy, TEST_BUFFER_SIZE) == len
+        && memcmp(buffer, buffer2, len) == 0;
+}
+
+#define TEST_HPP_BYTE_ORDER(type, ...) \
+    do { \
+        bool test_passed = test_byte_order<type>(ps_ser_##type); \
+        print_test_result("byte order " #type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+
+#define TEST_HPP(type, ...) \
+    do { \
+        bool test_passed = test_type<type>(); \
+        print_test_result(#type, test_passed); \
+        if(!test_passed){ \
+            some_test_failed = true; \
+        } \
+    } while (0);
+#define TEST_HPP_SRV(type, ...) \
+    TEST_HPP(request_##type) \
+    TEST_HPP(reply_##type)
+
+int main() {
+    print_header("PICOSERDES C++ UNIT TESTS");
+    bool some_test_failed = false;
+
+    print_header("Base Types C++ Serializer Tests:");
+    BASE_TYPES_LIST(TEST_HPP)
+
+    print_header("User Types C++ Serializer Tests:");
+    MSG_LIST(PS_UNUSED, TEST_HPP, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Service Types C++ Serializer Tests:");
+    SRV_LIST(TEST_HPP_SRV, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Byte Order C++ Deserializer Tests:");
+    MSG_LIST(PS_UNUSED, TEST_HPP_BYTE_ORDER, PS_UNUSED, PS_UNUSED, PS_UNUSED, PS_UNUSED)
+
+    print_header("Sequence Span Tests:");
+    {
+        ros_DiagnosticStatus status;
+        memset(&status, 0, sizeof(status));
+        test_fill(status);
+        status.values.n_elements = 2;
+        size_t count = 0;
+        for (const ros_KeyValue& kv : picoserdes::as_span(status.values)) {
+            count += (kv.key == status.values.data[count].key);
+        }
+        bool test_passed = count == 2 && picoserdes::as_span(status.values).size() == 2;
+        print_test_result("span ros_DiagnosticStatus.values", test_passed);
+        if(!test_passed){
+            some_test_failed = true;
+        }
+    }
+
+    if(some_test_failed){
+        printf("\n%s%s Some tests failed! %s\n\n",
+               BOLD_TEXT, RED_TEXT, RESET_TEXT);
+        return EXIT_FAILURE;
+    }
+    else{
+        printf("\n%s%s All tests completed successfully! %s\n\n",
+               BOLD_TEXT, GREEN_TEXT, RESET_TEXT);
+        return EXIT_SUCCESS;
+    }
+}
@@ -0,0 +1,86 @@
+/* ROS message type definitions of bounded field tests
+ *
+ * Test builds only, this is not a generated type file. ros_FieldType, ros_ParameterDescriptor
+ * and srv_DescribeParameters carry string and sequence bounds and are written by hand, their
+ * RIHS01 hashes were computed from the ROS type descriptions. Other entries are copied from
+ * examples/example_types.h so the shared tests find the types they reference.
+ */
+#ifndef TEST_TYPES_H
+#define TEST_TYPES_H
+
+#define MSG_LIST(BTYPE, CTYPE, TTYPE, FIELD, ARRAY, SEQUENCE) \
+    CTYPE(ros_Time, \
+        "builtin_interfaces::msg::dds_::Time", \
+        "b106235e25a4c5ed35098aa0a61a3ee9c9b18d197f398b0e4206cea9acf9c197", \
+        FIELD(int32_t, sec) \
+        FIELD(uint32_t, nanosec) \
+    ) \
+    CTYPE(ros_Header, \
+        "std_msgs::msg::dds_::Header", \
+        "f49fb3ae2cf070f793645ff749683ac6b06203e41c891e17701b1cb597ce6a01", \
+        FIELD(ros_Time, stamp) \
+        FIELD(rstring, frame_id) \
+    ) \
+    CTYPE(ros_KeyValue, \
+        "diagnostic_msgs::msg::dds_::KeyValue", \
+        "d68081eaa540288c5440753baecef0c4e16e81a5f78ad68902ded5100413bb42", \
+        FIELD(rstring, key) \
+        FIELD(rstring, value) \
+    ) \
+    CTYPE(ros_DiagnosticStatus, \
+        "diagnostic_msgs::msg::dds_::DiagnosticStatus", \
+        "b0e3e692ea2d54a8af2f4ef1930e81556a2db55216b771f8a7d2724ed47bf0e4", \
+        FIELD(uint8_t, level) \
+        FIELD(rstring, name) \
+        FIELD(rstring, message) \
+        FIELD(rstring, hardware_id) \
+        SEQUENCE(ros_KeyValue, values) \
+    ) \
+    CTYPE(ros_FloatingPointRange, \
+        "rcl_interfaces::msg::dds_::FloatingPointRange", \
+        "e6af23a23c177fee5f3075c8b1e435162a9b63c863d78c06017460b49684262d", \
+        FIELD(double, from_value) \
+        FIELD(double, to_value) \
+        FIELD(double, step) \
+    ) \
+    CTYPE(ros_IntegerRange, \
+        "rcl_interfaces::msg::dds_::IntegerRange", \
+        "f7b7fdc0f65f07702e099218e13288c3963bcb9345bde78b560e6cd19800fc5a", \
+        FIELD(int64_t, from_value) \
+        FIELD(int64_t, to_value) \
+        FIELD(uint64_t, step) \
+    ) \
+    CTYPE(ros_ParameterDescriptor, \
+        "rcl_interfaces::msg::dds_::ParameterDescriptor", \
+        "52175dbfda6c51153101d33d2a9da05743f66f02d5ab2ca9ec4709b46b73d704", \
+        FIELD(rstring, name) \
+        FIELD(uint8_t, type) \
+        FIELD(rstring, description) \
+        FIELD(rstring, additional_constraints) \
+        FIELD(bool, read_only) \
+        FIELD(bool, dynamic_typing) \
+        SEQUENCE(ros_FloatingPointRange, floating_point_range, 1) \
+        SEQUENCE(ros_IntegerRange, integer_range, 1) \
+    ) \
+    CTYPE(ros_FieldType, \
+        "type_description_interfaces::msg::dds_::FieldType", \
+        "a70b6dd919645a03a3586f7f821defbc886ea3e531a1d95cc0f380a3973ccaa6", \
+        FIELD(uint8_t, type_id) \
+        FIELD(uint64_t, capacity) \
+        FIELD(uint64_t, string_capacity) \
+        FIELD(rstring, nested_type_name, 255) \
+    )
+
+#define SRV_LIST(SRV, REQUEST, REPLY, FIELD, ARRAY, SEQUENCE) \
+    SRV(srv_DescribeParameters, \
+        "rcl_interfaces::srv::dds_::DescribeParameters", \
+        "845b484d71eb0673dae682f2e3ba3c4851a65a3dcfb97bddd82c5b57e91e4cff", \
+        REQUEST( \
+            SEQUENCE(rstring, names) \
+        ), \
+        REPLY( \
+            SEQUENCE(ros_ParameterDescriptor, descriptors) \
+        ) \
+    )
+
+#endif /* TEST_TYPES_H */
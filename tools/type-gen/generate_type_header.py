@@ -441,7 +441,7 @@ def parse_type_descriptions(output_dir: str) -> Dict[str, Dict]:
         # 18: 'wstring', # FIELD_TYPE_WSTRING
         # 19: 'fixed_string', # FIELD_TYPE_FIXED_STRING
         # 20: 'fixed_wstring', # FIELD_TYPE_FIXED_WSTRING
-        # 21: 'bounded_string', # FIELD_TYPE_BOUNDED_STRING
+        21: 'bounded_string', # FIELD_TYPE_BOUNDED_STRING
         # 22: 'bounded_wstring', # FIELD_TYPE_BOUNDED_WSTRING
 
         # Fixed size arrays (49-70)
@@ -465,31 +465,31 @@ def parse_type_descriptions(output_dir: str) -> Dict[str, Dict]:
         # 66: 'wstring[]', # FIELD_TYPE_WSTRING_ARRAY
         # 67: 'fixed_string[]', # FIELD_TYPE_FIXED_STRING_ARRAY
         # 68: 'fixed_wstring[]', # FIELD_TYPE_FIXED_WSTRING_ARRAY
-        # 69: 'bounded_string[]', # FIELD_TYPE_BOUNDED_STRING_ARRAY
+        69: 'bounded_string[]', # FIELD_TYPE_BOUNDED_STRING_ARRAY
         # 70: 'bounded_wstring[]', # FIELD_TYPE_BOUNDED_WSTRING_ARRAY
 
         # Bounded sequences (97-118)
-        #97: 'nested_bounded_sequence',  # FIELD_TYPE_NESTED_TYPE_BOUNDED_SEQUENCE
-        # 98: 'int8_bounded_sequence',    # FIELD_TYPE_INT8_BOUNDED_SEQUENCE
-        # 99: 'uint8_bounded_sequence',   # FIELD_TYPE_UINT8_BOUNDED_SEQUENCE
-        # 100: 'int16_bounded_sequence',  # FIELD_TYPE_INT16_BOUNDED_SEQUENCE
-        # 101: 'uint16_bounded_sequence', # FIELD_TYPE_UINT16_BOUNDED_SEQUENCE
-        # 102: 'int32_bounded_sequence',  # FIELD_TYPE_INT32_BOUNDED_SEQUENCE
-        # 103: 'uint32_bounded_sequence', # FIELD_TYPE_UINT32_BOUNDED_SEQUENCE
-        # 104: 'int64_bounded_sequence',  # FIELD_TYPE_INT64_BOUNDED_SEQUENCE
-        # 105: 'uint64_bounded_sequence', # FIELD_TYPE_UINT64_BOUNDED_SEQUENCE
-        # 106: 'float32_bounded_sequence', # FIELD_TYPE_FLOAT_BOUNDED_SEQUENCE
-        # 107: 'float64_bounded_sequence', # FIELD_TYPE_DOUBLE_BOUNDED_SEQUENCE
+        97: 'nested_bounded_sequence',  # FIELD_TYPE_NESTED_TYPE_BOUNDED_SEQUENCE
+        98: 'int8_bounded_sequence',    # FIELD_TYPE_INT8_BOUNDED_SEQUENCE
+        99: 'uint8_bounded_sequence',   # FIELD_TYPE_UINT8_BOUNDED_SEQUENCE
+        100: 'int16_bounded_sequence',  # FIELD_TYPE_INT16_BOUNDED_SEQUENCE
+        101: 'uint16_bounded_sequence', # FIELD_TYPE_UINT16_BOUNDED_SEQUENCE
+        102: 'int32_bounded_sequence',  # FIELD_TYPE_INT32_BOUNDED_SEQUENCE
+        103: 'uint32_bounded_sequence', # FIELD_TYPE_UINT32_BOUNDED_SEQUENCE
+        104: 'int64_bounded_sequence',  # FIELD_TYPE_INT64_BOUNDED_SEQUENCE
+        105: 'uint64_bounded_sequence', # FIELD_TYPE_UINT64_BOUNDED_SEQUENCE
+        106: 'float32_bounded_sequence', # FIELD_TYPE_FLOAT_BOUNDED_SEQUENCE
+        107: 'float64_bounded_sequence', # FIELD_TYPE_DOUBLE_BOUNDED_SEQUENCE
         # 108: 'long_double_bounded_sequence', # FIELD_TYPE_LONG_DOUBLE_BOUNDED_SEQUENCE
-        # 109: 'char_bounded_sequence',   # FIELD_TYPE_CHAR_BOUNDED_SEQUENCE
+        109: 'char_bounded_sequence',   # FIELD_TYPE_CHAR_BOUNDED_SEQUENCE
         # 110: 'wchar_bounded_sequence',  # FIELD_TYPE_WCHAR_BOUNDED_SEQUENCE
-        # 111: 'bool_bounded_sequence',   # FIELD_TYPE_BOOLEAN_BOUNDED_SEQUENCE
-        # 112: 'byte_bounded_sequence',   # FIELD_TYPE_BYTE_BOUNDED_SEQUENCE
-        # 113: 'string_bounded_sequence', # FIELD_TYPE_STRING_BOUNDED_SEQUENCE
+        111: 'bool_bounded_sequence',   # FIELD_TYPE_BOOLEAN_BOUNDED_SEQUENCE
+        112: 'byte_bounded_sequence',   # FIELD_TYPE_BYTE_BOUNDED_SEQUENCE
+        113: 'string_bounded_sequence', # FIELD_TYPE_STRING_BOUNDED_SEQUENCE
         # 114: 'wstring_bounded_sequence', # FIELD_TYPE_WSTRING_BOUNDED_SEQUENCE
         # 115: 'fixed_string_bounded_sequence', # FIELD_TYPE_FIXED_STRING_BOUNDED_SEQUENCE
         # 116: 'fixed_wstring_bounded_sequence', # FIELD_TYPE_FIXED_WSTRING_BOUNDED_SEQUENCE
-        # 117: 'bounded_string_bounded_sequence', # FIELD_TYPE_BOUNDED_STRING_BOUNDED_SEQUENCE
+        117: 'bounded_string_bounded_sequence', # FIELD_TYPE_BOUNDED_STRING_BOUNDED_SEQUENCE
         # 118: 'bounded_wstring_bounded_sequence', # FIELD_TYPE_BOUNDED_WSTRING_BOUNDED_SEQUENCE
 
         # Unbounded sequences (145-166)
@@ -513,7 +513,7 @@ def parse_type_descriptions(output_dir: str) -> Dict[str, Dict]:
         # 162: 'wstring_unbounded_sequence', # FIELD_TYPE_WSTRING_UNBOUNDED_SEQUENCE
         # 163: 'fixed_string_unbounded_sequence', # FIELD_TYPE_FIXED_STRING_UNBOUNDED_SEQUENCE
         # 164: 'fixed_wstring_unbounded_sequence', # FIELD_TYPE_FIXED_WSTRING_UNBOUNDED_SEQUENCE
-        # 165: 'bounded_string_unbounded_sequence', # FIELD_TYPE_BOUNDED_STRING_UNBOUNDED_SEQUENCE
+        165: 'bounded_string_unbounded_sequence', # FIELD_TYPE_BOUNDED_STRING_UNBOUNDED_SEQUENCE
         # 166: 'bounded_wstring_unbounded_sequence', # FIELD_TYPE_BOUNDED_WSTRING_UNBOUNDED_SEQUENCE
     }
 
@@ -585,6 +585,7 @@ def parse_json_fields(fields: List[Dict], type_id_map: Dict[int, str]) -> List[D
         field_type_info = field['type']
         type_id = field_type_info['type_id']
         capacity = field_type_info.get('capacity', 0)
+        string_capacity = field_type_info.get('string_capacity', 0)
         nested_type_name = field_type_info.get('nested_type_name', '')
 
         if type_id == 1 and nested_type_name:
@@ -614,27 +615,49 @@ def parse_json_fields(fields: List[Dict], type_id_map: Dict[int, str]) -> List[D
                 'array_size': None,
                 'is_seq': True
             })
+        elif type_id == 97 and nested_type_name:
+            # Nested type bounded sequence, stored inline
+            parsed_fields.append({
+                'type': nested_type_name,
+                'name': field_name,
+                'is_array': False,
+                'array_size': None,
+                'is_seq': True,
+                'bound': capacity
+            })
         elif type_id in type_id_map:
             type_name = type_id_map[type_id]
 
             if type_name.endswith('[]'):
-                # Fixed-size array
+                # Fixed-size array, bounded string elements are plain strings
                 base_type = type_name[:-2]  # Remove '[]'
                 parsed_fields.append({
-                    'type': base_type,
+                    'type': 'string' if base_type == 'bounded_string' else base_type,
                     'name': field_name,
                     'is_array': True,
                     'is_seq': False,
                     'array_size': capacity
                 })
             elif "sequence" in type_name:
-                base_type = type_name[:-2]  # Remove '[]'
+                # Element type precedes '_bounded_sequence' / '_unbounded_sequence'
+                base_type = type_name.rsplit("_", 2)[0]
                 parsed_fields.append({
-                    'type': type_name.split("_")[0],
+                    'type': 'string' if base_type == 'bounded_string' else base_type,
                     'name': field_name,
                     'is_array': False,
                     'is_seq': True,
-                    'array_size': 0
+                    'array_size': 0,
+                    'bound': capacity if "_bounded_sequence" in type_name else None
+                })
+            elif type_name == 'bounded_string':
+                # Bounded string, stored inline
+                parsed_fields.append({
+                    'type': 'string',
+                    'name': field_name,
+                    'is_array': False,
+                    'array_size': None,
+                    'is_seq': False,
+                    'bound': string_capacity
                 })
             else:
                 # Regular field
@@ -741,7 +764,7 @@ def classify_type(fields: List[Dict]) -> str:
     if not fields:
         return "BTYPE"  # Empty type, treat as basic
 
-    if len(fields) == 1 and not (fields[0]['is_array'] or fields[0]['is_seq']):
+    if len(fields) == 1 and not (fields[0]['is_array'] or fields[0]['is_seq'] or fields[0].get('bound')):
         # Single non-array field - could be BTYPE or TTYPE
         field_type = fields[0]['type']
 
@@ -835,12 +858,13 @@ def generate_fields_string(fields: List[Dict], type_info: Dict[str, Dict]) -> Op
                 return None  # Missing type - can't generate this service
             field_type = primitive_type
 
+        bound = f', {field["bound"]}' if field.get('bound') else ''
         if field['is_array'] and field['array_size'] is not None:
             field_lines.append(f'            ARRAY({field_type}, {field_name}, {field["array_size"]}) \\\n')
         elif field['is_seq']:
-            field_lines.append(f'            SEQUENCE({field_type}, {field_name}) \\\n')
+            field_lines.append(f'            SEQUENCE({field_type}, {field_name}{bound}) \\\n')
         else:
-            field_lines.append(f'            FIELD({field_type}, {field_name}) \\\n')
+            field_lines.append(f'            FIELD({field_type}, {field_name}{bound}) \\\n')
 
     return ''.join(field_lines)
 
@@ -909,6 +933,48 @@ def generate_srv_list(service_groups: Dict[str, Dict], type_info: Dict[str, Dict
     return ""
 
 
+def select_root_types(type_info: Dict[str, Dict], roots: List[str]) -> Dict[str, Dict]:
+    """
+    Select root types and all types they reference, transitively.
+
+    Service roots select their request and response types. Types no root reaches are dropped,
+    so MSG_LIST / SRV_LIST only expand serdes code the project can use.
+
+    :param type_info: Dictionary of all type information
+    :param roots: ROS type names like "std_msgs/msg/String" or "example_interfaces/srv/AddTwoInts"
+    :return: Dictionary of selected type information
+    """
+    selected = set()
+    pending = []
+    for root in roots:
+        if "/srv/" in root:
+            parts = [root + "_Request", root + "_Response"]
+            if not all(part in type_info for part in parts):
+                print(f"Error: Root service {root} not found in type descriptions", file=sys.stderr)
+                sys.exit(1)
+            # Base service type only provides hash, its event message is not followed
+            if root in type_info:
+                selected.add(root)
+            pending.extend(parts)
+        elif root in type_info:
+            pending.append(root)
+        else:
+            print(f"Error: Root type {root} not found in type descriptions", file=sys.stderr)
+            sys.exit(1)
+
+    while pending:
+        type_name = pending.pop()
+        if type_name in selected:
+            continue
+        selected.add(type_name)
+        for field in type_info[type_name]['fields']:
+            if field['type'] in type_info:
+                pending.append(field['type'])
+
+    print(f"Selected {len(selected)} of {len(type_info)} type(s) reachable from {len(roots)} root(s)")
+    return {name: info for name, info in type_info.items() if name in selected}
+
+
 def generate_c_header(type_info: Dict[str, Dict], output_file: str) -> None:
     """
     Generate C header file with type definitions in the required format.
@@ -985,12 +1051,14 @@ def generate_c_header(type_info: Dict[str, Dict], output_file: str) -> None:
                         # Map primitive types
                         field_type = get_c_primitive_type(field_type)
 
+                    # Bounded strings and sequences carry bound, stored inline
+                    bound = f', {field["bound"]}' if field.get('bound') else ''
                     if field['is_array']:
                         entry += f'        ARRAY({field_type}, {field_name}, {field["array_size"]}) \\\n'
                     elif field['is_seq']:
-                        entry += f'        SEQUENCE({field_type}, {field_name}) \\\n'
+                        entry += f'        SEQUENCE({field_type}, {field_name}{bound}) \\\n'
                     else:
-                        entry += f'        FIELD({field_type}, {field_name}) \\\n'
+                        entry += f'        FIELD({field_type}, {field_name}{bound}) \\\n'
 
             entry += '    )'
             entries.append(entry)
@@ -1072,6 +1140,13 @@ def main():
         help='Output header file name'
     )
 
+    parser.add_argument(
+        '--roots',
+        nargs='*',
+        help='ROS types used by project, e.g. std_msgs/msg/String example_interfaces/srv/AddTwoInts. '
+             'Only these and types they reference are generated. All types if not given.'
+    )
+
     args = parser.parse_args()
 
     # Setup environment
@@ -1113,6 +1188,10 @@ def main():
         print("Error: No type information found in generated files", file=sys.stderr)
         sys.exit(1)
 
+    # Drop types not reachable from project roots
+    if args.roots:
+        type_info = select_root_types(type_info, args.roots)
+
     # Determine output header file path
     if os.path.isabs(args.header_file):
         header_path = args.header_file